@@ -189,6 +189,8 @@ namespace AI {
 		Do_not_set_override_when_assigning_form_on_wing,
 		Purge_player_issued_form_on_wing_after_subsequent_order,
 		Cancel_future_waves_of_any_wing_launched_from_an_exited_ship,
+		Disable_ai_goal_time_slicing,
+		Disable_ai_target_time_slicing,
 
 		NUM_VALUES
 	};
@@ -745,6 +745,20 @@ void parse_ai_profiles_tbl(const char *filename)
 
 				set_flag(profile, "$cancel future waves of any wing launched from an exited ship:", AI::Profile_Flags::Cancel_future_waves_of_any_wing_launched_from_an_exited_ship);
 
+				set_flag(profile, "$disable AI goal time slicing:", AI::Profile_Flags::Disable_ai_goal_time_slicing);
+
+				set_flag(profile, "$disable AI target time slicing:", AI::Profile_Flags::Disable_ai_target_time_slicing);
+
+				if (optional_string("$AI time slicing budget:")) {
+					float budget;
+					stuff_float(&budget);
+					if (budget >= 0.0f) {
+						profile->ai_time_slicing_budget = budget;
+					} else {
+						mprintf(("Warning: \"$AI time slicing budget:\" should be >= 0 (read %f). Value will not be used.\n", budget));
+					}
+				}
+
 
 				// end of options ----------------------------------------
 
@@ -852,6 +866,8 @@ void ai_profile_t::reset()
 
 	default_form_on_wing_priority = 99;	// as originally assigned in ai_add_goal_sub_sexp()
 
+	ai_time_slicing_budget = 2.0f;
+
     for (int i = 0; i < NUM_SKILL_LEVELS; ++i) {
         max_incoming_asteroids[i] = 0;
         max_allowed_player_homers[i] = 0;
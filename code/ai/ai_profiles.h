@@ -153,6 +153,9 @@ public:
 
 	int default_form_on_wing_priority;	// the priority used if not specified in the sexp
 
+	// milliseconds per frame the AI scheduler may spend on time sliced goal evaluation and target selection, 0 for no limit
+	float ai_time_slicing_budget;
+
     void reset();
 };
 
@@ -23,6 +23,7 @@
 #include "ai/aigoals.h"
 #include "ai/aiinternal.h"
 #include "ai/ailua.h"
+#include "ai/aischedule.h"
 #include "asteroid/asteroid.h"
 #include "autopilot/autopilot.h"
 #include "cmeasure/cmeasure.h"
@@ -65,6 +66,7 @@
 #include "scripting/api/objs/wing.h"
 #include "scripting/scripting.h"
 #include "scripting/global_hooks.h"
+#include "tracing/Monitor.h"
 #include "ship/afterburner.h"
 #include "ship/awacs.h"
 #include "ship/ship.h"
@@ -72,6 +74,7 @@
 #include "ship/shiphit.h"
 #include "ship/subsysdamage.h"
 #include "utils/Random.h"
+#include "utils/threading.h"
 #include "weapon/beam.h"
 #include "weapon/flak.h"
 #include "weapon/swarm.h"
@@ -1079,6 +1082,8 @@ void ai_level_init()
 
 	// clear out the preferred primaries so that it doesn't persist between missions or between mission reloads
 	Preferred_primary_info.clear();
+
+	ai_schedule_level_init();
 }
 
 // BEGIN STEALTH
@@ -2250,8 +2255,32 @@ typedef struct eval_nearest_objnum {
 	int	nearest_objnum;
 	float	nearest_dist;
 	int	check_danger_weapon_objnum;
+	const int	*attacker_counts;	// if set, the search runs in the think phase and must not modify anything
 } eval_nearest_objnum;
 
+// Same as is_ignore_object(), but leaves stale ignore entries alone instead of resetting them.
+static bool is_ignore_object_readonly(const ai_info *aip, int objnum)
+{
+	auto matches = [objnum](int ignore_objnum, int ignore_signature) {
+		return (ignore_objnum >= 0) && (ignore_objnum == objnum) && (Objects[ignore_objnum].signature == ignore_signature);
+	};
+
+	if (matches(aip->ignore_objnum, aip->ignore_signature))
+		return true;
+
+	for (int i = 0; i < MAX_IGNORE_NEW_OBJECTS; i++) {
+		if (matches(aip->ignore_new_objnums[i], aip->ignore_new_signatures[i]))
+			return true;
+	}
+
+	return false;
+}
+
+// whether another ship may attack an enemy that is already attacked by num_attacking ships
+static bool ai_think_enemy_still_open(int num_attacking, int max_attackers, bool big_or_huge)
+{
+	return big_or_huge || (num_attacking < max_attackers);
+}
 
 void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 {
@@ -2285,8 +2314,12 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 			if (shipp->flags[Ship::Ship_Flags::Dying])
 				return;
 
-			if (is_ignore_object(aip, OBJ_INDEX(eno->trial_objp)))
+			if (eno->attacker_counts != nullptr) {
+				if (is_ignore_object_readonly(aip, OBJ_INDEX(eno->trial_objp)))
+					return;
+			} else if (is_ignore_object(aip, OBJ_INDEX(eno->trial_objp))) {
 				return;
+			}
 
 			if (eno->trial_objp->flags[Object::Object_Flags::Protected])
 				return;
@@ -2335,13 +2368,18 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 					dist = dist * 0.5f;
 				}
 
-				num_attacking = num_enemies_attacking(OBJ_INDEX(eno->trial_objp));
-                
-                if (!sip->is_big_or_huge() && num_attacking < eno->max_attackers) {
+				if (eno->attacker_counts != nullptr)
+					num_attacking = eno->attacker_counts[OBJ_INDEX(eno->trial_objp)];
+				else
+					num_attacking = num_enemies_attacking(OBJ_INDEX(eno->trial_objp));
+
+				bool still_open = ai_think_enemy_still_open(num_attacking, eno->max_attackers, sip->is_big_or_huge());
+
+                if (!sip->is_big_or_huge() && still_open) {
                     dist *= (float)(num_attacking + 2) / 2.0f;				//	prevents lots of ships from attacking same target
                 }
 				
-                if ((sip->is_big_or_huge()) || (num_attacking < eno->max_attackers)) {	
+                if (still_open) {	
 
 					if (eno->trial_objp->flags[Object::Object_Flags::Player_ship]){
 						dist *= 1.0f + (NUM_SKILL_LEVELS - Game_skill_level - 1)/NUM_SKILL_LEVELS;	//	Favor attacking non-players based on skill level.
@@ -2358,6 +2396,8 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 
 }
 
+static int get_nearest_objnum_sub(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, int class_type, const int *attacker_counts);
+static bool ai_think_take_nearest_enemy(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, int class_type, int *nearest_objnum);
 
 /**
  * Given an object and an enemy team, return the index of the nearest enemy object.
@@ -2372,6 +2412,15 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
  * @param class_type		If >=0, the enemy object must be of the specified ship type
  */
 int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, int class_type)
+{
+	return get_nearest_objnum_sub(objnum, enemy_team_mask, enemy_wing, range, max_attackers, ship_info_index, class_type, nullptr);
+}
+
+/**
+ * The search behind get_nearest_objnum().  If attacker_counts is given, it is used instead of num_enemies_attacking()
+ * and nothing is modified, so that the think phase can run it for several ships at once.
+ */
+static int get_nearest_objnum_sub(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, int class_type, const int *attacker_counts)
 {
 	object	*danger_weapon_objp;
 	ai_info	*aip;
@@ -2389,6 +2438,7 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	eno.nearest_dist = range;
 	eno.nearest_objnum = -1;
 	eno.check_danger_weapon_objnum = 0;
+	eno.attacker_counts = attacker_counts;
 
 	// go through the list of all ships and evaluate as potential targets
 	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
@@ -2427,7 +2477,7 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	//	If only looking for target in certain wing and couldn't find anything in
 	//	that wing, look for any object.
 	if ((eno.nearest_objnum == -1) && (enemy_wing != -1)) {
-		return get_nearest_objnum(objnum, enemy_team_mask, -1, range, max_attackers, ship_info_index, class_type);
+		return get_nearest_objnum_sub(objnum, enemy_team_mask, -1, range, max_attackers, ship_info_index, class_type, attacker_counts);
 	}
 
 	return eno.nearest_objnum;
@@ -2575,6 +2625,11 @@ int find_enemy(int objnum, float range, int max_attackers, int ship_info_index,
 			}
 		}
 
+		// the think phase may already have searched for this ship at the start of the frame
+		int nearest_objnum;
+		if (ai_think_take_nearest_enemy(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, ship_info_index, class_type, &nearest_objnum))
+			return nearest_objnum;
+
 		return get_nearest_objnum(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, ship_info_index, class_type);
 	} else {
 		aip->target_objnum = -1;
@@ -2583,6 +2638,180 @@ int find_enemy(int objnum, float range, int max_attackers, int ship_info_index,
 	}
 }
 
+// BEGIN THINK PHASE
+// -----------------------------------------------------------------------------
+//
+// Searching for a new enemy is by far the most expensive part of the AI, and it only reads the world.  So at the start
+// of each frame the searches ai_frame() is about to do are run for all ships at once on the worker threads, against a
+// snapshot of how many ships attack each object.  Nothing is modified while they run.  find_enemy() picks up the
+// results during the normal serial AI frame, and searches on its own if a result is missing or has gone stale.
+
+typedef struct ai_think_intent {
+	int	frame = -1;
+	int	objnum = -1;
+	int	signature = -1;
+	int	enemy_team_mask = 0;
+	int	enemy_wing = -1;
+	float	range = 0.0f;
+	int	max_attackers = 0;
+	int	nearest_objnum = -1;
+} ai_think_intent;
+
+static ai_think_intent Ai_think_intents[MAX_AI_INFO];
+static int Ai_think_attackers[MAX_OBJECTS];		// num_enemies_attacking() of every object at the start of the frame
+static SCP_vector<int> Ai_think_candidates;
+static int Ai_think_frame = 0;
+static int Ai_think_num_used = 0;
+
+MONITOR(AIThinkSearches)
+MONITOR(AIThinkResultsUsed)
+
+/**
+ * Whether ai_frame() is likely to search for an enemy for this ship this frame.  Guessing wrong only costs time.
+ */
+static bool ai_think_may_search(const object *objp)
+{
+	auto shipp = &Ships[objp->instance];
+
+	if (shipp->ai_index < 0)
+		return false;
+
+	if ((objp->flags[Object::Object_Flags::Player_ship]) && !Player_use_ai)
+		return false;
+
+	if (shipp->flags[Ship::Ship_Flags::Dying] || shipp->is_arriving())
+		return false;
+
+	auto sip = &Ship_info[shipp->ship_info_index];
+	if ((sip->class_type < 0) || !(Ship_types[sip->class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks]))
+		return false;
+
+	auto aip = &Ai_info[shipp->ai_index];
+	if ((aip->mode == AIM_PLAY_DEAD) || (aip->mode == AIM_WARP_OUT) || (aip->resume_goal_time != -1))
+		return false;
+
+	// find_enemy() won't search before this
+	if (!timestamp_elapsed(aip->choose_enemy_timestamp))
+		return false;
+
+	// a ship with a live target keeps it
+	if ((aip->target_objnum >= 0) && (Objects[aip->target_objnum].signature == aip->target_signature))
+		return false;
+
+	return ai_schedule_is_due(objp, ai_schedule_task::Target);
+}
+
+void ai_think_frame()
+{
+	Ai_think_frame++;
+	Ai_think_candidates.clear();
+
+	mon_AIThinkResultsUsed = Ai_think_num_used;
+	Ai_think_num_used = 0;
+
+	if (physics_paused || ai_paused)
+		return;
+
+	for (auto so : list_range(&Ship_obj_list)) {
+		auto objp = &Objects[so->objnum];
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		if (ai_think_may_search(objp))
+			Ai_think_candidates.push_back(so->objnum);
+	}
+
+	mon_AIThinkSearches = sz2i(Ai_think_candidates.size());
+
+	if (Ai_think_candidates.empty())
+		return;
+
+	// the same counting as num_enemies_attacking(), done once for all objects
+	memset(Ai_think_attackers, 0, sizeof(Ai_think_attackers));
+	for (auto so : list_range(&Ship_obj_list)) {
+		auto objp = &Objects[so->objnum];
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		auto sp = &Ships[objp->instance];
+
+		int target_objnum = Ai_info[sp->ai_index].target_objnum;
+		if (target_objnum >= 0)
+			Ai_think_attackers[target_objnum]++;
+
+		if (Ship_info[sp->ship_info_index].is_big_ship()) {
+			for (auto ssp : ship_subsys_range(sp)) {
+				if ((ssp->system_info->type == SUBSYSTEM_TURRET) && (ssp->turret_enemy_objnum >= 0) && (ssp->current_hits > 0))
+					Ai_think_attackers[ssp->turret_enemy_objnum]++;
+			}
+		}
+	}
+
+	int frame = Ai_think_frame;
+	int max_attackers = The_mission.ai_profile->max_attackers[Game_skill_level];
+
+	threading::parallel_for(Ai_think_candidates.size(), 4, [frame, max_attackers](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			int objnum = Ai_think_candidates[i];
+			auto objp = &Objects[objnum];
+			auto aip = &Ai_info[Ships[objp->instance].ai_index];
+			auto intent = &Ai_think_intents[Ships[objp->instance].ai_index];
+
+			// the same search find_enemy() does for ai_frame()
+			intent->objnum = objnum;
+			intent->signature = objp->signature;
+			intent->enemy_team_mask = iff_get_attackee_mask(obj_team(objp));
+			intent->enemy_wing = aip->enemy_wing;
+			intent->range = MAX_ENEMY_DISTANCE;
+			intent->max_attackers = max_attackers;
+			intent->nearest_objnum = get_nearest_objnum_sub(objnum, intent->enemy_team_mask, intent->enemy_wing, intent->range, intent->max_attackers, -1, -1, Ai_think_attackers);
+			intent->frame = frame;
+		}
+	});
+}
+
+/**
+ * Hand out the result of the think phase for this search, if there is one and it is still good.  Each result is only
+ * used once.
+ */
+static bool ai_think_take_nearest_enemy(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, int class_type, int *nearest_objnum)
+{
+	auto objp = &Objects[objnum];
+	if ((objp->type != OBJ_SHIP) || (Ships[objp->instance].ai_index < 0))
+		return false;
+
+	auto intent = &Ai_think_intents[Ships[objp->instance].ai_index];
+
+	if ((intent->frame != Ai_think_frame) || (intent->objnum != objnum) || (intent->signature != objp->signature))
+		return false;
+
+	if ((ship_info_index >= 0) || (class_type >= 0) || (intent->enemy_team_mask != enemy_team_mask) || (intent->enemy_wing != enemy_wing)
+		|| (intent->range != range) || (intent->max_attackers != max_attackers))
+		return false;
+
+	intent->frame = -1;
+
+	// the enemy may have died or become protected since the start of the frame
+	if (intent->nearest_objnum >= 0) {
+		auto enemy_objp = &Objects[intent->nearest_objnum];
+		if ((enemy_objp->type != OBJ_SHIP) || enemy_objp->flags[Object::Object_Flags::Should_be_dead] || enemy_objp->flags[Object::Object_Flags::Protected]
+			|| Ships[enemy_objp->instance].flags[Ship::Ship_Flags::Dying])
+			return false;
+
+		// the attacker counts are from the start of the frame, so ships that took a result earlier this frame aren't in
+		// them.  Check again so that they don't all pile onto the same enemy.
+		bool big_or_huge = Ship_info[Ships[enemy_objp->instance].ship_info_index].is_big_or_huge();
+		if (!ai_think_enemy_still_open(num_enemies_attacking(intent->nearest_objnum), max_attackers, big_or_huge))
+			return false;
+	}
+
+	Ai_think_num_used++;
+	*nearest_objnum = intent->nearest_objnum;
+	return true;
+}
+
+// END THINK PHASE
+
 /**
  * If issued an order to a ship that's awaiting repair, abort that process.
  * However, do not abort process for an object that is currently being repaired -- let it finish.
@@ -12178,7 +12407,6 @@ void ai_debug_render_stuff()
 //	Deal with engines disabled.
 void ai_process_subobjects(int objnum)
 {
-	ship_subsys	*pss;
 	object	*objp = &Objects[objnum];
 	ship		*shipp = &Ships[objp->instance];
 	ai_info	*aip = &Ai_info[shipp->ai_index];
@@ -12195,7 +12423,7 @@ void ai_process_subobjects(int objnum)
 	polymodel_instance *pmi = model_get_instance(shipp->model_instance_num);
 	polymodel *pm = model_get(pmi->model_num);
 
-	for ( pss = GET_FIRST(&shipp->subsys_list); pss !=END_OF_LIST(&shipp->subsys_list); pss = GET_NEXT(pss) ) {
+	for (auto pss : ship_subsys_range(shipp)) {
 		auto psub = pss->system_info;
 
 		// Don't process destroyed objects (but allow subobjects with hitpoints disabled -nuke)
@@ -15256,7 +15484,12 @@ void ai_frame(int objnum)
 	}
 
 	ai_maybe_self_destruct(Pl_objp, aip);
-	ai_process_mission_orders( objnum, aip );
+
+	// distant ships don't need to re-evaluate their orders every frame
+	if (ai_schedule_begin(Pl_objp, ai_schedule_task::Goals)) {
+		ai_process_mission_orders( objnum, aip );
+		ai_schedule_end(Pl_objp, ai_schedule_task::Goals);
+	}
 
 	//	Avoid a shockwave, if necessary.  If a shockwave and rearming, stop rearming.
 	if (aip->mode != AIM_PLAY_DEAD && aip->ai_flags[AI::AI_Flags::Avoid_shockwave_ship, AI::AI_Flags::Avoid_shockwave_weapon]) {
@@ -15313,8 +15546,10 @@ void ai_frame(int objnum)
 			aip->active_goal = AI_ACTIVE_GOAL_NONE;
 		} else if (aip->resume_goal_time == -1) {
 			// AL 12-9-97: Don't allow cargo and navbuoys to set their aip->target_objnum
-			if ( Ship_info[shipp->ship_info_index].class_type > -1 && (Ship_types[Ship_info[shipp->ship_info_index].class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks]) ) {
+			if ( Ship_info[shipp->ship_info_index].class_type > -1 && (Ship_types[Ship_info[shipp->ship_info_index].class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks])
+				&& ai_schedule_begin(Pl_objp, ai_schedule_task::Target) ) {
 				target_objnum = find_enemy(objnum, MAX_ENEMY_DISTANCE, The_mission.ai_profile->max_attackers[Game_skill_level]);		//	Attack up to 2.5K units away.
+				ai_schedule_end(Pl_objp, ai_schedule_task::Target);
 				if (target_objnum != -1) {
 					if (aip->target_objnum != target_objnum)
 						aip->aspect_locked_time = 0.0f;
@@ -0,0 +1,219 @@
+#include "ai/aischedule.h"
+
+#include "ai/ai.h"
+#include "ai/ai_profiles.h"
+#include "globalincs/systemvars.h"
+#include "io/timer.h"
+#include "mission/missionparse.h"
+#include "network/multi.h"
+#include "object/object.h"
+#include "playerman/player.h"
+#include "render/3d.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+
+// ----------------------------------------------------------------------------------------------
+// AI SCHEDULER DEFINES/VARS
+//
+
+// ships closer than this to a player ship or the camera get full attention
+constexpr float AI_SCHEDULE_NEAR_DIST = 2000.0f;
+// ships closer than this are at least in the reduced tier
+constexpr float AI_SCHEDULE_FAR_DIST = 6000.0f;
+// how long after being hit a ship still counts as being in combat
+constexpr fix AI_SCHEDULE_COMBAT_TIME = F1_0 * 5;
+
+// how often each task runs in each tier, in milliseconds
+static const int Ai_schedule_interval[static_cast<int>(ai_schedule_tier::NUM_TIERS)][static_cast<int>(ai_schedule_task::NUM_TASKS)] = {
+	{ 0, 0 },			// Full
+	{ 250, 250 },		// Reduced
+	{ 1000, 1000 },		// Minimal
+};
+
+typedef struct ai_schedule_info {
+	int objnum = -1;
+	int signature = -1;
+
+	int tier_frame = -1;
+	ai_schedule_tier tier = ai_schedule_tier::Full;
+
+	TIMESTAMP last_run[static_cast<int>(ai_schedule_task::NUM_TASKS)];
+} ai_schedule_info;
+
+static ai_schedule_info Ai_schedule[MAX_AI_INFO];
+
+// the positions ships are measured against this frame
+static SCP_vector<vec3d> Ai_schedule_viewpoints;
+
+static int Ai_schedule_frame = -1;
+static std::uint64_t Ai_schedule_used_us = 0;
+static std::uint64_t Ai_schedule_task_start_us = 0;
+static int Ai_schedule_num_deferred = 0;
+
+MONITOR(AIScheduleDeferred)
+MONITOR(AIScheduleMicroseconds)
+
+// ----------------------------------------------------------------------------------------------
+// AI SCHEDULER FUNCTIONS
+//
+
+void ai_schedule_level_init()
+{
+	for (auto &info : Ai_schedule) {
+		info = ai_schedule_info();
+	}
+
+	Ai_schedule_viewpoints.clear();
+	Ai_schedule_frame = -1;
+	Ai_schedule_used_us = 0;
+	Ai_schedule_num_deferred = 0;
+}
+
+static void ai_schedule_add_viewpoint(int objnum)
+{
+	if (objnum >= 0 && Objects[objnum].type != OBJ_NONE) {
+		Ai_schedule_viewpoints.push_back(Objects[objnum].pos);
+	}
+}
+
+// starts a new frame the first time the scheduler is used in it
+static void ai_schedule_maybe_start_frame()
+{
+	if (Ai_schedule_frame == Framecount) {
+		return;
+	}
+
+	mon_AIScheduleDeferred = Ai_schedule_num_deferred;
+	mon_AIScheduleMicroseconds = static_cast<int>(Ai_schedule_used_us);
+
+	Ai_schedule_frame = Framecount;
+	Ai_schedule_used_us = 0;
+	Ai_schedule_num_deferred = 0;
+
+	Ai_schedule_viewpoints.clear();
+
+	if (Game_mode & GM_MULTIPLAYER) {
+		for (int idx = 0; idx < MAX_PLAYERS; idx++) {
+			if (MULTI_CONNECTED(Net_players[idx]) && !MULTI_STANDALONE(Net_players[idx])) {
+				ai_schedule_add_viewpoint(Net_players[idx].m_player->objnum);
+			}
+		}
+	} else if (Player_obj != nullptr) {
+		ai_schedule_add_viewpoint(OBJ_INDEX(Player_obj));
+	}
+
+	// the camera may be somewhere else entirely during cutscenes
+	if (!(Game_mode & GM_STANDALONE_SERVER)) {
+		Ai_schedule_viewpoints.push_back(Eye_position);
+	}
+}
+
+static ai_schedule_info *ai_schedule_get_info(const object *objp)
+{
+	Assertion(objp->type == OBJ_SHIP, "Only ships are scheduled by the AI scheduler!");
+
+	auto aip = &Ai_info[Ships[objp->instance].ai_index];
+	auto info = &Ai_schedule[Ships[objp->instance].ai_index];
+
+	// a new ship got this ai_info, so forget everything about the old one
+	if ((info->objnum != OBJ_INDEX(objp)) || (info->signature != objp->signature)) {
+		*info = ai_schedule_info();
+		info->objnum = OBJ_INDEX(objp);
+		info->signature = objp->signature;
+	}
+
+	if (info->tier_frame != Framecount) {
+		info->tier_frame = Framecount;
+
+		float dist_squared = std::numeric_limits<float>::max();
+		for (const auto &pos : Ai_schedule_viewpoints) {
+			dist_squared = MIN(dist_squared, vm_vec_dist_squared(&pos, &objp->pos));
+		}
+
+		bool important = objp->flags[Object::Object_Flags::Player_ship]
+			|| Ships[objp->instance].flags[Ship::Ship_Flags::Escort]
+			|| ((Player_ai != nullptr) && (Player_ai->target_objnum == OBJ_INDEX(objp)));
+		bool in_combat = (aip->target_objnum >= 0) || (Missiontime - aip->last_hit_time < AI_SCHEDULE_COMBAT_TIME);
+
+		if (important || (dist_squared < AI_SCHEDULE_NEAR_DIST * AI_SCHEDULE_NEAR_DIST)) {
+			info->tier = ai_schedule_tier::Full;
+		} else if (in_combat || (dist_squared < AI_SCHEDULE_FAR_DIST * AI_SCHEDULE_FAR_DIST)) {
+			info->tier = ai_schedule_tier::Reduced;
+		} else {
+			info->tier = ai_schedule_tier::Minimal;
+		}
+	}
+
+	return info;
+}
+
+ai_schedule_tier ai_schedule_get_tier(const object *objp)
+{
+	ai_schedule_maybe_start_frame();
+
+	return ai_schedule_get_info(objp)->tier;
+}
+
+static bool ai_schedule_task_enabled(ai_schedule_task task)
+{
+	switch (task) {
+	case ai_schedule_task::Goals:
+		return !The_mission.ai_profile->flags[AI::Profile_Flags::Disable_ai_goal_time_slicing];
+	case ai_schedule_task::Target:
+		return !The_mission.ai_profile->flags[AI::Profile_Flags::Disable_ai_target_time_slicing];
+	default:
+		UNREACHABLE("Unhandled AI schedule task %d", static_cast<int>(task));
+		return false;
+	}
+}
+
+bool ai_schedule_is_due(const object *objp, ai_schedule_task task)
+{
+	ai_schedule_maybe_start_frame();
+
+	if (!ai_schedule_task_enabled(task)) {
+		return true;
+	}
+
+	auto info = ai_schedule_get_info(objp);
+	auto &last_run = info->last_run[static_cast<int>(task)];
+	int interval = Ai_schedule_interval[static_cast<int>(info->tier)][static_cast<int>(task)];
+
+	return (interval <= 0) || !last_run.isValid() || (timestamp_since(last_run) >= interval);
+}
+
+bool ai_schedule_begin(const object *objp, ai_schedule_task task)
+{
+	ai_schedule_maybe_start_frame();
+
+	if (ai_schedule_task_enabled(task)) {
+		auto info = ai_schedule_get_info(objp);
+		auto &last_run = info->last_run[static_cast<int>(task)];
+		int interval = Ai_schedule_interval[static_cast<int>(info->tier)][static_cast<int>(task)];
+
+		if (interval > 0 && last_run.isValid()) {
+			int since = timestamp_since(last_run);
+
+			if (since < interval) {
+				return false;
+			}
+
+			// over budget, so wait unless this ship has already been waiting for a whole extra interval
+			float budget_ms = The_mission.ai_profile->ai_time_slicing_budget;
+			if ((budget_ms > 0.0f) && (Ai_schedule_used_us > static_cast<std::uint64_t>(budget_ms * 1000.0f)) && (since < 2 * interval)) {
+				++Ai_schedule_num_deferred;
+				return false;
+			}
+		}
+
+		last_run = _timestamp();
+	}
+
+	Ai_schedule_task_start_us = timer_get_microseconds();
+	return true;
+}
+
+void ai_schedule_end(const object * /*objp*/, ai_schedule_task /*task*/)
+{
+	Ai_schedule_used_us += timer_get_microseconds() - Ai_schedule_task_start_us;
+}
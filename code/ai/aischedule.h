@@ -0,0 +1,51 @@
+#ifndef _AI_SCHEDULE_HEADER_FILE
+#define _AI_SCHEDULE_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// ----------------------------------------------------------------------------------------------
+// AI SCHEDULER
+//
+// ai_frame() steers every AI ship every frame, but re-evaluating mission orders and searching for a new enemy only has
+// to happen that often for the ships the player can actually see fight.  Every ship is put into a tier depending on
+// how close it is to a player ship or the camera, whether it is in combat, and whether it is important to the mission
+// (the player's target and ships on the escort list).  Lower tiers run these tasks at reduced rates.  Once the tasks
+// run in a frame have used up the budget from the AI profile, lower tier ships that are due have to wait for a later
+// frame, but never for more than one extra interval.  Steering, firing and everything else still runs every frame.
+//
+// Either task can be excluded in ai_profiles.tbl with "$disable AI goal time slicing:" and
+// "$disable AI target time slicing:".
+//
+
+class object;
+
+enum class ai_schedule_tier {
+	Full,			// everything runs every frame
+	Reduced,		// in combat or within sensor range of a player
+	Minimal,		// far away and idle
+
+	NUM_TIERS
+};
+
+enum class ai_schedule_task {
+	Goals,			// ai_process_mission_orders()
+	Target,			// find_enemy() when a ship needs a new target
+
+	NUM_TASKS
+};
+
+// call when initializing a level
+void ai_schedule_level_init();
+
+// the tier the ship is in this frame
+ai_schedule_tier ai_schedule_get_tier(const object *objp);
+
+// whether the task should run for the ship this frame.  If it returns true, call ai_schedule_end() once the task is
+// done so its time is counted against the budget
+bool ai_schedule_begin(const object *objp, ai_schedule_task task);
+void ai_schedule_end(const object *objp, ai_schedule_task task);
+
+// whether the task is due for the ship, without starting it; the budget may still hold it back
+bool ai_schedule_is_due(const object *objp, ai_schedule_task task);
+
+#endif
@@ -30,6 +30,7 @@
 #include "pngutils/pngutils.h"
 #include "ship/ship.h"
 #include "tgautils/tgautils.h"
+#include "tracing/LoadProfiler.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
@@ -2635,6 +2636,7 @@ void bm_page_in_start() {
 
 void bm_page_in_stop() {
 	TRACE_SCOPE(tracing::PageInStop);
+	LOAD_PROFILE_PHASE(TexturePageIn, 0);
 
 #ifndef NDEBUG
 	char busy_text[60];
@@ -2692,6 +2694,7 @@ void bm_page_in_stop() {
 	}
 
 	nprintf(("BmpInfo", "BMPMAN: Loaded %d bitmaps that are marked as used for this level.\n", n));
+	tracing::load_profile::add_count(tracing::load_profile::Phase::TexturePageIn, n);
 
 #ifndef NDEBUG
 	int total_bitmaps = 0;
@@ -229,6 +229,9 @@ int cfilelength(CFILE *fp);
 // Reads data
 int cfread(void *buf, int elsize, int nelem, CFILE *fp);
 
+// Total number of bytes read through cfread() so far, from all threads
+std::uint64_t cf_get_bytes_read();
+
 // cfwrite() writes to the file
 int cfwrite(const void *buf, int elsize, int nelem, CFILE *cfile);
 
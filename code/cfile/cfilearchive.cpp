@@ -27,6 +27,7 @@
 #include "cfile/cfilecompression.h"
 #include "luaconf.h"
 
+#include <atomic>
 #include <sstream>
 #include <limits>
 
@@ -193,6 +194,14 @@ int cfseek( CFILE *cfile, int offset, int where )
 }
 
 
+// counts everything read by cfread(), which may be called from worker threads
+static std::atomic<std::uint64_t> Cfile_bytes_read(0);
+
+std::uint64_t cf_get_bytes_read()
+{
+	return Cfile_bytes_read.load(std::memory_order_relaxed);
+}
+
 // cfread() reads from a file
 //
 // returns:   returns the number of full elements read
@@ -243,6 +252,7 @@ int cfread(void *buf, int elsize, int nelem, CFILE *cfile)
 	}
 
 	if ( bytes_read > 0 )	{
+		Cfile_bytes_read.fetch_add(bytes_read, std::memory_order_relaxed);
 		cfile->raw_position += bytes_read;
 		Assertion(cfile->raw_position <= cfile->size, "Invalid raw_position value detected!");
 	}		
@@ -176,6 +176,7 @@ Flag exe_params[] =
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-no_vsync",			"Disable vertical sync",					true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_vsync", },
+	{ "-fixed_timestep",	"Simulate at a fixed rate (Hz)",			true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-fixed_timestep", },
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-fps",				"Show frames per second on HUD",			false,	0,									EASY_DEFAULT,					"HUD",			"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-fps", },
@@ -215,6 +216,8 @@ Flag exe_params[] =
 	{ "-mpnoreturn",		"Disable flight deck option",				true,	0,									EASY_DEFAULT,					"Multiplayer",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-mpnoreturn", },
 	{ "-gateway_ip",		"Set gateway IP address",					false,	0,									EASY_DEFAULT,					"Multiplayer",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-gateway_ip", },
 	{ "-ingame_join",		"Disable in-game joining",					true,	0,									EASY_DEFAULT,					"Multiplayer",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-ingame_join", },
+	{ "-soak_report",		"Write server load statistics to file",		true,	0,									EASY_DEFAULT,					"Multiplayer",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-soak_report", },
+	{ "-standalone_shards",	"Host several games in one standalone",		true,	0,								EASY_DEFAULT,					"Multiplayer",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-standalone_shards", },
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-no_set_gamma",		"Disable setting of gamma",					true,	0,									EASY_DEFAULT,					"Troubleshoot",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_set_gamma", },
@@ -233,6 +236,8 @@ Flag exe_params[] =
 	{ "-set_cpu_affinity",	"Sets processor affinity to config value",	true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-set_cpu_affinity", },
 	{ "-nograb",			"Disables mouse grabbing",					true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nograb", },
 	{ "-noshadercache",		"Disables the shader cache",				true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-noshadercache", },
+	{ "-no_sound_cache",	"Disables the decoded sound cache",			true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_sound_cache", },
+	{ "-no_voice_streaming",	"Loads message voices fully",			true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_voice_streaming", },
 	{ "-prefer_ipv4",		"Prefer IPv4 DNS lookups",					true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-prefer_ipv4", },
 	{ "-prefer_ipv6",		"Prefer IPv6 DNS lookups",					true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-prefer_ipv6", },
 	{ "-log_multi_packet",	"Log multi packet types ",					true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-log_multi_packet",},
@@ -271,12 +276,14 @@ Flag exe_params[] =
 	{ "-profile_frame_time","Profile frame time",						true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_frame_time", },
 	{ "-profile_write_file", "Write profiling information to file",		true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_write_file", },
 	{ "-json_profiling",	"Generate JSON profiling output",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-json_profiling", },
+	{ "-profile_load",		"Write mission load reports to file",		true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_load", },
 	{ "-debug_window",		"Enable the debug window",					true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-debug_window", },
 	{ "-gr_debug",		"Output graphics debug information",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-gr_debug", },
 	{ "-stdout_log",		"Output log file to stdout",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-stdout_log", },
 	{ "-slow_frames_ok",	"Don't adjust timestamps for slow frames",	true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-slow_frames_ok", },
 	{ "-imgui_debug",		"Show imgui debug/demo window in the lab",  true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-imgui_debug", },
 	{ "-luadev",			"Make lua errors non-fatal",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-luadev", },
+	{ "-lua_frame_budget",	"Lua hook time budget per frame (ms)",	true,	0,		EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-lua_frame_budget", },
 	{"-vulkan",			"Use vulkan render backend",				true,	0,									  EASY_DEFAULT,				"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-vulkan", },
 };
 // clang-format on
@@ -380,9 +387,11 @@ int Cmdline_msaa_enabled = 0;
 // Game Speed related
 cmdline_parm no_fpscap("-no_fps_capping", "Don't limit frames-per-second", AT_NONE);	// Cmdline_NoFPSCap
 cmdline_parm no_vsync_arg("-no_vsync", NULL, AT_NONE);		// Cmdline_no_vsync
+cmdline_parm fixed_timestep_arg("-fixed_timestep", "Simulation steps per second, independent of the framerate", AT_INT);	// Cmdline_fixed_timestep
 
 int Cmdline_NoFPSCap = 0; // Disable FPS capping - kazan
 bool Cmdline_no_vsync = false;
+int Cmdline_fixed_timestep = 0;
 
 // HUD related
 cmdline_parm ballistic_gauge("-ballistic_gauge", NULL, AT_NONE);	// Cmdline_ballistic_gauge
@@ -412,8 +421,10 @@ bool Cmdline_enable_vr = false;
 
 // Audio related
 cmdline_parm voice_recognition_arg("-voicer", NULL, AT_NONE);	// Cmdline_voice_recognition
+cmdline_parm loopback_sound_arg("-loopback_sound", "Mix sound into memory instead of playing it, for tests", AT_NONE);	// Cmdline_loopback_sound
 
 int Cmdline_voice_recognition = 0;
+bool Cmdline_loopback_sound = false;
 int Cmdline_no_enhanced_sound = 0;
 
 // MOD related
@@ -425,16 +436,24 @@ char *Cmdline_campaign = nullptr; // for campaign argument
 
 // Multiplayer/Network related
 cmdline_parm almission_arg("-almission", "Autoload multiplayer mission", AT_STRING);		// Cmdline_almission  -- DTP for autoload Multi mission
+cmdline_parm almission_players_arg("-almission_players", "Players to wait for before autoloading the mission", AT_INT);	// Cmdline_almission_players
 cmdline_parm ingamejoin_arg("-ingame_join", NULL, AT_NONE);	// Cmdline_ingamejoin
 cmdline_parm mpnoreturn_arg("-mpnoreturn", NULL, AT_NONE);	// Cmdline_mpnoreturn  -- Removes 'Return to Flight Deck' in respawn dialog -C
 cmdline_parm objupd_arg("-cap_object_update", "Multiplayer object update cap (0-3)", AT_INT);
 cmdline_parm gateway_ip_arg("-gateway_ip", "Set gateway IP address", AT_STRING);
+cmdline_parm soak_report_arg("-soak_report", "Write server load statistics to soak_report.csv", AT_NONE);	// Cmdline_soak_report
+cmdline_parm soak_client_arg("-soak_client", "Soak test client, creates the -pilot pilot if it does not exist", AT_NONE);	// Cmdline_soak_client
+cmdline_parm standalone_shards_arg("-standalone_shards", "Max games hosted by one standalone process, each in a forked worker", AT_INT);	// Cmdline_standalone_shards
 
 char *Cmdline_almission = nullptr;	//DTP for autoload multi mission.
+int Cmdline_almission_players = 0;
 int Cmdline_ingamejoin = 1;
 int Cmdline_mpnoreturn = 0;
 int Cmdline_objupd = 3;		// client object updates on LAN by default
 char *Cmdline_gateway_ip = nullptr;
+int Cmdline_soak_report = 0;
+int Cmdline_soak_client = 0;
+int Cmdline_standalone_shards = 0;
 
 // Launcher related options
 cmdline_parm portable_mode("-portable_mode", NULL, AT_NONE);
@@ -461,6 +480,8 @@ cmdline_parm no_geo_sdr_effects("-no_geo_effects", NULL, AT_NONE);
 cmdline_parm set_cpu_affinity("-set_cpu_affinity", NULL, AT_NONE);
 cmdline_parm nograb_arg("-nograb", NULL, AT_NONE);
 cmdline_parm noshadercache_arg("-noshadercache", NULL, AT_NONE);
+cmdline_parm no_sound_cache_arg("-no_sound_cache", nullptr, AT_NONE);
+cmdline_parm no_voice_streaming_arg("-no_voice_streaming", nullptr, AT_NONE);
 cmdline_parm prefer_ipv4_arg("-prefer_ipv4", nullptr, AT_NONE);
 cmdline_parm prefer_ipv6_arg("-prefer_ipv6", nullptr, AT_NONE);
 cmdline_parm log_multi_packet_arg("-log_multi_packet", nullptr, AT_NONE);
@@ -485,6 +506,8 @@ bool Cmdline_no_geo_sdr_effects = false;
 bool Cmdline_set_cpu_affinity = false;
 bool Cmdline_nograb = false;
 bool Cmdline_noshadercache = false;
+bool Cmdline_no_sound_cache = false;
+bool Cmdline_no_voice_streaming = false;
 bool Cmdline_prefer_ipv4 = false;
 bool Cmdline_prefer_ipv6 = false;
 bool Cmdline_dump_packet_type = false;
@@ -523,6 +546,7 @@ cmdline_parm benchmark_mode_arg("-benchmark_mode", NULL, AT_NONE); //Cmdline_ben
 cmdline_parm pilot_arg("-pilot", nullptr, AT_STRING); //Cmdline_pilot
 cmdline_parm noninteractive_arg("-noninteractive", NULL, AT_NONE); //Cmdline_noninteractive
 cmdline_parm json_profiling("-json_profiling", NULL, AT_NONE); //Cmdline_json_profiling
+cmdline_parm profile_load_arg("-profile_load", nullptr, AT_NONE); // Cmdline_profile_load
 cmdline_parm show_video_info("-show_video_info", NULL, AT_NONE); //Cmdline_show_video_info
 cmdline_parm frame_profile_arg("-profile_frame_time", NULL, AT_NONE); //Cmdline_frame_profile
 cmdline_parm debug_window_arg("-debug_window", NULL, AT_NONE);	// Cmdline_debug_window
@@ -531,6 +555,7 @@ cmdline_parm log_to_stdout_arg("-stdout_log", nullptr, AT_NONE); // Cmdline_log_
 cmdline_parm slow_frames_ok_arg("-slow_frames_ok", nullptr, AT_NONE);	// Cmdline_slow_frames_ok
 cmdline_parm fixed_seed_rand("-seed", nullptr, AT_INT);	// Cmdline_rng_seed,Cmdline_reuse_rng_seed;
 cmdline_parm luadev_arg("-luadev", "Make lua errors non-fatal", AT_NONE);	// Cmdline_lua_devmode
+cmdline_parm lua_frame_budget_arg("-lua_frame_budget", "Lua hook time budget per frame (ms)", AT_FLOAT);	// Cmdline_lua_frame_budget
 cmdline_parm override_arg("-override_data", "Enable override directory", AT_NONE);	// Cmdline_override_data
 cmdline_parm imgui_debug_arg("-imgui_debug", nullptr, AT_NONE);
 cmdline_parm vulkan("-vulkan", nullptr, AT_NONE);
@@ -563,6 +588,7 @@ bool Cmdline_benchmark_mode = false;
 const char *Cmdline_pilot = nullptr;
 bool Cmdline_noninteractive = false;
 bool Cmdline_json_profiling = false;
+bool Cmdline_profile_load = false;
 bool Cmdline_frame_profile = false;
 bool Cmdline_show_video_info = false;
 bool Cmdline_debug_window = false;
@@ -570,6 +596,7 @@ bool Cmdline_graphics_debug_output = false;
 bool Cmdline_log_to_stdout = false;
 bool Cmdline_slow_frames_ok = false;
 bool Cmdline_lua_devmode = false;
+float Cmdline_lua_frame_budget = 0.0f;
 bool Cmdline_override_data = false;
 bool Cmdline_show_imgui_debug = false;
 bool Cmdline_vulkan = false;
@@ -1615,6 +1642,17 @@ bool SetCmdlineParams()
 		Cmdline_NoFPSCap = 1;
 	}
 
+	if (fixed_timestep_arg.found())
+	{
+		// keep steps between the frametime cap (4 Hz) and a single ms
+		Cmdline_fixed_timestep = fixed_timestep_arg.get_int();
+		if (Cmdline_fixed_timestep < 0) {
+			Cmdline_fixed_timestep = 0;
+		} else if (Cmdline_fixed_timestep > 0) {
+			CLAMP(Cmdline_fixed_timestep, 4, 1000);
+		}
+	}
+
 	if(loadallweapons_arg.found())
 	{
 		Cmdline_load_all_weapons = 1;
@@ -1625,6 +1663,11 @@ bool SetCmdlineParams()
 		Cmdline_voice_recognition = 1;
 	}
 
+	if (loopback_sound_arg.found())
+	{
+		Cmdline_loopback_sound = true;
+	}
+
 #ifdef Allow_NoWarn
 	if (nowarn_arg.found())
 	{
@@ -1736,6 +1779,18 @@ bool SetCmdlineParams()
 		Cmdline_gateway_ip = gateway_ip_arg.str();
 	}
 
+	if ( soak_report_arg.found() ) {
+		Cmdline_soak_report = 1;
+	}
+
+	if ( soak_client_arg.found() ) {
+		Cmdline_soak_client = 1;
+	}
+
+	if ( standalone_shards_arg.found() ) {
+		Cmdline_standalone_shards = MAX(standalone_shards_arg.get_int(), 0);
+	}
+
 	// the connect argument specifies to join a game at this particular address
 	if ( connect_arg.found() ) {
 		Cmdline_use_last_pilot = 1;
@@ -1825,7 +1880,15 @@ bool SetCmdlineParams()
 	if(almission_arg.found()){//DTP for autoload mission // developer oritentated
 		Cmdline_almission = almission_arg.str();
 		Cmdline_use_last_pilot = 1;
-		Cmdline_start_netgame = 1;
+
+		// when joining a standalone server, the mission is loaded once this client becomes its host
+		if (!connect_arg.found()) {
+			Cmdline_start_netgame = 1;
+		}
+	}
+
+	if (almission_players_arg.found()) {
+		Cmdline_almission_players = almission_players_arg.get_int();
 	}
 
 	if(dualscanlines_arg.found() ) {
@@ -2129,6 +2192,16 @@ bool SetCmdlineParams()
 		Cmdline_noshadercache = true;
 	}
 
+	if (no_sound_cache_arg.found())
+	{
+		Cmdline_no_sound_cache = true;
+	}
+
+	if (no_voice_streaming_arg.found())
+	{
+		Cmdline_no_voice_streaming = true;
+	}
+
 	if (lang_arg.found()) 
 	{
 		Cmdline_lang = lang_arg.str();
@@ -2294,6 +2367,11 @@ bool SetCmdlineParams()
 		Cmdline_json_profiling = true;
 	}
 
+	if (profile_load_arg.found())
+	{
+		Cmdline_profile_load = true;
+	}
+
 	if (frame_profile_arg.found() )
 	{
 		Cmdline_frame_profile = true;
@@ -2318,6 +2396,10 @@ bool SetCmdlineParams()
 		Cmdline_lua_devmode = true;
 	}
 
+	if (lua_frame_budget_arg.found()) {
+		Cmdline_lua_frame_budget = MAX(lua_frame_budget_arg.get_float(), 0.0f);
+	}
+
 	if ( override_arg.found()) {
 		Cmdline_override_data = true;
 	}
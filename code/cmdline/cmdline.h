@@ -72,6 +72,7 @@ extern int Cmdline_msaa_enabled;
 // Game Speed related
 extern int Cmdline_NoFPSCap;
 extern bool Cmdline_no_vsync;
+extern int Cmdline_fixed_timestep;
 
 // HUD related
 extern int Cmdline_ballistic_gauge;
@@ -88,6 +89,7 @@ extern bool Cmdline_enable_vr;
 
 // Audio related
 extern int Cmdline_voice_recognition;
+extern bool Cmdline_loopback_sound;
 extern int Cmdline_no_enhanced_sound;
 
 // MOD related
@@ -95,10 +97,14 @@ extern char *Cmdline_mod;	 // DTP for mod support
 extern char *Cmdline_campaign;	 // for campaign support
 // Multiplayer/Network related
 extern char *Cmdline_almission;	// DTP for autoload mission (for multi only)
+extern int Cmdline_almission_players;
 extern int Cmdline_ingamejoin;
 extern int Cmdline_mpnoreturn;
 extern int Cmdline_objupd;
 extern char *Cmdline_gateway_ip;
+extern int Cmdline_soak_report;
+extern int Cmdline_soak_client;
+extern int Cmdline_standalone_shards;
 
 // Launcher related options
 extern bool Cmdline_portable_mode;
@@ -121,6 +127,8 @@ extern bool Cmdline_no_geo_sdr_effects;
 extern bool Cmdline_set_cpu_affinity;
 extern bool Cmdline_nograb;
 extern bool Cmdline_noshadercache;
+extern bool Cmdline_no_sound_cache;
+extern bool Cmdline_no_voice_streaming;
 extern bool Cmdline_prefer_ipv4;
 extern bool Cmdline_prefer_ipv6;
 extern bool Cmdline_dump_packet_type;
@@ -149,6 +157,7 @@ extern bool Cmdline_benchmark_mode;
 extern const char *Cmdline_pilot;
 extern bool Cmdline_noninteractive;
 extern bool Cmdline_json_profiling;
+extern bool Cmdline_profile_load;
 extern bool Cmdline_frame_profile;
 extern bool Cmdline_show_video_info;
 extern bool Cmdline_debug_window;
@@ -156,6 +165,7 @@ extern bool Cmdline_graphics_debug_output;
 extern bool Cmdline_log_to_stdout;
 extern bool Cmdline_slow_frames_ok;
 extern bool Cmdline_lua_devmode;
+extern float Cmdline_lua_frame_budget;
 extern bool Cmdline_override_data;
 extern bool Cmdline_show_imgui_debug;
 extern bool Cmdline_vulkan;
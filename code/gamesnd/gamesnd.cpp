@@ -553,17 +553,20 @@ void gamesnd_preload_common_sounds()
 	if ( !Sound_enabled )
 		return;
 
+	SCP_vector<snd_load_request> requests;
+
 	Assert( Snds.size() <= INT_MAX );
 	for (auto& gs: Snds) {
 		if ( gs.flags & GAME_SND_PRELOAD ) {
 			for (auto& entry : gs.sound_entries) {
 				if ( entry.filename[0] != 0 && strnicmp(entry.filename, NOX("none.wav"), 4) != 0 ) {
-					game_busy( NOX("** preloading common game sounds **") );	// Animate loading cursor... does nothing if loading screen not active.
-					entry.id = snd_load(&entry, &gs.flags);
+					requests.push_back({ &entry, &gs.flags });
 				}
 			}
 		}
 	}
+
+	snd_load_batch(requests, NOX("** preloading common game sounds **"));
 }
 
 /**
@@ -574,17 +577,20 @@ void gamesnd_load_gameplay_sounds()
 	if ( !Sound_enabled )
 		return;
 
+	SCP_vector<snd_load_request> requests;
+
 	Assert( Snds.size() <= INT_MAX );
 	for (auto& gs: Snds) {
 		if ( !(gs.flags & GAME_SND_PRELOAD) ) { // don't try to load anything that's already preloaded
 			for (auto& entry : gs.sound_entries) {
 				if (entry.filename[0] != 0 && strnicmp(entry.filename, NOX("none.wav"), 4) != 0) {
-					game_busy(NOX("** preloading gameplay sounds **"));        // Animate loading cursor... does nothing if loading screen not active.
-					entry.id = snd_load(&entry, &gs.flags);
+					requests.push_back({ &entry, &gs.flags });
 				}
 			}
 		}
 	}
+
+	snd_load_batch(requests, NOX("** preloading gameplay sounds **"));
 }
 
 /**
@@ -611,14 +617,18 @@ void gamesnd_load_interface_sounds()
 	if ( !Sound_enabled )
 		return;
 
+	SCP_vector<snd_load_request> requests;
+
 	Assert( Snds_iface.size() < INT_MAX );
 	for (auto& gs: Snds) {
 		for (auto& entry : gs.sound_entries) {
 			if ( entry.filename[0] != 0 && strnicmp(entry.filename, NOX("none.wav"), 4) != 0 ) {
-				entry.id = snd_load(&entry, &gs.flags);
+				requests.push_back({ &entry, &gs.flags });
 			}
 		}
 	}
+
+	snd_load_batch(requests);
 }
 
 /**
@@ -14,6 +14,7 @@
 #include "graphics/2d.h"
 #include "nebula/neb.h"
 #include "options/Option.h"
+#include "tracing/LoadProfiler.h"
 
 fix Missiontime;
 fix Frametime;
@@ -147,6 +148,8 @@ void game_busy(const char *filename)
 	int t1 = timer_get_milliseconds();
 
 	if ( (t1 > cf_timestamp) || ((cb_counter > cb_last_counter+155) && (cb_delta_step > 0)) )	{
+		LOAD_PROFILE_PHASE(LoadingScreen);
+
 		cb_last_counter = cb_counter;
 		cf_in_callback++;
 		(*cf_callback)(cb_counter);
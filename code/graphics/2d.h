@@ -841,7 +841,7 @@ typedef struct screen {
 
 	// new drawing functions
 	std::function<
-		void(model_material* material_info, indexed_vertex_source* vert_source, vertex_buffer* bufferp, size_t texi)>
+		void(model_material* material_info, indexed_vertex_source* vert_source, vertex_buffer* bufferp, size_t texi, int instances)>
 		gf_render_model;
 	std::function<void(shield_material* material_info,
 		primitive_type prim_type,
@@ -1257,9 +1257,11 @@ inline void gr_render_movie(movie_material* material_info,
 	gr_screen.gf_render_movie(material_info, prim_type, layout, n_verts, buffer, buffer_offset);
 }
 
-inline void gr_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi)
+// Draws one texture buffer of a model.  With instances > 1 the buffer is drawn that many times in a single call and
+// the batched transform lookup of each instance is offset by the instance_matrix_stride of the model uniforms.
+inline void gr_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi, int instances = 1)
 {
-	gr_screen.gf_render_model(material_info, vert_source, bufferp, texi);
+	gr_screen.gf_render_model(material_info, vert_source, bufferp, texi, instances);
 }
 
 inline void gr_render_rocket_primitives(interface_material* material_info,
@@ -333,7 +333,7 @@ void gr_stub_render_shield_impact(shield_material* /*material_info*/,
 {
 }
 
-void gr_stub_render_model(model_material*  /*material_info*/, indexed_vertex_source * /*vert_source*/, vertex_buffer*  /*bufferp*/, size_t  /*texi*/)
+void gr_stub_render_model(model_material*  /*material_info*/, indexed_vertex_source * /*vert_source*/, vertex_buffer*  /*bufferp*/, size_t  /*texi*/, int /*instances*/)
 {
 
 }
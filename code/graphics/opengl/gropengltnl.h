@@ -66,8 +66,8 @@ void gr_opengl_update_transform_buffer(void* data, size_t size);
 void opengl_tnl_init();
 void opengl_tnl_shutdown();
 
-void gr_opengl_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi);
-void opengl_render_model_program(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, buffer_data *datap);
+void gr_opengl_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi, int instances);
+void opengl_render_model_program(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, buffer_data *datap, int instances = 1);
 
 void opengl_tnl_set_material(material* material_info, bool set_base_map, bool set_clipping = true);
 void opengl_tnl_set_material_distortion(distortion_material* material_info);
@@ -29,11 +29,22 @@ void scale_matrix(matrix4& mat, const vec3d& scale) {
 namespace graphics {
 namespace uniforms {
 
+void capture_model_light_uniforms(model_light_uniforms* lights_out)
+{
+	lights_out->n_lights = MIN(Num_active_gr_lights, (int)graphics::MAX_UNIFORM_LIGHTS);
+
+	gr_lighting_fill_uniforms(lights_out->lights, sizeof(lights_out->lights));
+
+	gr_get_ambient_light(&lights_out->ambient);
+}
+
 void convert_model_material(model_uniform_data* data_out,
 							const model_material& material,
 							const matrix4& model_transform,
 							const vec3d& scale,
-							size_t transform_buffer_offset) {
+							size_t transform_buffer_offset,
+							size_t instance_matrix_stride,
+							const model_light_uniforms* lights) {
 	auto shader_flags = material.get_shader_flags();
 
 	Assertion(gr_model_matrix_stack.depth() == 1, "Uniform conversion does not respect previous transforms! "
@@ -85,16 +96,18 @@ void convert_model_material(model_uniform_data* data_out,
 	}
 
 	if (material.is_lit()) {
-		int num_lights = MIN(Num_active_gr_lights, (int)graphics::MAX_UNIFORM_LIGHTS);
-		data_out->n_lights = num_lights;
+		Assertion(lights != nullptr, "Lit materials need the lights to convert their uniforms!");
+
+		data_out->n_lights = lights->n_lights;
 
-		gr_lighting_fill_uniforms(data_out->lights, sizeof(data_out->lights));
+		static_assert(sizeof(data_out->lights) == sizeof(lights->lights), "Captured lights do not match the uniform layout!");
+		memcpy(data_out->lights, lights->lights, sizeof(data_out->lights));
 
 		float light_factor = material.get_light_factor();
 		data_out->diffuseFactor.xyz.x = gr_light_color[0] * light_factor;
 		data_out->diffuseFactor.xyz.y = gr_light_color[1] * light_factor;
 		data_out->diffuseFactor.xyz.z = gr_light_color[2] * light_factor;
-		gr_get_ambient_light(&data_out->ambientFactor);
+		data_out->ambientFactor = lights->ambient;
 
 		if (material.get_light_factor() > 0.25f && Cmdline_emissive) {
 			data_out->emissionFactor.xyz.x = gr_light_emission[0];
@@ -187,6 +200,9 @@ void convert_model_material(model_uniform_data* data_out,
 		data_out->buffer_matrix_offset = (int) transform_buffer_offset;
 	}
 
+	// the shadow map shader uses the instance id for the cascades so this must be zero for everything not instanced
+	data_out->instance_matrix_stride = (int) instance_matrix_stride;
+
 	// Team colors are passed to the shader here, but the shader needs to handle their application.
 	// By default, this is handled through the r and g channels of the misc map, but this can be changed
 	// in the shader; test versions of this used the normal map r and b channels
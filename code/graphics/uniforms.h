@@ -12,11 +12,37 @@
 namespace graphics {
 namespace uniforms {
 
+/**
+ * @brief The part of the model uniforms which depends on the lights set with gr_set_light
+ */
+struct model_light_uniforms {
+	int n_lights;
+	model_light lights[MAX_UNIFORM_LIGHTS];
+	vec3d ambient;
+};
+
+/**
+ * @brief Captures the currently set lights so that uniforms for lit materials can be converted later without relying
+ * on the global light state, e.g. on another thread
+ */
+void capture_model_light_uniforms(model_light_uniforms* lights_out);
+
+/**
+ * @brief Converts a model material into its uniform representation
+ *
+ * This does not modify any global state, so several draws may be converted concurrently.
+ *
+ * @param instance_matrix_stride For instanced batched draws the distance between the transforms of two instances in the
+ * transform buffer, 0 otherwise
+ * @param lights The lights for lit materials, as captured by capture_model_light_uniforms. May be nullptr for unlit ones.
+ */
 void convert_model_material(model_uniform_data* data_out,
 							const model_material& material,
 							const matrix4& model_transform,
 							const vec3d& scale,
-							size_t transform_buffer_offset);
+							size_t transform_buffer_offset,
+							size_t instance_matrix_stride,
+							const model_light_uniforms* lights);
 
 }
 }
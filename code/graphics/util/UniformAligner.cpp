@@ -40,6 +40,15 @@ void* UniformAligner::addElement()
 
 	return reinterpret_cast<void*>(_buffer + el_offset);
 }
+void UniformAligner::addElements(size_t num_elements)
+{
+	Assertion(_buffer_offset + alignSize(_dataSize, _requiredAlignment) * num_elements <= _buffer_size,
+	          "Not enough space in the buffer for adding %d elements! "
+	          "Check the number of elements the buffer was allocated with!", static_cast<int>(num_elements));
+
+	_buffer_offset += alignSize(_dataSize, _requiredAlignment) * num_elements;
+	_numElements += num_elements;
+}
 void* UniformAligner::getElement(size_t index) {
 	size_t offset = alignSize(_headerSize, _requiredAlignment) + alignSize(_dataSize, _requiredAlignment) * index;
 
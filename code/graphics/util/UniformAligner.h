@@ -35,6 +35,15 @@ class UniformAligner {
 
 	void* addElement();
 
+	/**
+	 * @brief Adds several elements at once without touching their data
+	 *
+	 * The elements can then be filled in any order, and from several threads, through getElement and getOffset.
+	 *
+	 * @param num_elements The number of elements to add
+	 */
+	void addElements(size_t num_elements);
+
 	template <typename T>
 	T* addTypedElement()
 	{
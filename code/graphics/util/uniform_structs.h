@@ -138,7 +138,7 @@ struct model_uniform_data {
 	int sMiscmapIndex;
 	float alphaMult;
 	int flags;
-	float pad;
+	int instance_matrix_stride;
 };
 
 const size_t model_uniform_data_size = sizeof(model_uniform_data);
@@ -152,7 +152,8 @@ void stub_render_shield_impact(shield_material* /*material_info*/,
 void stub_render_model(model_material* /*material_info*/,
 	indexed_vertex_source* /*vert_source*/,
 	vertex_buffer* /*bufferp*/,
-	size_t /*texi*/)
+	size_t /*texi*/,
+	int /*instances*/)
 {
 }
 
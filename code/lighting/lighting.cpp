@@ -660,14 +660,29 @@ light_indexing_info scene_lights::bufferLights()
 		return light_info;
 	}
 
+	light_info.num_lights = FilteredLights.size();
+
+	// objects that are close to each other are usually lit by the same lights.  Giving them the same buffered set means
+	// draws can be sorted and merged by the lights they use instead of by the object they belong to.
+	size_t hash = FilteredLights.size();
+	for ( auto light_index : FilteredLights ) {
+		hash ^= std::hash<size_t>()(light_index) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+
+	auto existing = BufferedLightSets.find(hash);
+	if ( existing != BufferedLightSets.end() && existing->second.num_lights == light_info.num_lights
+		&& std::equal(FilteredLights.begin(), FilteredLights.end(), BufferedLights.begin() + existing->second.index_start) ) {
+		return existing->second;
+	}
+
+	// on a hash collision the set that was there first keeps its entry
 	light_info.index_start = BufferedLights.size();
-	
+	BufferedLightSets.emplace(hash, light_info);
+
 	for ( i = 0; i < FilteredLights.size(); ++i ) {
 		BufferedLights.push_back(FilteredLights[i]);
 	}
 
-	light_info.num_lights = FilteredLights.size();
-
 	return light_info;
 }
 
@@ -76,6 +76,9 @@ class scene_lights
 
 	SCP_vector<size_t> BufferedLights;
 
+	// every distinct set of filtered lights in BufferedLights, keyed by a hash of the set
+	SCP_unordered_map<size_t, light_indexing_info> BufferedLightSets;
+
 	size_t current_light_index;
 	size_t current_num_lights;
 public:
@@ -1719,6 +1719,61 @@ void vm_quaternion_rotate(matrix *M, float theta, const vec3d *u)
 	vm_quaternion_to_matrix(M, a, b, c, s);
 }
 
+void vm_matrix_to_quaternion(vec4* q, const matrix* M)
+{
+	float trace = M->vec.rvec.xyz.x + M->vec.uvec.xyz.y + M->vec.fvec.xyz.z;
+
+	// pick the largest component as the divisor to stay numerically stable
+	if (trace > 0.0f) {
+		float s = sqrtf(trace + 1.0f) * 2.0f;
+		q->xyzw.w = 0.25f * s;
+		q->xyzw.x = (M->vec.uvec.xyz.z - M->vec.fvec.xyz.y) / s;
+		q->xyzw.y = (M->vec.fvec.xyz.x - M->vec.rvec.xyz.z) / s;
+		q->xyzw.z = (M->vec.rvec.xyz.y - M->vec.uvec.xyz.x) / s;
+	} else if ((M->vec.rvec.xyz.x > M->vec.uvec.xyz.y) && (M->vec.rvec.xyz.x > M->vec.fvec.xyz.z)) {
+		float s = sqrtf(1.0f + M->vec.rvec.xyz.x - M->vec.uvec.xyz.y - M->vec.fvec.xyz.z) * 2.0f;
+		q->xyzw.w = (M->vec.uvec.xyz.z - M->vec.fvec.xyz.y) / s;
+		q->xyzw.x = 0.25f * s;
+		q->xyzw.y = (M->vec.rvec.xyz.y + M->vec.uvec.xyz.x) / s;
+		q->xyzw.z = (M->vec.rvec.xyz.z + M->vec.fvec.xyz.x) / s;
+	} else if (M->vec.uvec.xyz.y > M->vec.fvec.xyz.z) {
+		float s = sqrtf(1.0f + M->vec.uvec.xyz.y - M->vec.rvec.xyz.x - M->vec.fvec.xyz.z) * 2.0f;
+		q->xyzw.w = (M->vec.fvec.xyz.x - M->vec.rvec.xyz.z) / s;
+		q->xyzw.x = (M->vec.rvec.xyz.y + M->vec.uvec.xyz.x) / s;
+		q->xyzw.y = 0.25f * s;
+		q->xyzw.z = (M->vec.uvec.xyz.z + M->vec.fvec.xyz.y) / s;
+	} else {
+		float s = sqrtf(1.0f + M->vec.fvec.xyz.z - M->vec.rvec.xyz.x - M->vec.uvec.xyz.y) * 2.0f;
+		q->xyzw.w = (M->vec.rvec.xyz.y - M->vec.uvec.xyz.x) / s;
+		q->xyzw.x = (M->vec.rvec.xyz.z + M->vec.fvec.xyz.x) / s;
+		q->xyzw.y = (M->vec.uvec.xyz.z + M->vec.fvec.xyz.y) / s;
+		q->xyzw.z = 0.25f * s;
+	}
+}
+
+void vm_quaternion_nlerp(vec4* out, const vec4* q0, const vec4* q1, float t)
+{
+	float dot = q0->xyzw.x * q1->xyzw.x + q0->xyzw.y * q1->xyzw.y + q0->xyzw.z * q1->xyzw.z + q0->xyzw.w * q1->xyzw.w;
+
+	// q and -q are the same rotation, so flip the goal if that's the shorter way around
+	float t1 = (dot < 0.0f) ? -t : t;
+	float t0 = 1.0f - t;
+
+	for (int i = 0; i < 4; i++) {
+		out->a1d[i] = q0->a1d[i] * t0 + q1->a1d[i] * t1;
+	}
+
+	float mag = sqrtf(out->xyzw.x * out->xyzw.x + out->xyzw.y * out->xyzw.y + out->xyzw.z * out->xyzw.z + out->xyzw.w * out->xyzw.w);
+
+	if (mag > 0.0f) {
+		for (float& component : out->a1d) {
+			component /= mag;
+		}
+	} else {
+		*out = *q0;
+	}
+}
+
 // --------------------------------------------------------------------------------------
 
 //void vm_matrix_to_rot_axis_and_angle(matrix *m, float *theta, vec3d *rot_axis)
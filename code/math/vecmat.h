@@ -527,6 +527,13 @@ bool is_valid_matrix(const matrix *m);
 // Converts quaterions to a respective rotation matrix
 void vm_quaternion_to_matrix(matrix* M, float a, float b, float c, float s);
 
+// Converts a rotation matrix to a unit quaternion stored as (a, b, c, s) in x, y, z, w, the inverse of vm_quaternion_to_matrix()
+void vm_matrix_to_quaternion(vec4* q, const matrix* M);
+
+// Normalized linear interpolation between two unit quaternions, t goes from 0.0 to 1.0.
+// Takes the shorter path and is accurate for the small angles between consecutive frames.
+void vm_quaternion_nlerp(vec4* out, const vec4* q0, const vec4* q1, float t);
+
 // Finds the rotation matrix corresponding to a rotation of theta about axis u
 void vm_quaternion_rotate(matrix *m, float theta, const vec3d *u);
 
@@ -462,6 +462,14 @@ void player_select_do()
 
 	//skip this if pilot is given through cmdline, assuming single-player
 	if (Cmdline_pilot) {
+		// soak test clients create their pilot if it doesn't exist yet, so that automated runs need no setup
+		if (Cmdline_soak_client) {
+			SCP_string pilot_file = SCP_string(Cmdline_pilot) + ".json";
+			if (!cf_exists_full(pilot_file.c_str(), CF_TYPE_PLAYERS) && !player_create_new_pilot(Cmdline_pilot, false, nullptr)) {
+				Error(LOCATION, "Couldn't create pilot \"%s\" given on the command line!", Cmdline_pilot);
+			}
+		}
+
 		player_finish_select(Cmdline_pilot, false);
 		return;
 	}
@@ -10,6 +10,7 @@
 #include "mission/missionmessage.h"
 
 #include "anim/animplay.h"
+#include "cmdline/cmdline.h"
 #include "gamesequence/gamesequence.h"
 #include "gamesnd/gamesnd.h"
 #include "globalincs/utility.h"
@@ -213,6 +214,24 @@ static float Distort_patterns[MAX_DISTORT_PATTERNS][MAX_DISTORT_LEVELS] =
 static int Distort_num;		// which distort pattern is being used
 static int Distort_next;	// which section of distort pattern is next
 
+///////////////////////////////////////////////////////////////////
+// message voices are streamed instead of loaded whole.  The voices
+// of the next few messages on the queue are opened and cued ahead of
+// time, which only decodes their first few hundred ms.
+///////////////////////////////////////////////////////////////////
+#define MAX_PRELOADED_VOICES	2
+
+typedef struct preloaded_voice {
+	char	filename[MAX_FILENAME_LEN];
+	int	stream;						// -1 if the file could not be opened
+} preloaded_voice;
+
+static preloaded_voice Preloaded_voices[MAX_PRELOADED_VOICES];
+static int Num_preloaded_voices = 0;
+
+// streams of messages that are done, but still have their last few ms to play
+static SCP_vector<int> Finishing_voice_streams;
+
 int Head_coords[GR_NUM_RESOLUTIONS][2] = {
 	{ // GR_640
 		7, 45
@@ -959,6 +978,7 @@ void messages_init()
 		Playing_messages[i].start_frame = -1;
 		Playing_messages[i].play_anim = false;
 		Playing_messages[i].wave         = sound_handle::invalid();
+		Playing_messages[i].stream = -1;
 		Playing_messages[i].id = -1;
 		Playing_messages[i].priority = -1;
 		Playing_messages[i].shipnum = -1;
@@ -979,6 +999,85 @@ void messages_init()
 	Message_waves.erase((Message_waves.begin()+Num_builtin_waves), Message_waves.end());
 }
 
+// whether message voices are streamed
+static bool message_voice_streaming()
+{
+	return !Cmdline_no_voice_streaming && audiostream_is_inited();
+}
+
+// functions to deal with the voice of a playing message, which is either streamed or a loaded sound
+
+static bool message_has_voice(const pmessage *pm)
+{
+	return (pm->stream >= 0) || pm->wave.isValid();
+}
+
+static bool message_voice_is_playing(const pmessage *pm)
+{
+	if (pm->stream >= 0)
+		return audiostream_is_playing(pm->stream) != 0;
+
+	return pm->wave.isValid() && snd_is_playing(pm->wave);
+}
+
+static bool message_voice_is_paused(const pmessage *pm)
+{
+	if (pm->stream >= 0)
+		return audiostream_is_paused(pm->stream) > 0;
+
+	return pm->wave.isValid() && snd_is_paused(pm->wave);
+}
+
+static int message_voice_time_remaining(const pmessage *pm)
+{
+	if (pm->stream >= 0)
+		return audiostream_get_time_remaining(pm->stream);
+
+	return pm->wave.isValid() ? snd_time_remaining(pm->wave) : 0;
+}
+
+static void message_voice_set_volume(const pmessage *pm, float volume)
+{
+	if (pm->stream >= 0)
+		audiostream_set_volume(pm->stream, volume);
+	else if (pm->wave.isValid())
+		snd_set_volume(pm->wave, volume, true);
+}
+
+static void message_voice_stop(pmessage *pm)
+{
+	if (pm->stream >= 0) {
+		audiostream_close_file(pm->stream, false);
+		pm->stream = -1;
+	} else if (pm->wave.isValid() && snd_is_playing(pm->wave)) {
+		snd_stop(pm->wave);
+	}
+}
+
+// closes the streams of finished messages once they have played out, or right away if force is set
+static void message_voice_close_finished(bool force)
+{
+	auto it = std::remove_if(Finishing_voice_streams.begin(), Finishing_voice_streams.end(), [force](int stream) {
+		if (!force && audiostream_is_playing(stream))
+			return false;
+
+		audiostream_close_file(stream, false);
+		return true;
+	});
+	Finishing_voice_streams.erase(it, Finishing_voice_streams.end());
+}
+
+// closes all streams that are not tied to a playing message
+static void message_voice_close_all()
+{
+	message_voice_close_finished(true);
+
+	for (int i = 0; i < Num_preloaded_voices; i++) {
+		audiostream_close_file(Preloaded_voices[i].stream, false);
+	}
+	Num_preloaded_voices = 0;
+}
+
 // free a loaded avi
 void message_mission_free_avi(int m_index)
 {
@@ -1001,6 +1100,9 @@ void message_mission_shutdown()
 	// kill/stop all playing messages sounds and animations if we need to
 	message_kill_all(true);
 
+	// message_kill_all() does nothing if no message is playing
+	message_voice_close_all();
+
 	// remove the wave sounds from memory
 	for (i = 0; i < Num_message_waves; i++ ) {
 		if (Message_waves[i].num.isValid()) {
@@ -1043,7 +1145,9 @@ int message_queue_priority_compare(const message_q *ma, const message_q *mb)
 void message_pause_all()
 {
 	for (int i = 0; i < Num_messages_playing; i++) {
-		if ((Playing_messages[i].wave.isValid()) && snd_is_playing(Playing_messages[i].wave)) {
+		if (Playing_messages[i].stream >= 0) {
+			audiostream_pause(Playing_messages[i].stream);
+		} else if ((Playing_messages[i].wave.isValid()) && snd_is_playing(Playing_messages[i].wave)) {
 			snd_pause(Playing_messages[i].wave);
 		}
 	}
@@ -1053,7 +1157,9 @@ void message_pause_all()
 void message_resume_all()
 {
 	for (int i = 0; i < Num_messages_playing; i++) {
-		if ((Playing_messages[i].wave.isValid()) && snd_is_paused(Playing_messages[i].wave)) {
+		if (Playing_messages[i].stream >= 0) {
+			audiostream_unpause(Playing_messages[i].stream);
+		} else if ((Playing_messages[i].wave.isValid()) && snd_is_paused(Playing_messages[i].wave)) {
 			snd_resume(Playing_messages[i].wave);
 		}
 	}
@@ -1078,9 +1184,7 @@ void message_kill_all( bool kill_all )
 		}
 
 		if ( kill_all ) {
-			if ((Playing_messages[i].wave.isValid()) && snd_is_playing(Playing_messages[i].wave)) {
-				snd_stop( Playing_messages[i].wave );
-			}
+			message_voice_stop(&Playing_messages[i]);
 
 			Playing_messages[i].shipnum = -1;
 		}
@@ -1088,6 +1192,7 @@ void message_kill_all( bool kill_all )
 
 	if ( kill_all ) {
 		Num_messages_playing = 0;
+		message_voice_close_finished(true);
 		fsspeech_stop();
 	}
 }
@@ -1105,8 +1210,7 @@ void message_kill_playing( int message_num )
 		Playing_messages[message_num].play_anim = false;
 	}
 
-	if ((Playing_messages[message_num].wave.isValid()) && snd_is_playing(Playing_messages[message_num].wave))
-		snd_stop( Playing_messages[message_num].wave );
+	message_voice_stop(&Playing_messages[message_num]);
 
 	Playing_messages[message_num].shipnum = -1;
 
@@ -1284,10 +1388,115 @@ void message_filename_convert_to_command(char *buf, const char *filename)
 	strcat(buf, &filename[2]);
 }
 
+// Get the name of the wave file to play for a queued message
+// input: q			=>		message queue data
+//        filename	=>		buffer of MAX_FILENAME_LEN chars for the name
+//
+// returns false if no wave should be played for the message
+static bool message_get_wave_filename( const message_q *q, char *filename )
+{
+	const MissionMessage *m = &Messages[q->message_num];
+
+	if ( m->wave_info.index < 0 )
+		return false;
+
+	strcpy( filename, Message_waves[m->wave_info.index].name );
+
+	// Goober5000 - if we're using simulated speech, it should pre-empt the generic beeps
+	if (fsspeech_play_from(FSSPEECH_FROM_INGAME) && message_filename_is_generic(filename))
+		return false;
+
+	// if we need to bash the wave name because of "conversion" to terran command, do it here
+	// Look for "[1-6]_" at the front of the message.  If found, then convert to TC_*
+	if ( q->flags & MQF_CONVERT_TO_COMMAND && message_filename_has_fs1_wingman_prefix(filename) ) {
+		char temp[MAX_FILENAME_LEN];
+		message_filename_convert_to_command(temp, filename);
+		strcpy( filename, temp );
+	}
+
+	return true;
+}
+
+static int message_find_preloaded_voice( const char *filename )
+{
+	for ( int i = 0; i < Num_preloaded_voices; i++ ) {
+		if ( !stricmp(Preloaded_voices[i].filename, filename) )
+			return i;
+	}
+
+	return -1;
+}
+
+// Opens and cues the voices of the next messages on the queue, and closes the preloaded voices
+// of messages that are no longer coming up
+static void message_preload_voices()
+{
+	char upcoming[MAX_PRELOADED_VOICES][MAX_FILENAME_LEN];
+	int num_upcoming = 0;
+	int i, j;
+
+	if ( message_voice_streaming() ) {
+		for ( i = 0; (i < MessageQ_num) && (num_upcoming < MAX_PRELOADED_VOICES); i++ ) {
+			if ( message_get_wave_filename(&MessageQ[i], upcoming[num_upcoming]) )
+				num_upcoming++;
+		}
+	}
+
+	i = 0;
+	while ( i < Num_preloaded_voices ) {
+		for ( j = 0; j < num_upcoming; j++ ) {
+			if ( !stricmp(Preloaded_voices[i].filename, upcoming[j]) )
+				break;
+		}
+
+		if ( j < num_upcoming ) {
+			i++;
+			continue;
+		}
+
+		audiostream_close_file(Preloaded_voices[i].stream, false);
+		Preloaded_voices[i] = Preloaded_voices[--Num_preloaded_voices];
+	}
+
+	for ( j = 0; (j < num_upcoming) && (Num_preloaded_voices < MAX_PRELOADED_VOICES); j++ ) {
+		if ( message_find_preloaded_voice(upcoming[j]) >= 0 )
+			continue;
+
+		// failures are kept in the list too, so that missing files are not searched for every frame
+		preloaded_voice *pv = &Preloaded_voices[Num_preloaded_voices++];
+		strcpy_s( pv->filename, upcoming[j] );
+		pv->stream = audiostream_open( pv->filename, ASF_VOICE );
+
+		if ( pv->stream >= 0 )
+			audiostream_cue( pv->stream );
+	}
+}
+
+// Starts streaming the voice of a message, using the preloaded stream if there is one
+// returns the stream, or -1 if the file could not be opened
+static int message_stream_wave( const char *filename )
+{
+	int stream = -1;
+
+	int idx = message_find_preloaded_voice(filename);
+	if ( idx >= 0 ) {
+		stream = Preloaded_voices[idx].stream;
+		Preloaded_voices[idx] = Preloaded_voices[--Num_preloaded_voices];
+	}
+
+	if ( stream < 0 )
+		stream = audiostream_open( filename, ASF_VOICE );
+
+	if ( stream >= 0 )
+		audiostream_play( stream, (Master_voice_volume * aav_voice_volume), 0 );
+
+	return stream;
+}
+
 // Play wave file associated with message
 // input: m		=>		pointer to message description
 //
-// note: changes Message_wave_duration, Playing_messages[].wave, and Message_waves[].num
+// note: changes Message_wave_duration, Playing_messages[].wave, Playing_messages[].stream, and Message_waves[].num
 bool message_play_wave( message_q *q )
 {
 	int index;
@@ -1296,40 +1505,38 @@ bool message_play_wave( message_q *q )
 
 	m = &Messages[q->message_num];
 
-	if ( m->wave_info.index >= 0 ) {
-		index = m->wave_info.index;
-		strcpy_s( filename, Message_waves[index].name );
+	if ( !message_get_wave_filename(q, filename) )
+		return false;
 
-		// Goober5000 - if we're using simulated speech, it should pre-empt the generic beeps
-		if (fsspeech_play_from(FSSPEECH_FROM_INGAME) && message_filename_is_generic(filename))
-			return false;
+	index = m->wave_info.index;
 
-		// if we need to bash the wave name because of "conversion" to terran command, do it here
-		// Look for "[1-6]_" at the front of the message.  If found, then convert to TC_*
-		if ( q->flags & MQF_CONVERT_TO_COMMAND && message_filename_has_fs1_wingman_prefix(filename) ) {
-			char temp[MAX_FILENAME_LEN];
-			message_filename_convert_to_command(temp, filename);
-			strcpy_s(filename, temp);
+	if ( message_voice_streaming() ) {
+		int stream = message_stream_wave(filename);
 
-			Message_waves[index].num = sound_load_id::invalid(); // forces us to reload the message
-		}
+		if ( stream >= 0 ) {
+			Message_wave_duration = fl2i(1000.0f * audiostream_get_duration(stream));
+			Playing_messages[Num_messages_playing].stream = stream;
 
-		// load the sound file into memory
-		message_load_wave(index, filename);
-		if (!Message_waves[index].num.isValid()) {
-			m->wave_info.index = -1;
+			return true;
 		}
+	}
 
-		if ( m->wave_info.index >= 0 ) {
-			// this call relies on the fact that snd_play returns -1 if the sound cannot be played
-			Message_wave_duration = snd_get_duration(Message_waves[index].num);
-			Playing_messages[Num_messages_playing].wave = snd_play_raw( Message_waves[index].num, 0.0f );
+	if ( stricmp(filename, Message_waves[index].name) != 0 ) {
+		Message_waves[index].num = sound_load_id::invalid(); // forces us to reload the message
+	}
 
-			return Playing_messages[Num_messages_playing].wave.isValid();
-		}
+	// load the sound file into memory
+	message_load_wave(index, filename);
+	if (!Message_waves[index].num.isValid()) {
+		m->wave_info.index = -1;
+		return false;
 	}
 
-	return false;
+	// this call relies on the fact that snd_play returns -1 if the sound cannot be played
+	Message_wave_duration = snd_get_duration(Message_waves[index].num);
+	Playing_messages[Num_messages_playing].wave = snd_play_raw( Message_waves[index].num, 0.0f );
+
+	return Playing_messages[Num_messages_playing].wave.isValid();
 }
 
 // Determine the starting frame for the animation
@@ -1557,6 +1764,8 @@ void message_queue_process()
 		return;
 	}
 
+	message_voice_close_finished(false);
+
 	// determine if all playing messages (if any) are done playing.  If any are done, remove their
 	// entries collapsing the Playing_messages array if necessary
 	if ( Num_messages_playing > 0 ) {
@@ -1573,11 +1782,11 @@ void message_queue_process()
 			wave_done = 1;
 
 //			if ( (Playing_messages[i].wave != -1) && snd_is_playing(Playing_messages[i].wave) )
-			if ((Playing_messages[i].wave.isValid()) && (snd_time_remaining(Playing_messages[i].wave) > 250))
+			if (message_has_voice(&Playing_messages[i]) && (message_voice_time_remaining(&Playing_messages[i]) > 250))
 				wave_done = 0;
 
 			// Don't kill paused messages
-			if ((Playing_messages[i].wave.isValid()) && snd_is_paused(Playing_messages[i].wave)) {
+			if (message_voice_is_paused(&Playing_messages[i])) {
 				wave_done = 0;
 			}
 
@@ -1586,7 +1795,7 @@ void message_queue_process()
 				wave_done = 0;
 
 			// AL 1-20-98: If voice message is done, kill the animation early
-			if ((Playing_messages[i].wave.isValid()) && wave_done) {
+			if (message_has_voice(&Playing_messages[i]) && wave_done) {
 				/*if ( !ani_done ) {
 					anim_stop_playing( Playing_messages[i].anim );
 				}*/
@@ -1626,10 +1835,17 @@ void message_queue_process()
 			// if both ani and wave are done, mark internal variable so we can do next message on queue, and
 			// global variable to clear voice brackets on hud
 			if (wave_done && ani_done &&
-			    (timestamp_elapsed(Message_expire) || (Playing_messages[i].wave.isValid()) ||
+			    (timestamp_elapsed(Message_expire) || message_has_voice(&Playing_messages[i]) ||
 			     (Playing_messages[i].shipnum == -1))) {
 				nprintf(("messaging", "Message %d is done playing\n", i));
 				Message_shipnum = -1;
+
+				// let the voice play out the rest of the way
+				if (Playing_messages[i].stream >= 0) {
+					Finishing_voice_streams.push_back(Playing_messages[i].stream);
+					Playing_messages[i].stream = -1;
+				}
+
 				Num_messages_playing--;
 				if ( Num_messages_playing == 0 )
 					break;
@@ -1670,6 +1886,8 @@ void message_queue_process()
 		}
 	}
 
+	message_preload_voices();
+
 	// no need to process anything if there isn't anything on the queue
 	if ( MessageQ_num <= 0 ){
 		return;
@@ -1829,6 +2047,7 @@ void message_queue_process()
 	m = &Messages[q->message_num];
 	Playing_messages[Num_messages_playing].anim_data = NULL;
 	Playing_messages[Num_messages_playing].wave = sound_handle::invalid();
+	Playing_messages[Num_messages_playing].stream = -1;
 	Playing_messages[Num_messages_playing].id  = q->message_num;
 	Playing_messages[Num_messages_playing].priority = q->priority;
 	Playing_messages[Num_messages_playing].shipnum = Message_shipnum;
@@ -1854,7 +2073,7 @@ void message_queue_process()
 
 #ifndef NDEBUG
 	// debug only -- if the message is a builtin message, put in parens whether or not the voice played
-	if (Sound_enabled && !Playing_messages[Num_messages_playing].wave.isValid()) {
+	if (Sound_enabled && !message_has_voice(&Playing_messages[Num_messages_playing])) {
 		buf += NOX("..(no wavefile for voice)");
 		snd_play(gamesnd_get_game_sound(GameSounds::CUE_VOICE));
 	}
@@ -2493,13 +2712,13 @@ void message_maybe_distort()
 		return;
 	
 	for ( i = 0; i < Num_messages_playing; i++ ) {
-		if ( !snd_is_playing(Playing_messages[i].wave) )
+		if ( !message_voice_is_playing(&Playing_messages[i]) )
 			return;
 	}
 
 	// distort the number of voices currently playing
 	for ( i = 0; i < Num_messages_playing; i++ ) {
-		Assert(Playing_messages[i].wave.isValid());
+		Assert(message_has_voice(&Playing_messages[i]));
 
 		was_muted = 0;
 
@@ -2515,10 +2734,10 @@ void message_maybe_distort()
 		
 			if ( Message_wave_muted ) {
 				if ( !was_muted )
-					snd_set_volume(Playing_messages[i].wave, 0.0f, true);
+					message_voice_set_volume(&Playing_messages[i], 0.0f);
 			} else {
 				if ( was_muted )
-					snd_set_volume(Playing_messages[i].wave, (Master_voice_volume * aav_voice_volume), true);
+					message_voice_set_volume(&Playing_messages[i], (Master_voice_volume * aav_voice_volume));
 			}
 		}
 	}
@@ -2627,13 +2846,45 @@ void message_pagein_mission_messages()
 		return;
 	}
 
-	char *sound_filename;
+	// streamed voices are opened when their messages come up
+	if (message_voice_streaming()) {
+		return;
+	}
+
+	// gather the waves first so that they can all be loaded in one batch
+	SCP_vector<int> wave_indices;
 
 	for (i=Num_builtin_messages; i<Num_messages; i++) {
-		if (Messages[i].wave_info.index != -1) {
-			sound_filename = Message_waves[Messages[i].wave_info.index].name;
-			message_load_wave(Messages[i].wave_info.index, sound_filename);
+		int index = Messages[i].wave_info.index;
+		if (index != -1 && !Message_waves[index].num.isValid()
+			&& std::find(wave_indices.begin(), wave_indices.end(), index) == wave_indices.end()) {
+			wave_indices.push_back(index);
+		}
+	}
+
+	if ( !Sound_enabled ) {
+		for (auto index : wave_indices) {
+			message_load_wave(index, Message_waves[index].name);
 		}
+		return;
+	}
+
+	SCP_vector<game_snd_entry> entries(wave_indices.size());
+	SCP_vector<snd_load_request> requests;
+
+	for (size_t j = 0; j < wave_indices.size(); j++) {
+		strcpy_s(entries[j].filename, Message_waves[wave_indices[j]].name);
+		requests.push_back({ &entries[j], nullptr });
+	}
+
+	snd_load_batch(requests);
+
+	for (size_t j = 0; j < wave_indices.size(); j++) {
+		auto& wave = Message_waves[wave_indices[j]];
+		wave.num = entries[j].id;
+
+		if (!wave.num.isValid())
+			nprintf(("messaging", "Cannot load message wave: %s.  Will not play\n", wave.name));
 	}
 }
 
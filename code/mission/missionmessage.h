@@ -206,6 +206,7 @@ typedef struct pmessage {
 	int start_frame;			// the start frame needed to play the animation
 	bool play_anim;			// used to tell HUD gauges if they should be playing or not
 	sound_handle wave;      // handle of wave currently playing
+	int stream;					// audio stream of the wave currently playing if it is streamed, -1 otherwise
 	int id;						// id of message currently playing
 	int priority;				// priority of message currently playing
 	int shipnum;				// shipnum of ship sending this message,  -1 if from Terran command
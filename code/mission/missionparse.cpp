@@ -83,6 +83,7 @@
 #include "starfield/nebula.h"
 #include "starfield/starfield.h"
 #include "weapon/weapon.h"
+#include "tracing/LoadProfiler.h"
 #include "tracing/Monitor.h"
 #include "missionparse.h"
 
@@ -2182,6 +2183,8 @@ void parse_create_docked_object_helper(p_object *pobjp, p_dock_function_info *in
  */
 int parse_create_object(p_object *pobjp, bool standalone_ship)
 {
+	LOAD_PROFILE_PHASE(ObjectCreation);
+
 	object *objp;
 
 	// if this guy is part of a dock group, create the entire group, starting with the leader
@@ -7404,6 +7407,8 @@ void mission_init(mission *pm, bool quick_init)
 // info such as game type, number of players etc. or whether we are importing from a different format.
 bool parse_main(const char *mission_name, int flags)
 {
+	LOAD_PROFILE_PHASE(Parse);
+
 	int i;
 	bool rval;
 
@@ -9563,6 +9568,9 @@ void conv_fix_punctuation()
 
 	// messages
 	conv_fix_punctuation_section(Parse_text, "#Messages", "#Reinforcements", "$Message:", "\n");
+
+	// the text has moved around under the line number index
+	invalidate_line_num_index();
 }
 
 // Goober5000
@@ -39,6 +39,7 @@
 #include "starfield/starfield.h"
 #include "graphics/shadows.h"
 #include "weapon/weapon.h"
+#include "tracing/LoadProfiler.h"
 #include "tracing/tracing.h"
 
 #define MODEL_SDR_FLAG_MODE_CPP
@@ -3275,6 +3276,7 @@ int model_load(const  char* filename, ship_info* sip, ErrorType error_type, bool
 	strcpy_s(Current_filename, filename);
 
 	TRACE_SCOPE(tracing::LoadModelFile);
+	LOAD_PROFILE_PHASE(ModelLoad);
 
 	mprintf(( "Loading model '%s' into slot '%i'\n", filename, num ));
 
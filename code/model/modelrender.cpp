@@ -35,7 +35,9 @@
 #include "ship/ship.h"
 #include "ship/shipfx.h"
 #include "starfield/starfield.h"
+#include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 #include "weapon/weapon.h"
 
 #include <algorithm>
@@ -56,6 +58,13 @@ int model_render_determine_elapsed_time(int objnum, uint64_t flags);
 
 model_batch_buffer TransformBufferHandler;
 
+// draw calls of the last rendered draw list, and how many queued draws were merged into instanced ones
+MONITOR(ModelDrawCalls)
+MONITOR(ModelInstancedDraws)
+
+// how many draws one thread converts into uniforms at a time
+#define MODEL_UNIFORM_CHUNK_SIZE	64
+
 model_render_params::model_render_params() :
 	Model_flags(MR_NORMAL),
 	Debug_flags(0),
@@ -344,6 +353,7 @@ void model_batch_buffer::reset()
 	Submodel_matrices.clear();
 
 	Current_offset = 0;
+	Current_num_models = 0;
 }
 
 void model_batch_buffer::set_num_models(int n_models)
@@ -353,6 +363,7 @@ void model_batch_buffer::set_num_models(int n_models)
 	vm_matrix4_set_identity(&init_mat);
 
 	Current_offset = Submodel_matrices.size();
+	Current_num_models = (size_t) n_models;
 
 	for ( int i = 0; i < n_models; ++i ) {
 		Submodel_matrices.push_back(init_mat);
@@ -369,11 +380,32 @@ void model_batch_buffer::add_matrix(const matrix4 &mat)
 	Submodel_matrices.push_back(mat);
 }
 
+size_t model_batch_buffer::copy_models(size_t offset, size_t n_models)
+{
+	Assertion(offset + n_models <= Submodel_matrices.size(), "Tried to copy transforms which are not in the buffer!");
+
+	auto new_offset = Submodel_matrices.size();
+
+	// reserve first so that the source elements stay valid while appending
+	Submodel_matrices.reserve(new_offset + n_models);
+
+	for ( size_t i = 0; i < n_models; ++i ) {
+		Submodel_matrices.push_back(Submodel_matrices[offset + i]);
+	}
+
+	return new_offset;
+}
+
 size_t model_batch_buffer::get_buffer_offset() const
 {
 	return Current_offset;
 }
 
+size_t model_batch_buffer::get_num_models() const
+{
+	return Current_num_models;
+}
+
 void model_batch_buffer::allocate_memory()
 {
 	auto size = Submodel_matrices.size() * sizeof(matrix4);
@@ -419,12 +451,23 @@ void model_draw_list::reset()
 	Current_scale.xyz.z = 1.0f;
 
 	Render_initialized = false;
+	Num_draw_calls = 0;
 }
 
 void model_draw_list::sort_draws()
 {
-	std::sort(Render_keys.begin(), Render_keys.end(),
-			  [this](const int a, const int b) { return model_draw_list::sort_draw_pair(this, a, b); });
+	Render_sort_items.clear();
+	Render_sort_items.reserve(Render_keys.size());
+
+	for (auto render_index : Render_keys) {
+		Render_sort_items.push_back({Render_elements[render_index].sort_key, render_index});
+	}
+
+	util::radix_sort(Render_sort_items, Render_sort_scratch);
+
+	for (size_t i = 0; i < Render_sort_items.size(); ++i) {
+		Render_keys[i] = Render_sort_items[i].value;
+	}
 }
 
 void model_draw_list::start_model_batch(int n_models)
@@ -504,12 +547,14 @@ void model_draw_list::add_buffer_draw(const model_material *render_material, con
 		draw_data.scale.xyz.z = 1.0f;
 
 		draw_data.transform_buffer_offset = TransformBufferHandler.get_buffer_offset();
+		draw_data.transform_buffer_stride = TransformBufferHandler.get_num_models();
 
 		draw_data.render_material.set_batching(true);
 	} else {
 		draw_data.transform = Transformations.get_transform();
 		draw_data.scale = Current_scale;
 		draw_data.transform_buffer_offset = INVALID_SIZE;
+		draw_data.transform_buffer_stride = 0;
 		draw_data.render_material.set_batching(false);
 	}
 
@@ -520,6 +565,7 @@ void model_draw_list::add_buffer_draw(const model_material *render_material, con
 	draw_data.texi = texi;
 	draw_data.flags = tmap_flags;
 	draw_data.lights = Current_lights_set;
+	draw_data.sort_key = compute_sort_key(draw_data);
 
 	Render_elements.push_back(draw_data);
 	Render_keys.push_back((int) (Render_elements.size() - 1));
@@ -533,7 +579,7 @@ void model_draw_list::render_buffer(const queued_buffer_draw &render_elements)
 	gr_bind_uniform_buffer(uniform_block_type::ModelData, render_elements.uniform_buffer_offset,
 	                       sizeof(graphics::model_uniform_data), _dataBuffer.bufferHandle());
 
-	gr_render_model(const_cast<model_material*>(&render_elements.render_material), const_cast<indexed_vertex_source*>(render_elements.vert_src), const_cast<vertex_buffer*>(render_elements.buffer), render_elements.texi);
+	gr_render_model(const_cast<model_material*>(&render_elements.render_material), const_cast<indexed_vertex_source*>(render_elements.vert_src), const_cast<vertex_buffer*>(render_elements.buffer), render_elements.texi, render_elements.instances);
 }
 
 vec3d model_draw_list::get_view_position() const
@@ -597,6 +643,9 @@ void model_draw_list::init_render(bool sort)
 {
 	if ( sort ) {
 		sort_draws();
+
+		// merging changes the draw order, so only do it when the order doesn't matter anyway
+		merge_instanced_draws();
 	}
 
 	TransformBufferHandler.submit_buffer_data();
@@ -615,17 +664,39 @@ void model_draw_list::render_all(gr_zbuffer_type depth_mode)
 
 	Scene_light_handler.resetLightState();
 
+	Num_draw_calls = 0;
+	int instanced_draws = 0;
+
 	for ( size_t i = 0; i < Render_keys.size(); ++i ) {
 		int render_index = Render_keys[i];
 
 		if ( depth_mode == ZBUFFER_TYPE_DEFAULT || Render_elements[render_index].render_material.get_depth_mode() == depth_mode ) {
 			render_buffer(Render_elements[render_index]);
+
+			++Num_draw_calls;
+
+			if ( Render_elements[render_index].instances > 1 ) {
+				instanced_draws += Render_elements[render_index].instances;
+			}
 		}
 	}
 
+	mon_ModelDrawCalls = (int) Num_draw_calls;
+	mon_ModelInstancedDraws = instanced_draws;
+
 	gr_alpha_mask_set(0, 1.0f);
 }
 
+size_t model_draw_list::get_num_queued_draws() const
+{
+	return Render_elements.size();
+}
+
+size_t model_draw_list::get_num_draw_calls() const
+{
+	return Num_draw_calls;
+}
+
 void model_draw_list::render_arc(const arc_effect &arc)
 {
 	g3_start_instance_matrix(&arc.transform);	
@@ -727,57 +798,218 @@ void model_draw_list::render_outline(const outline_draw &outline_info)
 	g3_done_instance(true);
 }
 
-bool model_draw_list::sort_draw_pair(const model_draw_list* target, const int a, const int b)
+// Packs the state which is expensive to switch between draws into a single key, from most to least significant:
+// shader flags (20 bits), vertex buffer (10 bits), index buffer (10 bits), base texture (16 bits), light set (8 bits).
+// Handles which don't fit are truncated, which can only cost some batching, never correctness.  Unlit draws don't use
+// their lights, so they get no light bits and can still be merged when different lights reach them.
+uint64_t model_draw_list::compute_sort_key(const queued_buffer_draw& draw)
+{
+	auto bits = [](int value, int num_bits) { return static_cast<uint64_t>(static_cast<uint32_t>(value)) & ((UINT64_C(1) << num_bits) - 1); };
+
+	uint64_t key = bits(draw.sdr_flags, 20);
+	key = (key << 10) | bits(draw.vert_src->Vbuffer_handle.value(), 10);
+	key = (key << 10) | bits(draw.vert_src->Ibuffer_handle.value(), 10);
+	key = (key << 16) | bits(draw.render_material.get_texture_map(TM_BASE_TYPE), 16);
+	key = (key << 8) | (draw.render_material.is_lit() ? bits(static_cast<int>(draw.lights.index_start), 8) : 0);
+
+	return key;
+}
+
+// Checks everything that ends up in the render state or the uniforms of a draw, apart from the batched transforms
+static bool model_render_materials_match(const model_material& a, const model_material& b)
 {
-	auto draw_call_a = &target->Render_elements[a];
-	auto draw_call_b = &target->Render_elements[b];
+	for ( int i = 0; i < TM_NUM_TYPES; ++i ) {
+		if ( a.get_texture_map(i) != b.get_texture_map(i) ) {
+			return false;
+		}
+	}
+
+	if ( a.get_texture_type() != b.get_texture_type() || a.get_texture_addressing() != b.get_texture_addressing()
+		|| a.get_depth_mode() != b.get_depth_mode() || a.get_cull_mode() != b.get_cull_mode()
+		|| a.get_fill_mode() != b.get_fill_mode() || a.get_depth_bias() != b.get_depth_bias() ) {
+		return false;
+	}
 
-	if ( draw_call_a->sdr_flags != draw_call_b->sdr_flags ) {
-		return draw_call_a->sdr_flags < draw_call_b->sdr_flags;
+	if ( a.has_buffer_blend_modes() || b.has_buffer_blend_modes() || a.get_blend_mode() != b.get_blend_mode() ) {
+		return false;
 	}
 
-	if ( draw_call_a->vert_src->Vbuffer_handle != draw_call_b->vert_src->Vbuffer_handle ) {
-		return draw_call_a->vert_src->Vbuffer_handle.value() < draw_call_b->vert_src->Vbuffer_handle.value();
+	if ( !vm_vec_equal(a.get_color(), b.get_color()) || !fl_equal(a.get_color_scale(), b.get_color_scale()) ) {
+		return false;
 	}
 
-	if ( draw_call_a->vert_src->Ibuffer_handle != draw_call_b->vert_src->Ibuffer_handle ) {
-		return draw_call_a->vert_src->Ibuffer_handle.value() < draw_call_b->vert_src->Ibuffer_handle.value();
+	const auto& mask_a = a.get_color_mask();
+	const auto& mask_b = b.get_color_mask();
+	if ( mask_a.x != mask_b.x || mask_a.y != mask_b.y || mask_a.z != mask_b.z || mask_a.w != mask_b.w ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_BASE_TYPE) != draw_call_b->render_material.get_texture_map(TM_BASE_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_BASE_TYPE) < draw_call_b->render_material.get_texture_map(TM_BASE_TYPE);
+	// stencil state is rarely used by models, so just don't instance anything that uses it
+	if ( a.is_stencil_enabled() || b.is_stencil_enabled() ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_SPECULAR_TYPE) != draw_call_b->render_material.get_texture_map(TM_SPECULAR_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_SPECULAR_TYPE) < draw_call_b->render_material.get_texture_map(TM_SPECULAR_TYPE);
+	if ( a.is_clipped() != b.is_clipped() ) {
+		return false;
 	}
-	
-	if ( draw_call_a->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) != draw_call_b->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) < draw_call_b->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE);
+
+	if ( a.is_clipped() && (!vm_vec_equal(a.get_clip_plane().normal, b.get_clip_plane().normal)
+		|| !vm_vec_equal(a.get_clip_plane().position, b.get_clip_plane().position)) ) {
+		return false;
+	}
+
+	if ( a.is_desaturated() != b.is_desaturated() || a.is_shadow_casting() != b.is_shadow_casting()
+		|| a.is_shadow_receiving() != b.is_shadow_receiving() || a.is_batched() != b.is_batched()
+		|| a.is_deferred() != b.is_deferred() || a.is_hdr() != b.is_hdr() || a.is_lit() != b.is_lit()
+		|| !fl_equal(a.get_light_factor(), b.get_light_factor()) || a.get_center_alpha() != b.get_center_alpha()
+		|| !fl_equal(a.get_thrust_scale(), b.get_thrust_scale())
+		|| !fl_equal(a.get_outline_thickness(), b.get_outline_thickness()) ) {
+		return false;
+	}
+
+	if ( a.get_animated_effect() != b.get_animated_effect()
+		|| (a.get_animated_effect() >= 0 && !fl_equal(a.get_animated_effect_time(), b.get_animated_effect_time())) ) {
+		return false;
+	}
+
+	if ( a.is_alpha_mult_active() != b.is_alpha_mult_active()
+		|| (a.is_alpha_mult_active() && !fl_equal(a.get_alpha_mult(), b.get_alpha_mult())) ) {
+		return false;
+	}
+
+	if ( a.is_team_color_set() != b.is_team_color_set() ) {
+		return false;
+	}
+
+	if ( a.is_team_color_set() ) {
+		const auto& clr_a = a.get_team_color();
+		const auto& clr_b = b.get_team_color();
+
+		if ( !fl_equal(clr_a.base.r, clr_b.base.r) || !fl_equal(clr_a.base.g, clr_b.base.g) || !fl_equal(clr_a.base.b, clr_b.base.b)
+			|| !fl_equal(clr_a.stripe.r, clr_b.stripe.r) || !fl_equal(clr_a.stripe.g, clr_b.stripe.g) || !fl_equal(clr_a.stripe.b, clr_b.stripe.b) ) {
+			return false;
+		}
+	}
+
+	if ( a.is_fogged() != b.is_fogged() ) {
+		return false;
+	}
+
+	if ( a.is_fogged() ) {
+		const auto& fog_a = a.get_fog();
+		const auto& fog_b = b.get_fog();
+
+		if ( fog_a.r != fog_b.r || fog_a.g != fog_b.g || fog_a.b != fog_b.b
+			|| !fl_equal(fog_a.dist_near, fog_b.dist_near) || !fl_equal(fog_a.dist_far, fog_b.dist_far) ) {
+			return false;
+		}
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_GLOW_TYPE) != draw_call_b->render_material.get_texture_map(TM_GLOW_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_GLOW_TYPE) < draw_call_b->render_material.get_texture_map(TM_GLOW_TYPE);
+	return true;
+}
+
+// Only batched draws can be instanced since their per object transforms live in the transform buffer instead of the
+// uniforms. Shadow map draws are excluded because those already use instancing for the shadow cascades.
+bool model_draw_list::can_instance(const queued_buffer_draw& first, const queued_buffer_draw& other)
+{
+	if ( first.transform_buffer_offset == INVALID_SIZE || other.transform_buffer_offset == INVALID_SIZE ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_NORMAL_TYPE) != draw_call_b->render_material.get_texture_map(TM_NORMAL_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_NORMAL_TYPE) < draw_call_b->render_material.get_texture_map(TM_NORMAL_TYPE);
+	if ( first.render_material.is_shadow_casting() ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_HEIGHT_TYPE) != draw_call_b->render_material.get_texture_map(TM_HEIGHT_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_HEIGHT_TYPE) < draw_call_b->render_material.get_texture_map(TM_HEIGHT_TYPE);
+	if ( first.sort_key != other.sort_key || first.sdr_flags != other.sdr_flags || first.flags != other.flags
+		|| first.vert_src != other.vert_src || first.buffer != other.buffer || first.texi != other.texi
+		|| first.transform_buffer_stride != other.transform_buffer_stride ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_AMBIENT_TYPE) != draw_call_b->render_material.get_texture_map(TM_AMBIENT_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_AMBIENT_TYPE) < draw_call_b->render_material.get_texture_map(TM_AMBIENT_TYPE);
+	if ( !model_render_materials_match(first.render_material, other.render_material) ) {
+		return false;
 	}
 
-	if ( draw_call_a->render_material.get_texture_map(TM_MISC_TYPE) != draw_call_b->render_material.get_texture_map(TM_MISC_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_MISC_TYPE) < draw_call_b->render_material.get_texture_map(TM_MISC_TYPE);
+	// the merged draw is lit with the lights of the first one.  Sets with the same lights are buffered only once, so
+	// comparing where they start compares their lights.
+	return !first.render_material.is_lit()
+		|| (first.lights.index_start == other.lights.index_start && first.lights.num_lights == other.lights.num_lights);
+}
+
+// Merges sorted draws of the same buffer with the same material into one instanced draw. The transforms of the merged
+// draws are laid out back to back in the transform buffer so that the shader can find those of each instance by its
+// instance id.
+void model_draw_list::merge_instanced_draws()
+{
+	size_t num_keys = Render_keys.size();
+	size_t out = 0;
+	size_t run_start = 0;
+
+	while ( run_start < num_keys ) {
+		auto key = Render_elements[Render_keys[run_start]].sort_key;
+
+		// only draws with the same sort key can match and those are next to each other after sorting
+		size_t run_end = run_start + 1;
+		while ( run_end < num_keys && Render_elements[Render_keys[run_end]].sort_key == key ) {
+			++run_end;
+		}
+
+		for ( size_t i = run_start; i < run_end; ++i ) {
+			if ( Render_keys[i] < 0 ) {
+				// already merged into an earlier draw
+				continue;
+			}
+
+			auto& first = Render_elements[Render_keys[i]];
+
+			Render_instance_keys.clear();
+
+			for ( size_t j = i + 1; j < run_end; ++j ) {
+				if ( Render_keys[j] >= 0 && can_instance(first, Render_elements[Render_keys[j]]) ) {
+					Render_instance_keys.push_back(j);
+				}
+			}
+
+			if ( !Render_instance_keys.empty() ) {
+				auto stride = first.transform_buffer_stride;
+
+				// objects rendered one after another already have their transforms next to each other
+				bool contiguous = true;
+				for ( size_t n = 0; n < Render_instance_keys.size(); ++n ) {
+					auto& other = Render_elements[Render_keys[Render_instance_keys[n]]];
+
+					if ( other.transform_buffer_offset != first.transform_buffer_offset + (n + 1) * stride ) {
+						contiguous = false;
+						break;
+					}
+				}
+
+				if ( !contiguous ) {
+					auto new_offset = TransformBufferHandler.copy_models(first.transform_buffer_offset, stride);
+
+					for ( auto instance_key : Render_instance_keys ) {
+						TransformBufferHandler.copy_models(Render_elements[Render_keys[instance_key]].transform_buffer_offset, stride);
+					}
+
+					first.transform_buffer_offset = new_offset;
+				}
+
+				first.instances = (int) Render_instance_keys.size() + 1;
+
+				for ( auto instance_key : Render_instance_keys ) {
+					Render_keys[instance_key] = -1;
+				}
+			}
+
+			Render_keys[out++] = Render_keys[i];
+		}
+
+		run_start = run_end;
 	}
 
-	return draw_call_a->lights.index_start < draw_call_b->lights.index_start;
+	Render_keys.resize(out);
 }
+
 void model_draw_list::build_uniform_buffer() {
 	GR_DEBUG_SCOPE("Build model uniform buffer");
 
@@ -785,26 +1017,56 @@ void model_draw_list::build_uniform_buffer() {
 
 	_dataBuffer = gr_get_uniform_buffer(uniform_block_type::ModelData, Render_keys.size());
 
-	for (auto render_index : Render_keys) {
-		auto& queued_draw = Render_elements[render_index];
+	// Setting lights goes through global state, so capture every distinct light set up front. Draws are sorted by their
+	// light set last, so consecutive draws usually share one.
+	Render_light_uniforms.clear();
+	Render_light_indices.resize(Render_keys.size());
+
+	Scene_light_handler.resetLightState();
+	const light_indexing_info* current_lights = nullptr;
+
+	for (size_t i = 0; i < Render_keys.size(); ++i) {
+		auto& queued_draw = Render_elements[Render_keys[i]];
 
-		// Set lighting here so that it can be captured by the uniform conversion below
-		if ( queued_draw.render_material.is_lit() ) {
+		if ( !queued_draw.render_material.is_lit() ) {
+			Render_light_indices[i] = -1;
+			continue;
+		}
+
+		if ( current_lights == nullptr || current_lights->index_start != queued_draw.lights.index_start || current_lights->num_lights != queued_draw.lights.num_lights ) {
 			Scene_light_handler.setLights(&queued_draw.lights);
-		} else {
 
-			Scene_light_handler.resetLightState();
+			Render_light_uniforms.emplace_back();
+			graphics::uniforms::capture_model_light_uniforms(&Render_light_uniforms.back());
+
+			current_lights = &queued_draw.lights;
 		}
 
-		auto element = _dataBuffer.aligner().addTypedElement<graphics::model_uniform_data>();
-		graphics::uniforms::convert_model_material(element,
-												   queued_draw.render_material,
-												   queued_draw.transform,
-												   queued_draw.scale,
-												   queued_draw.transform_buffer_offset);
-		queued_draw.uniform_buffer_offset = _dataBuffer.getCurrentAlignerOffset();
+		Render_light_indices[i] = static_cast<int>(Render_light_uniforms.size()) - 1;
 	}
 
+	Scene_light_handler.resetLightState();
+
+	// every draw has a fixed slot in the buffer, so the conversion itself can be spread over all cores
+	auto& aligner = _dataBuffer.aligner();
+	aligner.addElements(Render_keys.size());
+
+	threading::parallel_for(Render_keys.size(), MODEL_UNIFORM_CHUNK_SIZE, [this, &aligner](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			auto& queued_draw = Render_elements[Render_keys[i]];
+			auto light_index = Render_light_indices[i];
+
+			graphics::uniforms::convert_model_material(aligner.getTypedElement<graphics::model_uniform_data>(i),
+													   queued_draw.render_material,
+													   queued_draw.transform,
+													   queued_draw.scale,
+													   queued_draw.transform_buffer_offset,
+													   queued_draw.instances > 1 ? queued_draw.transform_buffer_stride : 0,
+													   light_index >= 0 ? &Render_light_uniforms[light_index] : nullptr);
+			queued_draw.uniform_buffer_offset = _dataBuffer.getAlignerElementOffset(i);
+		}
+	});
+
 	TRACE_SCOPE(tracing::UploadModelUniforms);
 
 	_dataBuffer.submitData();
@@ -15,7 +15,9 @@
 #include "math/vecmat.h"
 #include "model/model.h"
 #include "mission/missionparse.h"
+#include "graphics/uniforms.h"
 #include "graphics/util/UniformBuffer.h"
+#include "utils/radix_sort.h"
 
 extern SCP_vector<light> Lights;
 extern int Num_lights;
@@ -190,8 +192,11 @@ struct insignia_draw_data
 struct queued_buffer_draw
 {
 	size_t transform_buffer_offset = 0;
+	size_t transform_buffer_stride = 0;	// number of batched transforms per instance
 	size_t uniform_buffer_offset = 0;
 
+	int instances = 1;	// how many copies of this draw are rendered with a single instanced draw call
+
 	model_material render_material;
 
 	matrix4 transform;
@@ -205,6 +210,8 @@ struct queued_buffer_draw
 
 	light_indexing_info lights;
 
+	uint64_t sort_key;	// packed render state, draws with equal state end up next to each other when sorted by this
+
 	queued_buffer_draw()
 	{
 	}
@@ -226,17 +233,22 @@ class model_batch_buffer
 	size_t Mem_alloc_size;
 
 	size_t Current_offset;
+	size_t Current_num_models;
 
 	void allocate_memory();
 public:
-	model_batch_buffer() : Mem_alloc(NULL), Mem_alloc_size(0), Current_offset(0) {};
+	model_batch_buffer() : Mem_alloc(NULL), Mem_alloc_size(0), Current_offset(0), Current_num_models(0) {};
 
 	void reset();
 
 	size_t get_buffer_offset() const;
+	size_t get_num_models() const;
 	void set_num_models(int n_models);
 	void set_model_transform(const matrix4 &transform, int model_id);
 
+	// appends a copy of n_models transforms starting at offset and returns the offset of the copy
+	size_t copy_models(size_t offset, size_t n_models);
+
 	void submit_buffer_data();
 
 	void add_matrix(const matrix4 &mat);
@@ -258,6 +270,12 @@ class model_draw_list
 	SCP_vector<queued_buffer_draw> Render_elements;
 	SCP_vector<int> Render_keys;
 
+	SCP_vector<util::radix_sort_item> Render_sort_items;
+	SCP_vector<util::radix_sort_item> Render_sort_scratch;
+
+	SCP_vector<graphics::uniforms::model_light_uniforms> Render_light_uniforms;	// one entry per distinct light set, in draw order
+	SCP_vector<int> Render_light_indices;		// for each render key, its entry in Render_light_uniforms or -1 if unlit
+
 	SCP_vector<arc_effect> Arcs;
 	SCP_vector<insignia_draw_data> Insignias;
 	SCP_vector<outline_draw> Outlines;
@@ -265,10 +283,17 @@ class model_draw_list
 	graphics::util::UniformBuffer _dataBuffer;
 
 	bool Render_initialized = false; //!< A flag for checking if init_render has been called before a render_all call
+
+	size_t Num_draw_calls = 0;	//!< Draw calls issued by the last render_all call
+
+	SCP_vector<size_t> Render_instance_keys;	// scratch list of the draws merged into one instanced draw
 	
-	static bool sort_draw_pair(const model_draw_list* target, const int a, const int b);
+	static uint64_t compute_sort_key(const queued_buffer_draw& draw);
 	void sort_draws();
 
+	static bool can_instance(const queued_buffer_draw& first, const queued_buffer_draw& other);
+	void merge_instanced_draws();
+
 	void build_uniform_buffer();
 public:
 	model_draw_list();
@@ -303,6 +328,9 @@ public:
 	void init_render(bool sort = true);
 	void render_all(gr_zbuffer_type depth_mode = ZBUFFER_TYPE_DEFAULT);
 	void reset();
+
+	size_t get_num_queued_draws() const;
+	size_t get_num_draw_calls() const;
 };
 
 void model_render_only_glowpoint_lights(const model_render_params* interp, int model_num, int model_instance_num, const matrix* orient, const vec3d* pos);
@@ -42,6 +42,7 @@
 #include "mission/missiongoals.h"
 #include "network/multi_log.h"
 #include "network/multi_rate.h"
+#include "network/multi_soak.h"
 #include "network/multi_lua.h"
 #include "hud/hudescort.h"
 #include "hud/hudmessage.h"
@@ -201,6 +202,7 @@ void multi_init()
 	
 	// initialize other stuff
 	multi_log_init();
+	multi_soak_init();
 
 	// load up common multiplayer icons
 	if (!Is_standalone)
@@ -978,6 +980,7 @@ void multi_process_bigdata(ubyte *data, int len, net_addr *from_addr, int reliab
 	// check to see if netplayer is null (it may be in cases such as getting lists of games from the tracker)
 	if(player_num >= 0){
 		Net_players[player_num].last_heard_time = timer_get_fixed_seconds();
+		multi_soak_add_bytes_recvd(player_num, len);
 	}
 
 	// store fields that were passed along in the message
@@ -1174,6 +1177,11 @@ void multi_do_frame()
 	// datarate tracking
 	multi_rate_process();
 
+	// server load statistics
+	if (Net_player->flags & NETINFO_FLAG_AM_MASTER) {
+		multi_soak_do_frame();
+	}
+
 	// always process any pending endgame details
 	multi_endgame_process();		
 
@@ -1365,6 +1373,9 @@ void multi_do_frame()
 			multi_mdns_service_do();
 		}
 	}
+
+	// push out everything sent this frame
+	psnet_send_queue_flush();
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -1470,6 +1481,9 @@ void multi_pause_do_frame()
 			multi_mdns_service_do();
 		}
 	}
+
+	// push out everything sent this frame
+	psnet_send_queue_flush();
 }
 
 
@@ -103,9 +103,9 @@ static void multi_log_write_info()
 }
 
 // initialize the multi logfile
-void multi_log_init()
+void multi_log_init(const char *filename)
 {
-	if (logfile_init(LOGFILE_MULTI_LOG)) {
+	if (logfile_init(LOGFILE_MULTI_LOG, filename)) {
 		multi_log_write_header();
 		multi_log_write_info();
 
@@ -24,7 +24,7 @@
 //
 
 // initialize the multi logfile
-void multi_log_init();
+void multi_log_init(const char *filename = nullptr);
 
 // close down the multi logfile
 void multi_log_close();
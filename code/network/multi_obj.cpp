@@ -21,6 +21,7 @@
 #include "network/multi_interpolate.h"
 #include "network/multi_options.h"
 #include "network/multi_rate.h"
+#include "network/multi_soak.h"
 #include "network/multi.h"
 #include "object/object.h"
 #include "object/objcollide.h"		// for multi rollback collisions
@@ -43,10 +44,11 @@ extern const std::uint32_t MAX_TIME;
 constexpr int OO_MAIN_HEADER_SIZE = 9;  // two ints and a ubyte (recall! fix is basically an int)
 
 
-// One frame record per ship with each contained array holding one element for each frame.
+// One fixed-size ring buffer per ship with each contained array holding one element for each frame.
+// Orientations are kept as quaternions to keep the record compact, use the multi_ship_record_*_orientation() helpers to access them.
 struct rollback_ship_position_records {
 	vec3d positions[MAX_FRAMES_RECORDED];							// The recorded ship positions, cur_frame_index is the index.
-	matrix orientations[MAX_FRAMES_RECORDED];						// The recorded ship orientations, cur_frame_index is the index. 
+	vec4 orientations[MAX_FRAMES_RECORDED];							// The recorded ship orientations as quaternions, cur_frame_index is the index. 
 	vec3d velocities[MAX_FRAMES_RECORDED];							// The recorded ship velocities (required for additive velocity shots and auto aim), cur_frame_index is the index.
 	vec3d rotational_velocities[MAX_FRAMES_RECORDED];				// The recorded ship rotational velocities (required for auto aim if certain ), cur_frame_index is the index.
 
@@ -149,6 +151,19 @@ static bool Afterburn_hack = false;			// HACK!!!
 // returns the last frame's index.
 int multi_find_prev_frame_idx();
 
+// store an orientation in the compact form used by the ship records
+static void multi_ship_record_set_orientation(rollback_ship_position_records& record, int frame, const matrix* orient)
+{
+	vm_matrix_to_quaternion(&record.orientations[frame], orient);
+}
+
+// expand a recorded orientation back into a matrix
+static void multi_ship_record_get_orientation(const rollback_ship_position_records& record, int frame, matrix* orient)
+{
+	const vec4& q = record.orientations[frame];
+	vm_quaternion_to_matrix(orient, q.xyzw.x, q.xyzw.y, q.xyzw.z, q.xyzw.w);
+}
+
 // quickly lookup how much time has passed since the given frame.
 int multi_ship_record_get_time_elapsed(int original_frame, int new_frame);
 
@@ -376,7 +391,7 @@ void multi_rollback_ship_record_add_ship(int obj_num)
 		// only add positional info if they are in the mission.
 		Oo_info.frame_info[net_sig_idx].positions[Oo_info.cur_frame_index] = objp->pos;
 		Oo_info.frame_info[net_sig_idx].first_pos = objp->last_pos;
-		Oo_info.frame_info[net_sig_idx].orientations[Oo_info.cur_frame_index] = objp->orient;
+		multi_ship_record_set_orientation(Oo_info.frame_info[net_sig_idx], Oo_info.cur_frame_index, &objp->orient);
 		Oo_info.frame_info[net_sig_idx].velocities[Oo_info.cur_frame_index] = objp->phys_info.vel;
 		Oo_info.frame_info[net_sig_idx].rotational_velocities[Oo_info.cur_frame_index] = objp->phys_info.rotvel;
 	}
@@ -415,7 +430,7 @@ void multi_ship_record_update_all()
 		}
 
 		Oo_info.frame_info[net_sig_idx].positions[Oo_info.cur_frame_index] = objp->pos;
-		Oo_info.frame_info[net_sig_idx].orientations[Oo_info.cur_frame_index] = objp->orient;
+		multi_ship_record_set_orientation(Oo_info.frame_info[net_sig_idx], Oo_info.cur_frame_index, &objp->orient);
 		Oo_info.frame_info[net_sig_idx].velocities[Oo_info.cur_frame_index] = objp->phys_info.vel;
 		Oo_info.frame_info[net_sig_idx].rotational_velocities[Oo_info.cur_frame_index] = objp->phys_info.rotvel;
 
@@ -555,7 +570,38 @@ matrix multi_ship_record_lookup_orientation(object* objp, int frame)
 	if (objp == nullptr) {
 		return vmd_identity_matrix;
 	}
-	return Oo_info.frame_info[objp->net_signature].orientations[frame];
+
+	matrix orient;
+	multi_ship_record_get_orientation(Oo_info.frame_info[objp->net_signature], frame, &orient);
+	return orient;
+}
+
+// Lookup of position and orientation at a time between the given frame and the next one
+void multi_ship_record_interpolate(object* objp, int frame, int time_after_frame, vec3d* pos, matrix* orient)
+{
+	Assertion(objp != nullptr, "nullptr given to multi_ship_record_interpolate. \nThis should be handled earlier in the code, please report!");
+	Assertion(frame >= 0 && frame < MAX_FRAMES_RECORDED, "Invalid frame %d given to multi_ship_record_interpolate, please report!", frame);
+
+	const auto& record = Oo_info.frame_info[objp->net_signature];
+	int next_frame = (frame == MAX_FRAMES_RECORDED - 1) ? 0 : frame + 1;
+
+	int frame_time = multi_ship_record_get_time_elapsed(frame, next_frame);
+
+	// the newest frame has nothing after it to interpolate towards
+	if (frame == Oo_info.cur_frame_index || time_after_frame <= 0 || frame_time <= 0) {
+		*pos = record.positions[frame];
+		multi_ship_record_get_orientation(record, frame, orient);
+		return;
+	}
+
+	float t = static_cast<float>(time_after_frame) / static_cast<float>(frame_time);
+	CLAMP(t, 0.0f, 1.0f);
+
+	vm_vec_linear_interpolate(pos, &record.positions[frame], &record.positions[next_frame], t);
+
+	vec4 q;
+	vm_quaternion_nlerp(&q, &record.orientations[frame], &record.orientations[next_frame], t);
+	vm_quaternion_to_matrix(orient, q.xyzw.x, q.xyzw.y, q.xyzw.z, q.xyzw.w);
 }
 
 // quickly lookup how much time has passed between two frames.
@@ -623,6 +669,164 @@ void multi_ship_record_add_rollback_shot(object* pobjp, vec3d* pos, matrix* orie
 	Oo_info.rollback_shots_to_be_fired[frame].push_back(new_shot);	
 }
 
+static void multi_rollback_bounds_init(rollback_bounds& bounds, const vec3d* pos)
+{
+	bounds.min = *pos;
+	bounds.max = *pos;
+}
+
+static void multi_rollback_bounds_add(rollback_bounds& bounds, const vec3d* pos)
+{
+	bounds.min.xyz.x = MIN(bounds.min.xyz.x, pos->xyz.x);
+	bounds.min.xyz.y = MIN(bounds.min.xyz.y, pos->xyz.y);
+	bounds.min.xyz.z = MIN(bounds.min.xyz.z, pos->xyz.z);
+	bounds.max.xyz.x = MAX(bounds.max.xyz.x, pos->xyz.x);
+	bounds.max.xyz.y = MAX(bounds.max.xyz.y, pos->xyz.y);
+	bounds.max.xyz.z = MAX(bounds.max.xyz.z, pos->xyz.z);
+}
+
+static void multi_rollback_bounds_inflate(rollback_bounds& bounds, float amount)
+{
+	for (int i = 0; i < 3; i++) {
+		bounds.min.a1d[i] -= amount;
+		bounds.max.a1d[i] += amount;
+	}
+}
+
+bool multi_rollback_bounds_overlap(const rollback_bounds& a, const rollback_bounds& b)
+{
+	for (int i = 0; i < 3; i++) {
+		if (a.max.a1d[i] < b.min.a1d[i] || b.max.a1d[i] < a.min.a1d[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// the fastest weapon the shooter could have fired during rollback, or a negative value if it cannot be determined
+static float multi_rollback_max_weapon_speed(object* shooterp)
+{
+	if (shooterp->type != OBJ_SHIP || shooterp->instance < 0) {
+		return -1.0f;
+	}
+
+	ship_weapon* swp = &Ships[shooterp->instance].weapons;
+	float max_speed = 0.0f;
+
+	for (int i = 0; i < swp->num_primary_banks; i++) {
+		if (swp->primary_bank_weapons[i] >= 0) {
+			max_speed = MAX(max_speed, Weapon_info[swp->primary_bank_weapons[i]].max_speed);
+		}
+	}
+
+	for (int i = 0; i < swp->num_secondary_banks; i++) {
+		if (swp->secondary_bank_weapons[i] >= 0) {
+			max_speed = MAX(max_speed, Weapon_info[swp->secondary_bank_weapons[i]].max_speed);
+		}
+	}
+
+	return max_speed;
+}
+
+// How long a shot fired in start_frame can travel until the end of the frame after cur_frame, in seconds
+float multi_rollback_shot_travel_time(const TIMESTAMP* timestamps, int start_frame, int cur_frame, float frametime)
+{
+	// before the buffer has wrapped around, frames that were not recorded yet have no timestamp
+	if (!timestamps[start_frame].isFinite() || !timestamps[cur_frame].isFinite()) {
+		return -1.0f;
+	}
+
+	int elapsed = timestamp_get_delta(timestamps[start_frame], timestamps[cur_frame]);
+
+	// add one frame of slack, since weapons are pushed forward by the frame they are simulated in.  The last recorded
+	// frame interval is the best guess for it, or the frametime if there is no earlier frame yet.
+	int prev_frame = (cur_frame == 0) ? MAX_FRAMES_RECORDED - 1 : cur_frame - 1;
+	int slack = 0;
+	if (timestamps[prev_frame].isFinite()) {
+		slack = timestamp_get_delta(timestamps[prev_frame], timestamps[cur_frame]);
+	}
+	if (slack <= 0) {
+		slack = fl2i(frametime * TIMESTAMP_FREQUENCY);
+	}
+
+	if (elapsed < 0 || slack <= 0) {
+		return -1.0f;
+	}
+
+	return static_cast<float>(elapsed + slack) / static_cast<float>(TIMESTAMP_FREQUENCY);
+}
+
+// A box around everywhere a shot fired from pos along fvec could be after travel_time seconds
+void multi_rollback_shot_bounds(const vec3d* pos, const vec3d* fvec, float speed, float shooter_radius, float travel_time, rollback_bounds& bounds)
+{
+	float reach = speed * travel_time;
+
+	vec3d end_pos;
+	vm_vec_scale_add(&end_pos, pos, fvec, reach);
+
+	multi_rollback_bounds_init(bounds, pos);
+	multi_rollback_bounds_add(bounds, &end_pos);
+
+	// weapons leave from the gun points, and can be fired at an angle
+	multi_rollback_bounds_inflate(bounds, shooter_radius + (reach * 0.5f));
+}
+
+// Builds one box for every rollback shot covering everywhere the shot could travel before the current frame.
+// Returns false if a shot cannot be bounded, in which case every ship has to take part in rollback.
+static bool multi_rollback_build_shot_bounds(int start_frame, SCP_vector<rollback_bounds>& shot_bounds)
+{
+	int frame_idx = start_frame;
+
+	do {
+		if (!Oo_info.rollback_shots_to_be_fired[frame_idx].empty()) {
+			float travel_time = multi_rollback_shot_travel_time(Oo_info.timestamps, frame_idx, Oo_info.cur_frame_index, flFrametime);
+
+			for (auto& shot : Oo_info.rollback_shots_to_be_fired[frame_idx]) {
+				float speed = multi_rollback_max_weapon_speed(shot.shooterp);
+
+				if (speed < 0.0f || travel_time <= 0.0f) {
+					return false;
+				}
+
+				speed += vm_vec_mag(&shot.shooterp->phys_info.vel);
+
+				rollback_bounds bounds;
+				multi_rollback_shot_bounds(&shot.pos, &shot.orient.vec.fvec, speed, shot.shooterp->radius, travel_time, bounds);
+				shot_bounds.push_back(bounds);
+			}
+		}
+
+		frame_idx = (frame_idx == MAX_FRAMES_RECORDED - 1) ? 0 : frame_idx + 1;
+	} while (frame_idx != Oo_info.cur_frame_index);
+
+	return true;
+}
+
+// Builds a box around everywhere the ship was recorded between the starting frame and the current frame.
+static void multi_rollback_build_ship_bounds(object* objp, int start_frame, rollback_bounds& bounds)
+{
+	const auto& record = Oo_info.frame_info[objp->net_signature];
+
+	// collision detection also looks at the sweep from last_pos, so the frame before the start counts too
+	int prev_frame = (start_frame == 0) ? MAX_FRAMES_RECORDED - 1 : start_frame - 1;
+	multi_rollback_bounds_init(bounds, (prev_frame == Oo_info.cur_frame_index) ? &record.first_pos : &record.positions[prev_frame]);
+
+	int frame_idx = start_frame;
+
+	while (true) {
+		multi_rollback_bounds_add(bounds, &record.positions[frame_idx]);
+
+		if (frame_idx == Oo_info.cur_frame_index) {
+			break;
+		}
+
+		frame_idx = (frame_idx == MAX_FRAMES_RECORDED - 1) ? 0 : frame_idx + 1;
+	}
+
+	multi_rollback_bounds_inflate(bounds, objp->radius);
+}
+
 // Manage rollback for a frame
 void multi_ship_record_do_rollback() 
 {	
@@ -631,6 +835,40 @@ void multi_ship_record_do_rollback()
 		return;
 	}
 
+	// first we need to figure out which frame will start the rollback simulation
+	int frame_idx = Oo_info.cur_frame_index + 1;
+
+	if (frame_idx >= MAX_FRAMES_RECORDED) {
+		frame_idx = 0;
+	}
+
+	// loop through them
+	while (frame_idx != Oo_info.cur_frame_index) {
+
+		if (!Oo_info.rollback_shots_to_be_fired[frame_idx].empty()) {
+			break;
+		}
+
+		frame_idx++;
+
+		if (frame_idx >= MAX_FRAMES_RECORDED) {
+			frame_idx = 0;
+		}
+	}
+
+	// make sure we found one.
+	Assertion(frame_idx != Oo_info.cur_frame_index, "Rollback was called without there being a rollback shot to simulate. This is a coder error. Please report!");
+
+	if (frame_idx == Oo_info.cur_frame_index) {
+		Oo_info.rollback_mode = false;
+		Oo_info.rollback_shots_to_be_fired[frame_idx].clear();
+		return;
+	}
+
+	// only ships that are somewhere a shot can reach need to be moved back in time
+	SCP_vector<rollback_bounds> shot_bounds;
+	bool cull_ships = multi_rollback_build_shot_bounds(frame_idx, shot_bounds);
+
 	int net_sig_idx;
 	object* objp;
 
@@ -661,7 +899,41 @@ void multi_ship_record_do_rollback()
 			continue;
 		}
 
-		Oo_info.rollback_ships.push_back(cur_ship.objnum);
+		bool in_range = !cull_ships;
+
+		if (cull_ships) {
+			rollback_bounds ship_bounds;
+			multi_rollback_build_ship_bounds(objp, frame_idx, ship_bounds);
+
+			for (auto& bounds : shot_bounds) {
+				if (multi_rollback_bounds_overlap(ship_bounds, bounds)) {
+					in_range = true;
+					break;
+				}
+			}
+		}
+
+		// shooters get moved to their firing positions, so they always need to be restored
+		bool shooter = false;
+
+		if (!in_range) {
+			for (auto& shots : Oo_info.rollback_shots_to_be_fired) {
+				for (auto& shot : shots) {
+					if (shot.shooterp == objp) {
+						shooter = true;
+						break;
+					}
+				}
+
+				if (shooter) {
+					break;
+				}
+			}
+
+			if (!shooter) {
+				continue;
+			}
+		}
 
 		rollback_restore_record restore_point;
 
@@ -673,37 +945,15 @@ void multi_ship_record_do_rollback()
 		restore_point.rotational_velocity = objp->phys_info.rotvel;
 
 		Oo_info.restore_points.push_back(restore_point);
-		// Also take this opportunity to set up their collision 
-		Oo_info.rollback_collide_list.push_back(cur_ship.objnum);
-	}
 
-	// now we need to figure out which frame will start the rollback simulation
-	int frame_idx = Oo_info.cur_frame_index + 1;
-
-	if (frame_idx >= MAX_FRAMES_RECORDED) {
-		frame_idx = 0;
-	}
-
-	// loop through them
-	while (frame_idx != Oo_info.cur_frame_index) {
-
-		if (!Oo_info.rollback_shots_to_be_fired[frame_idx].empty()) {
-			break;
-		}
-
-		frame_idx++;
-
-		if (frame_idx >= MAX_FRAMES_RECORDED) {
-			frame_idx = 0;
+		if (in_range) {
+			Oo_info.rollback_ships.push_back(cur_ship.objnum);
+			// Also take this opportunity to set up their collision 
+			Oo_info.rollback_collide_list.push_back(cur_ship.objnum);
 		}
 	}
 
-	// make sure we found one.
-	Assertion(frame_idx != Oo_info.cur_frame_index, "Rollback was called without there being a rollback shot to simulate. This is a coder error. Please report!");
-
-	if (frame_idx == Oo_info.cur_frame_index) {
-		return;
-	}
+	multi_soak_add_rollback(static_cast<int>(Oo_info.rollback_ships.size()));
 
 	nprintf(("Network","At least one multiplayer rollback shot is being simulated this frame.\n"));
 
@@ -781,7 +1031,7 @@ void multi_oo_restore_frame(int frame_idx)
 		object* objp = &Objects[objnum];
 		Assertion(objp != nullptr, "Nullptr somehow got into the rollback ship vector, please report!");
 		objp->pos = Oo_info.frame_info[objp->net_signature].positions[frame_idx];
-		objp->orient = Oo_info.frame_info[objp->net_signature].orientations[frame_idx];
+		multi_ship_record_get_orientation(Oo_info.frame_info[objp->net_signature], frame_idx, &objp->orient);
 		objp->phys_info.vel = Oo_info.frame_info[objp->net_signature].velocities[frame_idx];
 		objp->phys_info.rotvel = Oo_info.frame_info[objp->net_signature].rotational_velocities[frame_idx];
 
@@ -918,10 +1168,15 @@ void multi_ship_record_signal_update(int objnum, TIMESTAMP lower_time_limit, TIM
 
 	// now that we have valid values, we need to fix the affected values in the record.
 	do {
+		matrix orient;
+		multi_ship_record_get_orientation(*info, prev_index, &orient);
+
 		Interp_info[objnum].reinterpolate_previous(
 			Oo_info.timestamps[prev_index], prev_packet_index, current_packet_index,  
-			info->positions[prev_index], info->orientations[prev_index], info->velocities[prev_index], info->rotational_velocities[prev_index]
+			info->positions[prev_index], orient, info->velocities[prev_index], info->rotational_velocities[prev_index]
 			);
+
+		multi_ship_record_set_orientation(*info, prev_index, &orient);
 		++prev_index;
 
 		if (prev_index == MAX_FRAMES_RECORDED) {
@@ -2676,7 +2931,7 @@ void multi_init_oo_and_ship_tracker()
 	oo_netplayer_records temp_netplayer_records;
 
 	for (int i = 0; i < MAX_FRAMES_RECORDED; i++) {
-		temp_position_records.orientations[i] = vmd_identity_matrix;
+		multi_ship_record_set_orientation(temp_position_records, i, &vmd_identity_matrix);
 		temp_position_records.positions[i] = vmd_zero_vector;
 		temp_position_records.velocities[i] = vmd_zero_vector;
 		temp_position_records.rotational_velocities[i] = vmd_zero_vector;
@@ -81,6 +81,24 @@ vec3d multi_ship_record_lookup_position(object* objp, int frame);
 // a quick lookups for orientation
 matrix multi_ship_record_lookup_orientation(object* objp, int frame);
 
+// lookup of position and orientation time_after_frame ms after the given frame, interpolated towards the next frame
+void multi_ship_record_interpolate(object* objp, int frame, int time_after_frame, vec3d* pos, matrix* orient);
+
+// axis aligned box used to cull ships that no rollback shot can reach
+struct rollback_bounds {
+	vec3d min;
+	vec3d max;
+};
+
+// how long a shot fired in start_frame can travel until the end of the frame after cur_frame, in seconds, given the
+// recorded frame timestamps, or a negative value if that is not known.  frametime is used if there is no earlier frame.
+float multi_rollback_shot_travel_time(const TIMESTAMP* timestamps, int start_frame, int cur_frame, float frametime);
+
+// a box around everywhere a shot fired from pos along fvec could be after travel_time seconds
+void multi_rollback_shot_bounds(const vec3d* pos, const vec3d* fvec, float speed, float shooter_radius, float travel_time, rollback_bounds& bounds);
+
+bool multi_rollback_bounds_overlap(const rollback_bounds& a, const rollback_bounds& b);
+
 // figures out how much time has passed bwetween the two frames.
 int multi_ship_record_find_time_after_frame(int client_frame, int frame, int time_elapsed);
 
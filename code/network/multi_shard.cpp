@@ -0,0 +1,435 @@
+#include "network/multi_shard.h"
+#include "cmdline/cmdline.h"
+#include "globalincs/systemvars.h"
+#include "network/multi_log.h"
+#include "network/multi_options.h"
+#include "network/psnet2.h"
+#include "network/stand_gui.h"
+#include "osapi/osapi.h"
+#include "osapi/outwnd.h"
+#include "parse/generic_log.h"
+#include "parse/parselo.h"
+#include "utils/Random.h"
+#include "utils/threading.h"
+
+#ifdef SCP_UNIX
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <SDL.h>
+#endif
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SHARD DEFINES/VARS
+//
+
+#ifdef SCP_UNIX
+
+#define MULTI_SHARD_SOCKET_NAME			"standalone_control.sock"
+#define MULTI_SHARD_POLL_TIMEOUT		250			// ms to wait for control traffic before reaping workers again
+#define MULTI_SHARD_MAX_CLIENTS			8			// simultaneous control connections
+#define MULTI_SHARD_MAX_LINE			256			// longest command accepted
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL					0			// SIGPIPE is ignored by the supervisor instead
+#endif
+
+typedef struct shard_worker {
+	pid_t pid;				// 0 if the slot is free
+	ushort port;
+	ushort webapi_port;
+} shard_worker;
+
+typedef struct shard_client {
+	int fd;
+	SCP_string buffer;		// incomplete command line read so far
+} shard_client;
+
+static SCP_vector<shard_worker> Multi_shard_workers;
+static SCP_vector<shard_client> Multi_shard_clients;
+
+static int Multi_shard_listen_fd = -1;
+static SCP_string Multi_shard_socket_path;
+
+static ushort Multi_shard_base_port = 0;
+static ushort Multi_shard_base_webapi_port = 0;
+
+static volatile sig_atomic_t Multi_shard_quit = 0;
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SHARD FUNCTIONS
+//
+
+static void multi_shard_signal_handler(int  /*sig*/)
+{
+	Multi_shard_quit = 1;
+}
+
+static void multi_shard_reply(int fd, const SCP_string &msg)
+{
+	// control clients may go away at any time, don't let that kill the supervisor
+	send(fd, msg.c_str(), msg.size(), MSG_NOSIGNAL);
+}
+
+static SCP_string multi_shard_worker_string(size_t slot)
+{
+	const auto &worker = Multi_shard_workers[slot];
+
+	SCP_string out;
+	sprintf(out, "%d %d %d %d\n", static_cast<int>(slot), static_cast<int>(worker.pid), worker.port, worker.webapi_port);
+
+	return out;
+}
+
+static bool multi_shard_open_socket()
+{
+	Multi_shard_socket_path = os_get_config_path(MULTI_SHARD_SOCKET_NAME);
+
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+
+	if (Multi_shard_socket_path.size() >= sizeof(addr.sun_path)) {
+		ml_printf("SHARD => Control socket path '%s' is too long!", Multi_shard_socket_path.c_str());
+		return false;
+	}
+
+	strcpy_s(addr.sun_path, Multi_shard_socket_path.c_str());
+
+	Multi_shard_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (Multi_shard_listen_fd < 0) {
+		ml_printf("SHARD => Unable to create control socket: %s", strerror(errno));
+		return false;
+	}
+
+	// a previous supervisor may have left its socket behind
+	unlink(Multi_shard_socket_path.c_str());
+
+	if ( bind(Multi_shard_listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) || listen(Multi_shard_listen_fd, MULTI_SHARD_MAX_CLIENTS) ) {
+		ml_printf("SHARD => Unable to listen on control socket '%s': %s", Multi_shard_socket_path.c_str(), strerror(errno));
+		close(Multi_shard_listen_fd);
+		Multi_shard_listen_fd = -1;
+		return false;
+	}
+
+	ml_printf("SHARD => Listening for commands on '%s'", Multi_shard_socket_path.c_str());
+
+	return true;
+}
+
+static void multi_shard_close_socket()
+{
+	for (auto &client : Multi_shard_clients) {
+		close(client.fd);
+	}
+
+	Multi_shard_clients.clear();
+
+	if (Multi_shard_listen_fd >= 0) {
+		close(Multi_shard_listen_fd);
+		Multi_shard_listen_fd = -1;
+	}
+}
+
+// sets up a freshly forked worker to host a game in the given slot
+static void multi_shard_init_worker(size_t slot)
+{
+	// the control connections belong to the supervisor
+	for (auto &client : Multi_shard_clients) {
+		close(client.fd);
+	}
+
+	Multi_shard_clients.clear();
+
+	close(Multi_shard_listen_fd);
+	Multi_shard_listen_fd = -1;
+
+	signal(SIGTERM, SIG_DFL);
+	signal(SIGINT, SIG_DFL);
+	signal(SIGPIPE, SIG_DFL);
+
+	// the inherited logs are the supervisor's files, every worker writes its own
+	SCP_string log_name;
+
+	if (LoggingEnabled) {
+		sprintf(log_name, "fs2_standalone_shard%d.log", static_cast<int>(slot));
+		outwnd_reopen(log_name.c_str());
+	}
+
+	sprintf(log_name, "multi_shard%d.log", static_cast<int>(slot));
+	logfile_close(LOGFILE_MULTI_LOG);
+	multi_log_init(log_name.c_str());
+
+	// otherwise every worker would share the supervisor's random sequence
+	Random::seed(static_cast<unsigned int>(time(nullptr)) ^ static_cast<unsigned int>(getpid()));
+
+	// the supervisor forks with SDL and the task pool shut down, so the worker starts them cleanly here
+	SDL_InitSubSystem(SDL_INIT_EVENTS);
+	threading::init_task_pool();
+
+	Multi_options_g.port = Multi_shard_workers[slot].port;
+	Multi_options_g.webapiPort = Multi_shard_workers[slot].webapi_port;
+
+	psnet_init(Multi_options_g.port);
+	std_configLoaded(&Multi_options_g);
+
+	ml_printf("SHARD => Worker %d hosting on port %d", static_cast<int>(slot), Multi_options_g.port);
+}
+
+// returns true in the new worker process
+static bool multi_shard_spawn(int fd)
+{
+	size_t slot;
+
+	for (slot = 0; slot < Multi_shard_workers.size(); slot++) {
+		if (Multi_shard_workers[slot].pid == 0) {
+			break;
+		}
+	}
+
+	if (slot == Multi_shard_workers.size()) {
+		multi_shard_reply(fd, "error no free slots\n");
+		return false;
+	}
+
+	auto &worker = Multi_shard_workers[slot];
+
+	worker.port = static_cast<ushort>(Multi_shard_base_port + slot + 1);
+	worker.webapi_port = static_cast<ushort>(Multi_shard_base_webapi_port + slot + 1);
+
+	// fork() only copies the calling thread, so a lock held by any other thread would stay locked in the worker
+	Assertion(threading::get_num_workers() == 0, "The shard supervisor must not fork while the task pool is running!");
+
+	// anything still buffered would be written once by the supervisor and once more by the worker
+	fflush(nullptr);
+
+	pid_t pid = fork();
+
+	if (pid < 0) {
+		ml_printf("SHARD => Unable to fork worker: %s", strerror(errno));
+		multi_shard_reply(fd, "error fork failed\n");
+		return false;
+	}
+
+	if (pid == 0) {
+		multi_shard_init_worker(slot);
+		return true;
+	}
+
+	worker.pid = pid;
+
+	ml_printf("SHARD => Started worker %d (pid %d) on port %d", static_cast<int>(slot), static_cast<int>(pid), worker.port);
+
+	multi_shard_reply(fd, "ok " + multi_shard_worker_string(slot));
+
+	return false;
+}
+
+static void multi_shard_stop(int fd, const char *arg)
+{
+	char *end = nullptr;
+	long slot = strtol(arg, &end, 10);
+
+	if ( (end == arg) || (slot < 0) || (slot >= static_cast<long>(Multi_shard_workers.size())) || (Multi_shard_workers[slot].pid == 0) ) {
+		multi_shard_reply(fd, "error invalid slot\n");
+		return;
+	}
+
+	kill(Multi_shard_workers[slot].pid, SIGTERM);
+
+	multi_shard_reply(fd, "ok\n");
+}
+
+// returns true in the new worker process
+static bool multi_shard_process_command(int fd, const SCP_string &line)
+{
+	if (line == "spawn") {
+		return multi_shard_spawn(fd);
+	}
+
+	if (line == "list") {
+		for (size_t slot = 0; slot < Multi_shard_workers.size(); slot++) {
+			if (Multi_shard_workers[slot].pid != 0) {
+				multi_shard_reply(fd, multi_shard_worker_string(slot));
+			}
+		}
+
+		multi_shard_reply(fd, "end\n");
+	} else if ( !strncmp(line.c_str(), "stop ", 5) ) {
+		multi_shard_stop(fd, line.c_str() + 5);
+	} else if (line == "quit") {
+		Multi_shard_quit = 1;
+		multi_shard_reply(fd, "ok\n");
+	} else {
+		multi_shard_reply(fd, "error unknown command\n");
+	}
+
+	return false;
+}
+
+// returns true in the new worker process
+static bool multi_shard_read_client(size_t idx)
+{
+	char buf[MULTI_SHARD_MAX_LINE];
+	ssize_t len = recv(Multi_shard_clients[idx].fd, buf, sizeof(buf), 0);
+
+	if (len <= 0) {
+		close(Multi_shard_clients[idx].fd);
+		Multi_shard_clients.erase(Multi_shard_clients.begin() + idx);
+		return false;
+	}
+
+	Multi_shard_clients[idx].buffer.append(buf, static_cast<size_t>(len));
+
+	size_t eol;
+
+	while ( (eol = Multi_shard_clients[idx].buffer.find('\n')) != SCP_string::npos ) {
+		SCP_string line = Multi_shard_clients[idx].buffer.substr(0, eol);
+		Multi_shard_clients[idx].buffer.erase(0, eol + 1);
+
+		drop_trailing_white_space(line);
+
+		if ( multi_shard_process_command(Multi_shard_clients[idx].fd, line) ) {
+			return true;
+		}
+	}
+
+	if (Multi_shard_clients[idx].buffer.size() > MULTI_SHARD_MAX_LINE) {
+		multi_shard_reply(Multi_shard_clients[idx].fd, "error line too long\n");
+		Multi_shard_clients[idx].buffer.clear();
+	}
+
+	return false;
+}
+
+static void multi_shard_reap_workers()
+{
+	int status;
+	pid_t pid;
+
+	while ( (pid = waitpid(-1, &status, WNOHANG)) > 0 ) {
+		for (size_t slot = 0; slot < Multi_shard_workers.size(); slot++) {
+			if (Multi_shard_workers[slot].pid == pid) {
+				ml_printf("SHARD => Worker %d (pid %d) exited with status %d", static_cast<int>(slot), static_cast<int>(pid), status);
+				Multi_shard_workers[slot].pid = 0;
+				break;
+			}
+		}
+	}
+}
+
+static void multi_shard_stop_all_workers()
+{
+	for (auto &worker : Multi_shard_workers) {
+		if (worker.pid != 0) {
+			kill(worker.pid, SIGTERM);
+		}
+	}
+
+	for (auto &worker : Multi_shard_workers) {
+		if (worker.pid != 0) {
+			waitpid(worker.pid, nullptr, 0);
+			worker.pid = 0;
+		}
+	}
+}
+
+bool multi_shard_run()
+{
+	if ( !Is_standalone || (Cmdline_standalone_shards <= 0) ) {
+		return true;
+	}
+
+	Multi_shard_base_port = Multi_options_g.port;
+	Multi_shard_base_webapi_port = Multi_options_g.webapiPort;
+
+	Multi_shard_workers.clear();
+	Multi_shard_workers.resize(static_cast<size_t>(Cmdline_standalone_shards), shard_worker{0, 0, 0});
+
+	if ( !multi_shard_open_socket() ) {
+		return false;
+	}
+
+	// the supervisor does not host a game itself, so it gives up the game and webapi ports and stops everything
+	// which runs threads before any worker is forked
+	psnet_close();
+	std_deinit_standalone();
+	threading::shut_down_task_pool();
+	SDL_QuitSubSystem(SDL_INIT_EVENTS);
+
+	signal(SIGTERM, multi_shard_signal_handler);
+	signal(SIGINT, multi_shard_signal_handler);
+	signal(SIGPIPE, SIG_IGN);
+
+	ml_printf("SHARD => Supervisor running with up to %d games", Cmdline_standalone_shards);
+
+	while ( !Multi_shard_quit ) {
+		SCP_vector<pollfd> fds;
+
+		fds.push_back({Multi_shard_listen_fd, POLLIN, 0});
+
+		for (auto &client : Multi_shard_clients) {
+			fds.push_back({client.fd, POLLIN, 0});
+		}
+
+		int rval = poll(fds.data(), fds.size(), MULTI_SHARD_POLL_TIMEOUT);
+
+		multi_shard_reap_workers();
+
+		if (rval <= 0) {
+			continue;
+		}
+
+		if ( fds[0].revents & POLLIN ) {
+			int fd = accept(Multi_shard_listen_fd, nullptr, nullptr);
+
+			if (fd >= 0) {
+				if (Multi_shard_clients.size() < MULTI_SHARD_MAX_CLIENTS) {
+					Multi_shard_clients.push_back({fd, SCP_string()});
+				} else {
+					multi_shard_reply(fd, "error too many connections\n");
+					close(fd);
+				}
+			}
+		}
+
+		// go backwards since clients can be removed as they are processed
+		for (size_t idx = fds.size() - 1; idx > 0; idx--) {
+			if ( !(fds[idx].revents & (POLLIN | POLLHUP | POLLERR)) ) {
+				continue;
+			}
+
+			if ( multi_shard_read_client(idx - 1) ) {
+				return true;
+			}
+		}
+	}
+
+	ml_printf("SHARD => Supervisor shutting down");
+
+	multi_shard_stop_all_workers();
+	multi_shard_close_socket();
+	unlink(Multi_shard_socket_path.c_str());
+
+	return false;
+}
+
+#else
+
+bool multi_shard_run()
+{
+	if ( Is_standalone && (Cmdline_standalone_shards > 0) ) {
+		ml_string("SHARD => -standalone_shards is not supported on this platform, running a single game");
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _MULTI_SHARD_HEADER_FILE
+#define _MULTI_SHARD_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SHARDED STANDALONE
+//
+// Lets one standalone server process host several games.  Enabled with -standalone_shards <max games> (Unix only).
+// The process loads all tables once and then becomes a supervisor which forks one worker process per game.  Workers
+// share the already parsed data with the supervisor copy-on-write, so starting a game skips table loading entirely.
+//
+// The supervisor is controlled through a local socket, standalone_control.sock in the config directory, which accepts
+// one command per line:
+//
+//   spawn          start a new game, replies "ok <slot> <pid> <port> <webapi port>"
+//   list           one line per running game in the same format, followed by "end"
+//   stop <slot>    terminate the game in the given slot
+//   quit           terminate all games and the supervisor
+//
+// Game slot n listens on the configured game and webapi ports plus n + 1.
+// Its debug and multi logs are written to fs2_standalone_shard<n>.log and multi_shard<n>.log.
+//
+
+// Runs the supervisor if enabled on the command line.  Must be called after game_init().
+// Returns true if the caller should go on to run a game, either because sharding is disabled or because this is a
+// freshly forked worker.  Returns false in the supervisor once it has been told to quit.
+bool multi_shard_run();
+
+#endif
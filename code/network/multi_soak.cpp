@@ -0,0 +1,183 @@
+#include "network/multi_soak.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "io/timer.h"
+#include "network/multi.h"
+#include "network/multiutil.h"
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SOAK REPORT DEFINES/VARS
+//
+
+#define MULTI_SOAK_REPORT_FILE			"soak_report.csv"
+#define MULTI_SOAK_REPORT_INTERVAL		1000			// ms between report lines
+
+typedef struct soak_player_stats {
+	int bytes_sent;
+	int bytes_recvd;
+} soak_player_stats;
+
+static CFILE *Multi_soak_file = nullptr;
+
+static soak_player_stats Multi_soak_players[MAX_PLAYERS];
+
+static int Multi_soak_start_time = 0;
+static int Multi_soak_report_time = 0;
+static std::uint64_t Multi_soak_last_frame = 0;
+
+// stats for the current report interval
+static int Multi_soak_frames = 0;
+static std::uint64_t Multi_soak_frametime_total = 0;
+static std::uint64_t Multi_soak_frametime_max = 0;
+static int Multi_soak_rollbacks = 0;
+static int Multi_soak_rollback_ships = 0;
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SOAK REPORT FUNCTIONS
+//
+
+static void multi_soak_reset_interval()
+{
+	memset(Multi_soak_players, 0, sizeof(Multi_soak_players));
+
+	Multi_soak_frames = 0;
+	Multi_soak_frametime_total = 0;
+	Multi_soak_frametime_max = 0;
+	Multi_soak_rollbacks = 0;
+	Multi_soak_rollback_ships = 0;
+}
+
+static void multi_soak_write_line(int interval_ms)
+{
+	int num_clients = 0;
+	int bytes_sent = 0;
+	int bytes_recvd = 0;
+	int max_bytes_sent = 0;
+
+	for (int idx = 0; idx < MAX_PLAYERS; idx++) {
+		if ( !MULTI_CONNECTED(Net_players[idx]) || (&Net_players[idx] == Net_player) ) {
+			continue;
+		}
+
+		num_clients++;
+		bytes_sent += Multi_soak_players[idx].bytes_sent;
+		bytes_recvd += Multi_soak_players[idx].bytes_recvd;
+		max_bytes_sent = MAX(max_bytes_sent, Multi_soak_players[idx].bytes_sent);
+	}
+
+	const float seconds = i2fl(interval_ms) / 1000.0f;
+	const float clients = i2fl(MAX(num_clients, 1));
+	const float frametime_avg = (Multi_soak_frames > 0) ? (static_cast<float>(Multi_soak_frametime_total) / Multi_soak_frames) / 1000.0f : 0.0f;
+
+	char line[512];
+	snprintf(line, sizeof(line), "%.3f,%d,%d,%d,%.3f,%.3f,%.1f,%.1f,%.1f,%d,%d\n",
+		i2fl(timer_get_milliseconds() - Multi_soak_start_time) / 1000.0f,
+		num_clients,
+		(Game_mode & GM_IN_MISSION) ? 1 : 0,
+		Multi_soak_frames,
+		frametime_avg,
+		static_cast<float>(Multi_soak_frametime_max) / 1000.0f,
+		(bytes_sent / clients) / seconds,
+		(bytes_recvd / clients) / seconds,
+		max_bytes_sent / seconds,
+		Multi_soak_rollbacks,
+		Multi_soak_rollback_ships);
+
+	cfputs(line, Multi_soak_file);
+	cflush(Multi_soak_file);
+}
+
+// open the report file, if enabled on the command line
+void multi_soak_init()
+{
+	if ( !Cmdline_soak_report || (Multi_soak_file != nullptr) ) {
+		return;
+	}
+
+	Multi_soak_file = cfopen(MULTI_SOAK_REPORT_FILE, "wt", CF_TYPE_DATA);
+
+	if (Multi_soak_file == nullptr) {
+		mprintf(("MULTI SOAK: Unable to open %s for writing!\n", MULTI_SOAK_REPORT_FILE));
+		return;
+	}
+
+	cfputs("time,clients,in_mission,frames,frametime_avg_ms,frametime_max_ms,bytes_sent_per_client,bytes_recvd_per_client,bytes_sent_max_client,rollbacks,rollback_ships\n", Multi_soak_file);
+
+	multi_soak_reset_interval();
+
+	Multi_soak_start_time = timer_get_milliseconds();
+	Multi_soak_report_time = Multi_soak_start_time;
+	Multi_soak_last_frame = 0;
+}
+
+// close the report file
+void multi_soak_close()
+{
+	if (Multi_soak_file == nullptr) {
+		return;
+	}
+
+	cfclose(Multi_soak_file);
+	Multi_soak_file = nullptr;
+}
+
+// account for data sent to a player
+void multi_soak_add_bytes_sent(int np_index, int size)
+{
+	if ( (Multi_soak_file == nullptr) || (np_index < 0) || (np_index >= MAX_PLAYERS) ) {
+		return;
+	}
+
+	Multi_soak_players[np_index].bytes_sent += size;
+}
+
+// account for data received from a player
+void multi_soak_add_bytes_recvd(int np_index, int size)
+{
+	if ( (Multi_soak_file == nullptr) || (np_index < 0) || (np_index >= MAX_PLAYERS) ) {
+		return;
+	}
+
+	Multi_soak_players[np_index].bytes_recvd += size;
+}
+
+// account for a rollback that restored the given number of ships
+void multi_soak_add_rollback(int num_ships)
+{
+	if (Multi_soak_file == nullptr) {
+		return;
+	}
+
+	Multi_soak_rollbacks++;
+	Multi_soak_rollback_ships += num_ships;
+}
+
+// call once per server frame
+void multi_soak_do_frame()
+{
+	if (Multi_soak_file == nullptr) {
+		return;
+	}
+
+	// frame time is measured between calls so that it covers the entire server frame
+	auto now = timer_get_microseconds();
+
+	if (Multi_soak_last_frame > 0) {
+		auto frametime = now - Multi_soak_last_frame;
+
+		Multi_soak_frames++;
+		Multi_soak_frametime_total += frametime;
+		Multi_soak_frametime_max = MAX(Multi_soak_frametime_max, frametime);
+	}
+
+	Multi_soak_last_frame = now;
+
+	int interval = timer_get_milliseconds() - Multi_soak_report_time;
+
+	if (interval >= MULTI_SOAK_REPORT_INTERVAL) {
+		multi_soak_write_line(interval);
+		multi_soak_reset_interval();
+
+		Multi_soak_report_time += interval;
+	}
+}
@@ -0,0 +1,31 @@
+#ifndef _MULTI_SOAK_HEADER_FILE
+#define _MULTI_SOAK_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// -----------------------------------------------------------------------------------------------------------------------
+// MULTI SOAK REPORT
+//
+// Server side load statistics for soak testing a server with many clients (see scripts/multi_soak_test.sh).  Enabled
+// with -soak_report.  Once a second a line is written to soak_report.csv in the data directory with the number of
+// connected players, server frame times, the average data rate to and from each client and the number of rollbacks
+// done for lag compensated primary fire.
+//
+
+// open the report file, if enabled on the command line
+void multi_soak_init();
+
+// close the report file
+void multi_soak_close();
+
+// account for data sent to or received from a player
+void multi_soak_add_bytes_sent(int np_index, int size);
+void multi_soak_add_bytes_recvd(int np_index, int size);
+
+// account for a rollback that restored the given number of ships
+void multi_soak_add_rollback(int num_ships);
+
+// call once per server frame
+void multi_soak_do_frame();
+
+#endif
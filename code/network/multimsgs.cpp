@@ -7965,8 +7965,9 @@ void process_non_homing_fired_packet(ubyte* data, header* hinfo)
 		int time_after_frame = multi_ship_record_find_time_after_frame(client_frame, frame, static_cast<int>(time_elapsed));
 		Assertion(time_after_frame >= 0, "Primary fire packet processor found an invalid time_after_frame of %d", time_after_frame);
 
-		vec3d new_tar_pos = multi_ship_record_lookup_position(objp_ref, frame);
-		matrix new_tar_ori = multi_ship_record_lookup_orientation(objp_ref, frame);
+		vec3d new_tar_pos;
+		matrix new_tar_ori;
+		multi_ship_record_interpolate(objp_ref, frame, time_after_frame, &new_tar_pos, &new_tar_ori);
 		// find out where the angle to the new primary fire should be, by
 		// rotating the vector
 
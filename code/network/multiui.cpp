@@ -3331,6 +3331,7 @@ int Multi_create_list_mode;											// 0 == mission mode, 1 == campaign mode
 int Multi_create_list_start;											// where to start displaying from
 int Multi_create_list_select;											// which item is currently highlighted
 int Multi_create_files_loaded;
+int Multi_create_autolaunch = 0;										// the host autoloaded the mission, so it also launches it
 
 SCP_vector<multi_create_info> Multi_create_mission_list;
 SCP_vector<multi_create_info> Multi_create_campaign_list;
@@ -3664,7 +3665,7 @@ void multi_create_game_do(bool API_Access)
 	//DTP CHECK ALMISSION FLAG HERE AND SKIP THE BITMAP LOADING PROGRESS 
 	//SINCE WE ALREADY HAVE A MISSION SELECTED IF THIS MISSION IS A VALID MULTIPLAYER MISSION
 	//IF NOT A VALID MULTIPLAYER MISSION CONTINUE LOADING, MAYBE CALL POPUP.
-	if ((Cmdline_almission) && (Net_player->flags & NETINFO_FLAG_AM_MASTER)) {	//
+	if ((Cmdline_almission) && (Net_player->flags & NETINFO_FLAG_AM_MASTER) && (multi_num_players() >= Cmdline_almission_players)) {	//
 		multi_create_list_do(); //uhm here because off, hehe, my mind is failing right now
 
 		// DTP Var section for the is mission multi player Check.
@@ -3702,6 +3703,30 @@ void multi_create_game_do(bool API_Access)
 		
 		}
 	}
+
+	// the host of a standalone server has no mission list of its own, so it picks the mission from the one the server
+	// sent and commits it just like the accept button does
+	if ((Cmdline_almission) && (Net_player->flags & NETINFO_FLAG_GAME_HOST) && !(Net_player->flags & NETINFO_FLAG_AM_MASTER)
+		&& !Multi_create_mission_list.empty() && (multi_num_players() >= Cmdline_almission_players) && multi_netplayer_state_check(NETPLAYER_STATE_JOINED, 1)) {
+		auto filename = cf_add_ext(Cmdline_almission, FS_MISSION_FILE_EXT);
+		Cmdline_almission = nullptr;
+
+		int select_index = -1;
+		for (size_t idx = 0; idx < Multi_create_mission_list.size(); idx++) {
+			if (!stricmp(Multi_create_mission_list[idx].filename, filename)) {
+				select_index = static_cast<int>(idx);
+				break;
+			}
+		}
+
+		if (select_index >= 0) {
+			multi_create_list_set_item(select_index, MULTI_CREATE_SHOW_MISSIONS);
+			multi_create_accept_hit(MULTI_CREATE_SHOW_MISSIONS, select_index);
+			Multi_create_autolaunch = 1;
+		} else {
+			mprintf(("Unable to autoload %s, the server does not list it as a multiplayer mission\n", filename));
+		}
+	}
 	
 	int player_index;
 	const char *loading_str = XSTR("Loading", 1336);
@@ -8310,6 +8335,12 @@ void multi_sync_post_do(bool API_Access)
 		// create the launch button so the host can click
 		if( Sync_test && multi_netplayer_state_check(NETPLAYER_STATE_SETTINGS_ACK) ){
 			multi_sync_create_launch_button();
+
+			// an autoloaded mission doesn't wait for anyone to click it
+			if (Multi_create_autolaunch) {
+				Multi_create_autolaunch = 0;
+				multi_sync_start_countdown();
+			}
 		}
 	}
 
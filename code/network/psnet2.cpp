@@ -37,6 +37,7 @@
 #include "io/timer.h"
 #include "network/multi_log.h"
 #include "network/multi_rate.h"
+#include "network/multi_soak.h"
 #include "cmdline/cmdline.h"
 
 // -------------------------------------------------------------------------------------------------------
@@ -96,6 +97,38 @@ typedef struct network_packet_buffer_list {
 
 #pragma pack(pop)
 
+// Linux can move many datagrams per syscall with recvmmsg()/sendmmsg(), so unreliable traffic
+// is read in batches and outgoing unreliable packets are queued and flushed once per frame
+#ifdef __linux__
+#define PSNET_BATCHED_IO
+#endif
+
+#ifdef PSNET_BATCHED_IO
+#define PSNET_BATCH_SIZE		64			// max number of packets moved per recvmmsg()/sendmmsg() call
+
+/**
+ * Pooled packet slot used by the batched read/write path.  The data is already in wire format
+ * (psnet type ident + payload), so no additional copy is needed to hand it to the kernel.
+ */
+typedef struct psnet_batch_packet {
+	SOCKADDR_IN6	addr;
+	ubyte			data[MAX_TOP_LAYER_PACKET_SIZE];
+} psnet_batch_packet;
+
+typedef struct psnet_batch {
+	psnet_batch_packet	packets[PSNET_BATCH_SIZE];
+	mmsghdr				msgs[PSNET_BATCH_SIZE];
+	iovec				iov[PSNET_BATCH_SIZE];
+	int					count;
+} psnet_batch;
+
+static psnet_batch Psnet_recv_batch;
+static psnet_batch Psnet_send_batch;		// outgoing unreliable packets queued this frame
+
+// cleared if the kernel doesn't support the batched calls, in which case we use the regular path
+static bool Psnet_batched_io = false;
+#endif
+
 
 #define MAX_RECEIVE_BUFSIZE	4096	// 32 K, eh?
 #define MAX_SEND_RETRIES		20			// number of retries when sending would block
@@ -235,6 +268,16 @@ static void psnet_addr_to_sockaddr(const net_addr *addr, SOCKADDR_IN6 *sockaddr)
 // debugging / testing
 static void psnet_debug_bad_packet(const int packet_type, const uint8_t *packet_data, const SSIZE_T read_len, const SOCKADDR_IN6 *from_addr);
 
+// sort a packet read off of our socket into the proper top layer buffer
+static void psnet_top_layer_buffer_packet(const uint8_t *packet_data, const SSIZE_T read_len, const SOCKADDR_IN6 *from_addr);
+
+#ifdef PSNET_BATCHED_IO
+// batched socket i/o
+static void psnet_batch_init(psnet_batch *batch);
+static bool psnet_batch_read();
+static void psnet_batch_send_fallback(int start);
+#endif
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 TOP LAYER FUNCTIONS - these functions simply buffer and store packets based upon type (see PSNET_TYPE_* defines)
 //
@@ -358,6 +401,15 @@ void PSNET_TOP_LAYER_PROCESS()
 		return;
 	}
 
+	// get anything still queued from the last frame out the door first
+	psnet_send_queue_flush();
+
+#ifdef PSNET_BATCHED_IO
+	if (Psnet_batched_io && psnet_batch_read()) {
+		return;
+	}
+#endif
+
 	// clear the addresses to remove compiler warnings
 	memset(&from_addr, 0, sizeof(from_addr));
 
@@ -393,16 +445,24 @@ void PSNET_TOP_LAYER_PROCESS()
 			break;
 		}
 
-		// determine the packet type
-		int packet_type = packet_data[0];
+		psnet_top_layer_buffer_packet(packet_data, read_len, &from_addr);
+	}
+}
 
-		if ( (packet_type >= 0) && (packet_type < PSNET_NUM_TYPES) ) {
-			// buffer the packet
-			psnet_buffer_packet(&Psnet_top_buffers[packet_type], packet_data + 1, read_len - 1, &from_addr);
-		} else {
-			// got something that's definitely not from a psnet client, so dump it
-			psnet_debug_bad_packet(packet_type, packet_data, from_len, &from_addr);
-		}
+/**
+ * Sort a packet read off of our socket into the proper top layer buffer
+ */
+static void psnet_top_layer_buffer_packet(const uint8_t *packet_data, const SSIZE_T read_len, const SOCKADDR_IN6 *from_addr)
+{
+	// determine the packet type
+	int packet_type = packet_data[0];
+
+	if ( (packet_type >= 0) && (packet_type < PSNET_NUM_TYPES) ) {
+		// buffer the packet
+		psnet_buffer_packet(&Psnet_top_buffers[packet_type], packet_data + 1, read_len - 1, from_addr);
+	} else {
+		// got something that's definitely not from a psnet client, so dump it
+		psnet_debug_bad_packet(packet_type, packet_data, read_len, from_addr);
 	}
 }
 
@@ -458,6 +518,12 @@ void psnet_init(uint16_t port_num)
 
 	psnet_init_rel_tcp();
 
+#ifdef PSNET_BATCHED_IO
+	psnet_batch_init(&Psnet_recv_batch);
+	psnet_batch_init(&Psnet_send_batch);
+	Psnet_batched_io = true;
+#endif
+
 	Psnet_active = true;
 
 	// specified network timeout
@@ -479,6 +545,9 @@ void psnet_close()
 		return;
 	}
 
+	// send off anything still sitting in the outgoing queue
+	psnet_send_queue_flush();
+
 	// close down all reliable sockets - this forces them to
 	// send a disconnect to any remote machines
 	psnet_rel_close();
@@ -809,6 +878,32 @@ int psnet_send(net_addr *who_to_addr, void *data, int len, int np_index)	// NOLI
 		return 0;
 	}
 
+#ifdef PSNET_BATCHED_IO
+	// queue it up in wire format, the whole queue goes out with a single sendmmsg() per frame
+	if (Psnet_batched_io) {
+		Assert(len < MAX_TOP_LAYER_PACKET_SIZE);
+
+		if (Psnet_send_batch.count >= PSNET_BATCH_SIZE) {
+			psnet_send_queue_flush();
+		}
+
+		const int slot = Psnet_send_batch.count++;
+		psnet_batch_packet *packet = &Psnet_send_batch.packets[slot];
+
+		packet->data[0] = PSNET_TYPE_UNRELIABLE;
+		memcpy(&packet->data[1], data, static_cast<size_t>(len));
+		memcpy(&packet->addr, &who_to, sizeof(who_to));
+
+		Psnet_send_batch.iov[slot].iov_len = static_cast<size_t>(len + 1);
+
+		multi_rate_add(np_index, "udp(h)", len + UDP_HEADER_SIZE);
+		multi_rate_add(np_index, "udp", len);
+		multi_soak_add_bytes_sent(np_index, len);
+
+		return 1;
+	}
+#endif
+
 	FD_ZERO(&wfds);
 	FD_SET(Psnet_socket, &wfds);
 
@@ -827,6 +922,7 @@ int psnet_send(net_addr *who_to_addr, void *data, int len, int np_index)	// NOLI
 
 	multi_rate_add(np_index, "udp(h)", len + UDP_HEADER_SIZE);
 	multi_rate_add(np_index, "udp", len);
+	multi_soak_add_bytes_sent(np_index, len);
 
 	ret = SENDTO(Psnet_socket, reinterpret_cast<char *>(data), len, 0,
 				 reinterpret_cast<LPSOCKADDR>(&who_to), sizeof(who_to),
@@ -839,6 +935,50 @@ int psnet_send(net_addr *who_to_addr, void *data, int len, int np_index)	// NOLI
 	return 0;
 }
 
+/**
+ * Send everything in the outgoing unreliable queue
+ */
+void psnet_send_queue_flush()
+{
+#ifdef PSNET_BATCHED_IO
+	int sent = 0;
+
+	if ( !Psnet_active ) {
+		Psnet_send_batch.count = 0;
+		return;
+	}
+
+	while (sent < Psnet_send_batch.count) {
+		int ret = sendmmsg(Psnet_socket, &Psnet_send_batch.msgs[sent], static_cast<unsigned int>(Psnet_send_batch.count - sent), MSG_DONTWAIT);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			if (errno == ENOSYS) {
+				ml_string("Batched socket writes not supported, falling back to sendto()");
+				Psnet_batched_io = false;
+				psnet_batch_send_fallback(sent);
+			} else {
+				// same as the regular path when the socket isn't writable, the packets are dropped
+				ml_printf("Error %d on batched socket write, dropping %d packets", errno, Psnet_send_batch.count - sent);
+			}
+
+			break;
+		}
+
+		if (ret == 0) {
+			break;
+		}
+
+		sent += ret;
+	}
+
+	Psnet_send_batch.count = 0;
+#endif
+}
+
 /**
  * Get data from the unreliable socket
  */
@@ -1450,6 +1590,7 @@ int psnet_rel_send(PSNET_SOCKET_RELIABLE socketid, ubyte *data, int length, int
 
 			if (send_this_packet) {
 				multi_rate_add(np_index, "tcp(h)", RELIABLE_PACKET_HEADER_ONLY_SIZE+rsocket->send_len[i]);
+				multi_soak_add_bytes_sent(np_index, rsocket->send_len[i]);
 
 				bytesout = SENDTO(Psnet_socket, reinterpret_cast<char *>(&send_header),
 								  static_cast<int>(RELIABLE_PACKET_HEADER_ONLY_SIZE) + rsocket->send_len[i], 0,
@@ -2271,6 +2412,96 @@ int psnet_buffer_get_next(network_packet_buffer_list *l, ubyte *data, SSIZE_T *l
 	return 1;
 }
 
+#ifdef PSNET_BATCHED_IO
+// ------------------------------------------------------------------------------------------------------
+// BATCHED SOCKET I/O FUNCTIONS
+//
+
+/**
+ * Point each message header at its pooled packet slot
+ */
+static void psnet_batch_init(psnet_batch *batch)
+{
+	memset(batch, 0, sizeof(psnet_batch));
+
+	for (int idx = 0; idx < PSNET_BATCH_SIZE; idx++) {
+		batch->iov[idx].iov_base = batch->packets[idx].data;
+		batch->iov[idx].iov_len = sizeof(batch->packets[idx].data);
+
+		batch->msgs[idx].msg_hdr.msg_name = &batch->packets[idx].addr;
+		batch->msgs[idx].msg_hdr.msg_namelen = sizeof(batch->packets[idx].addr);
+		batch->msgs[idx].msg_hdr.msg_iov = &batch->iov[idx];
+		batch->msgs[idx].msg_hdr.msg_iovlen = 1;
+	}
+
+	batch->count = 0;
+}
+
+/**
+ * Read everything off of our socket, PSNET_BATCH_SIZE packets per call
+ *
+ * @return false if batched reads aren't available and the regular path should be used
+ */
+static bool psnet_batch_read()
+{
+	psnet_batch *batch = &Psnet_recv_batch;
+
+	while (true) {
+		// the kernel overwrites these with the actual sizes
+		for (int idx = 0; idx < PSNET_BATCH_SIZE; idx++) {
+			batch->msgs[idx].msg_hdr.msg_namelen = sizeof(batch->packets[idx].addr);
+			batch->msgs[idx].msg_hdr.msg_flags = 0;
+		}
+
+		int count = recvmmsg(Psnet_socket, batch->msgs, PSNET_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			if (errno == ENOSYS) {
+				ml_string("Batched socket reads not supported, falling back to recvfrom()");
+				Psnet_batched_io = false;
+				return false;
+			}
+
+			if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) ) {
+				ml_string("Socket error on socket_get_data()");
+			}
+
+			return true;
+		}
+
+		for (int idx = 0; idx < count; idx++) {
+			const SSIZE_T read_len = static_cast<SSIZE_T>(batch->msgs[idx].msg_len);
+
+			if (read_len <= 0) {
+				continue;
+			}
+
+			psnet_top_layer_buffer_packet(batch->packets[idx].data, read_len, &batch->packets[idx].addr);
+		}
+
+		// a short batch means the socket has been drained
+		if (count < PSNET_BATCH_SIZE) {
+			return true;
+		}
+	}
+}
+
+/**
+ * Send queued packets one at a time, starting at the given queue slot
+ */
+static void psnet_batch_send_fallback(int start)
+{
+	for (int idx = start; idx < Psnet_send_batch.count; idx++) {
+		sendto(Psnet_socket, reinterpret_cast<char *>(Psnet_send_batch.packets[idx].data), Psnet_send_batch.iov[idx].iov_len, 0,
+			   reinterpret_cast<LPSOCKADDR>(&Psnet_send_batch.packets[idx].addr), sizeof(Psnet_send_batch.packets[idx].addr));
+	}
+}
+#endif
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 FORWARD DEFINITIONS
 //
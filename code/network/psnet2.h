@@ -157,6 +157,9 @@ bool psnet_is_local_addr(const net_addr *addr);
 // send data unreliably
 int psnet_send(net_addr *who_to, void *data, int len, int np_index = -1);
 
+// send everything queued by psnet_send() (only queued on platforms with batched socket i/o)
+void psnet_send_queue_flush();
+
 // get data from the unreliable socket
 int psnet_get(void *data, net_addr *from_addr);
 
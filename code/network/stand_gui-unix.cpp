@@ -698,6 +698,7 @@ void webapi_shutdown() {
     if (webserverContext) {
         mprintf(("Webapi shutting down\n"));
         mg_stop(webserverContext);
+        webserverContext = NULL;
     }
 }
 
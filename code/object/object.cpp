@@ -10,6 +10,7 @@
 
 
 
+#include "ai/ai.h"
 #include "asteroid/asteroid.h"
 #include "cmeasure/cmeasure.h"
 #include "debris/debris.h"
@@ -829,6 +830,11 @@ void obj_merge_created_list(void)
 	// creates object pairs for it, and then adds it to the used list.
 	//	OLD WAY: list_merge( &obj_used_list, &obj_create_list );
 	object *objp = GET_FIRST(&obj_create_list);
+
+	// homing weapons have to be able to find the new objects
+	if (objp != END_OF_LIST(&obj_create_list))
+		weapon_invalidate_homing_candidates();
+
 	while( objp !=END_OF_LIST(&obj_create_list) )	{
 		list_remove( obj_create_list, objp );
 
@@ -1585,6 +1591,11 @@ void obj_move_all(float frametime)
 
 	obj_merge_created_list();
 
+	// search for enemies for all ships at once before the serial AI below
+	if (!(Game_mode & GM_MULTIPLAYER) || MULTIPLAYER_MASTER) {
+		ai_think_frame();
+	}
+
 	// Clear the table that tells which groups of weapons have cast light so far.
 	if(!(Game_mode & GM_MULTIPLAYER) || (MULTIPLAYER_MASTER)) {
 		obj_clear_weapon_group_id_list();
@@ -0,0 +1,132 @@
+#include "object/objectgrid.h"
+
+#include "math/vecmat.h"
+
+// ----------------------------------------------------------------------------------------------
+// OBJECT GRID FUNCTIONS
+//
+
+object_grid::object_grid(float cell_size)
+	: Cell_size(cell_size), Max_cell_bound(0.0f)
+{
+	Assertion(cell_size > 0.0f, "The object grid needs a positive cell size!");
+}
+
+void object_grid::clear()
+{
+	Entries.clear();
+	Cells.clear();
+	Cell_lookup.clear();
+	Oversized.clear();
+	Max_cell_bound = 0.0f;
+}
+
+int object_grid::cell_coord(float value) const
+{
+	return static_cast<int>(floorf(value / Cell_size));
+}
+
+std::int64_t object_grid::cell_key(int x, int y, int z)
+{
+	// cells more than a million cells out share keys with closer ones, add() deals with that
+	return ((static_cast<std::int64_t>(x) & 0x1fffff) << 42) | ((static_cast<std::int64_t>(y) & 0x1fffff) << 21) | (static_cast<std::int64_t>(z) & 0x1fffff);
+}
+
+void object_grid::add(int objnum, const vec3d *pos, float bound)
+{
+	int idx = static_cast<int>(Entries.size());
+	Entries.push_back({ objnum, *pos, MAX(bound, 0.0f) });
+
+	if (bound > Cell_size) {
+		Oversized.push_back(idx);
+		return;
+	}
+
+	int x = cell_coord(pos->xyz.x);
+	int y = cell_coord(pos->xyz.y);
+	int z = cell_coord(pos->xyz.z);
+
+	auto it = Cell_lookup.find(cell_key(x, y, z));
+	if (it == Cell_lookup.end()) {
+		it = Cell_lookup.emplace(cell_key(x, y, z), static_cast<int>(Cells.size())).first;
+		Cells.push_back({ x, y, z, {} });
+	}
+
+	auto &cell = Cells[it->second];
+	if (cell.x != x || cell.y != y || cell.z != z) {
+		// so far out that the key is taken by another cell, so just check it every time
+		Oversized.push_back(idx);
+		return;
+	}
+	cell.entries.push_back(idx);
+
+	Max_cell_bound = MAX(Max_cell_bound, bound);
+}
+
+bool object_grid::entry_in_sphere(int idx, const vec3d *center, float radius) const
+{
+	const auto &entry = Entries[idx];
+	float reach = radius + entry.bound;
+
+	// a little extra so that rounding never loses an object the caller's own test would have found
+	reach += 0.01f + reach * 0.0001f;
+
+	return vm_vec_dist_squared(center, &entry.pos) <= reach * reach;
+}
+
+void object_grid::query_sphere(const vec3d *center, float radius, SCP_vector<int> &out) const
+{
+	Found.clear();
+
+	for (int idx : Oversized) {
+		if (entry_in_sphere(idx, center, radius)) {
+			Found.push_back(idx);
+		}
+	}
+
+	// every cell that could hold the center of an object reaching into the sphere
+	float reach = radius + Max_cell_bound;
+	int min_x = cell_coord(center->xyz.x - reach), max_x = cell_coord(center->xyz.x + reach);
+	int min_y = cell_coord(center->xyz.y - reach), max_y = cell_coord(center->xyz.y + reach);
+	int min_z = cell_coord(center->xyz.z - reach), max_z = cell_coord(center->xyz.z + reach);
+
+	auto check_cell = [&](const grid_cell &cell) {
+		for (int idx : cell.entries) {
+			if (entry_in_sphere(idx, center, radius)) {
+				Found.push_back(idx);
+			}
+		}
+	};
+
+	// look up the cells one by one unless there are fewer occupied cells than that
+	double num_box_cells = static_cast<double>(max_x - min_x + 1) * (max_y - min_y + 1) * (max_z - min_z + 1);
+
+	if (num_box_cells <= static_cast<double>(Cells.size())) {
+		for (int x = min_x; x <= max_x; ++x) {
+			for (int y = min_y; y <= max_y; ++y) {
+				for (int z = min_z; z <= max_z; ++z) {
+					auto it = Cell_lookup.find(cell_key(x, y, z));
+					if (it != Cell_lookup.end()) {
+						const auto &cell = Cells[it->second];
+						// skip cells sharing the key of a far away one
+						if (cell.x == x && cell.y == y && cell.z == z) {
+							check_cell(cell);
+						}
+					}
+				}
+			}
+		}
+	} else {
+		for (const auto &cell : Cells) {
+			if (cell.x >= min_x && cell.x <= max_x && cell.y >= min_y && cell.y <= max_y && cell.z >= min_z && cell.z <= max_z) {
+				check_cell(cell);
+			}
+		}
+	}
+
+	std::sort(Found.begin(), Found.end());
+
+	for (int idx : Found) {
+		out.push_back(Entries[idx].objnum);
+	}
+}
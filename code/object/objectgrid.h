@@ -0,0 +1,63 @@
+#ifndef _OBJECT_GRID_HEADER_FILE
+#define _OBJECT_GRID_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// ----------------------------------------------------------------------------------------------
+// OBJECT GRID
+//
+// A spatial hash of objects for answering "what could be within this distance of a point" without walking all of
+// obj_used_list.  Every object is added with a bounding sphere around its position which holds everything of it a
+// query cares about.  Objects are sorted into cubic cells by their position, except for the ones too large for a cell,
+// which are kept aside and checked by every query.  Queries return the objects in the order they were added, so code
+// that used to walk obj_used_list sees them in the same order as before.
+//
+// The grid does not follow the objects, so it is only valid for as long as nothing moves.
+//
+
+class object_grid
+{
+public:
+	explicit object_grid(float cell_size);
+
+	// forget all objects
+	void clear();
+
+	// adds an object whose relevant parts all lie within bound of pos
+	void add(int objnum, const vec3d *pos, float bound);
+
+	// appends to out every object whose bounding sphere comes within radius of center, in the order they were added
+	void query_sphere(const vec3d *center, float radius, SCP_vector<int> &out) const;
+
+	size_t size() const { return Entries.size(); }
+	size_t num_cells() const { return Cells.size(); }
+
+private:
+	typedef struct grid_entry {
+		int objnum;
+		vec3d pos;
+		float bound;
+	} grid_entry;
+
+	typedef struct grid_cell {
+		int x, y, z;
+		SCP_vector<int> entries;		// indexes into Entries, in the order they were added
+	} grid_cell;
+
+	int cell_coord(float value) const;
+	static std::int64_t cell_key(int x, int y, int z);
+
+	bool entry_in_sphere(int idx, const vec3d *center, float radius) const;
+
+	float Cell_size;
+	float Max_cell_bound;		// largest bound of an object sorted into a cell
+
+	SCP_vector<grid_entry> Entries;
+	SCP_vector<grid_cell> Cells;
+	SCP_unordered_map<std::int64_t, int> Cell_lookup;
+	SCP_vector<int> Oversized;
+
+	mutable SCP_vector<int> Found;
+};
+
+#endif
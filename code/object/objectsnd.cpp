@@ -38,7 +38,7 @@ typedef struct _obj_snd {
 	int		objnum;			// object index of object that contains this sound
 	gamesnd_id	id;				// Index into Snds[] array
 	sound_handle instance;      // handle of currently playing sound (a ds3d handle if USES_DS3D flag set)
-	int		next_update;	// timestamp that marks next allowed vol/pan change
+	UI_TIMESTAMP	next_update;	// timestamp that marks next allowed vol/pan change
 	float		vol;				// volume of sound (range: 0.0 -> 1.0)
 	float		pan;				// pan of sound (range: -1.0 -> 1.0)
 	int		freq;				// valid range: 100 -> 100000 Hz
@@ -49,6 +49,10 @@ typedef struct _obj_snd {
 
 #define SPEED_SOUND				600.0f				// speed of sound in FreeSpace
 
+// sounds farther away than this fraction of their audible range are updated less often
+#define OBJ_SND_FAR_FRACTION		0.5f
+#define OBJ_SND_FAR_UPDATE_TIME		100					// in ms
+
 static int MAX_OBJ_SOUNDS_PLAYING = -1; // initialized in obj_snd_level_init()
 static int Num_obj_sounds_playing;
 
@@ -60,8 +64,22 @@ obj_snd	Objsnds[MAX_OBJ_SNDS];
 
 int		Obj_snd_enabled = TRUE;
 UI_TIMESTAMP	Obj_snd_last_update;							// timer used to run object sound updates at fixed time intervals
+
+// the time that object sound updates are scheduled by, see obj_snd_set_clock()
+static obj_snd_clock_func Obj_snd_clock = nullptr;
 int		Obj_snd_level_inited=0;
 
+// kept around so that obj_snd_do_frame() does not allocate
+static SCP_vector<obj_snd_voice> Obj_snd_playing;
+static SCP_vector<obj_snd_voice> Obj_snd_candidates;
+static SCP_vector<obj_snd_voice> Obj_snd_stopped;
+static SCP_vector<obj_snd_voice> Obj_snd_started;
+
+static UI_TIMESTAMP obj_snd_now()
+{
+	return (Obj_snd_clock != nullptr) ? Obj_snd_clock() : ui_timestamp();
+}
+
 // ship flyby data
 constexpr int FLYBY_MIN_DISTANCE       = 90;
 constexpr int FLYBY_MIN_RELATIVE_SPEED = 100;
@@ -212,7 +230,7 @@ void obj_snd_level_init()
 	Flyby_next_sound = TIMESTAMP::immediate();
 	Flyby_next_repeat = TIMESTAMP::immediate();
 	Flyby_last_objp = NULL;
-	Obj_snd_last_update = ui_timestamp();
+	Obj_snd_last_update = obj_snd_now();
 
 	if ( !snd_is_inited() ) {
 		Obj_snd_enabled = FALSE;
@@ -314,49 +332,49 @@ void obj_snd_stop_all()
 	}
 }
 
-/**
- * Stop a playing object sound, if it is quieter than sound at new_distance
- *
- * @param new_vol Volume of requested sound to play
- *
- * @return true A sound was stopped
- * @return false A sound was not stopped
- */
-bool obj_snd_stop_lowest_vol(float new_vol)
+// ---------------------------------------------------------------------------------------
+// obj_snd_select_voices()
+//
+// Decide which sounds get to play when no more than max_voices may play at once.  Candidates
+// are started loudest first.  Once all voices are taken, the quietest playing sound is stopped
+// if a candidate is louder, which is found through a heap instead of searching all sounds for
+// every candidate.
+//
+// parameters:  playing		=> sounds that are playing, left holding the ones that keep playing
+//              candidates	=> sounds that want to start, sorted by this function
+//              max_voices	=> number of sounds that may play at once
+//              stopped		=> sounds in playing that have to be stopped are added to this
+//              started		=> candidates that should be started are added to this
+//
+void obj_snd_select_voices(SCP_vector<obj_snd_voice> &playing, SCP_vector<obj_snd_voice> &candidates, size_t max_voices,
+	SCP_vector<obj_snd_voice> &stopped, SCP_vector<obj_snd_voice> &started)
 {
-	obj_snd			*osp;
-	object			*objp = NULL;
-	obj_snd			*lowest_vol_osp = NULL;
-	float				lowest_vol;
-	int obj_snd_index = -1;
-	
-	lowest_vol = 1000.0f;
-	for ( osp = GET_FIRST(&obj_snd_list); osp !=END_OF_LIST(&obj_snd_list); osp = GET_NEXT(osp) ) {
-		Assert(osp->objnum != -1);
-		objp = &Objects[osp->objnum];
-
-		if ((osp->instance.isValid()) && (osp->vol < lowest_vol)) {
-			lowest_vol = osp->vol;
-			lowest_vol_osp = osp;
-		}
-	}
-
-	if (lowest_vol_osp != NULL)
-        objp = &Objects[lowest_vol_osp->objnum];
-
-	if ( (lowest_vol < new_vol) && (objp != NULL) ) {
-		obj_snd_index = obj_snd_find(objp, lowest_vol_osp);
+	std::sort(candidates.begin(), candidates.end(), [](const obj_snd_voice &a, const obj_snd_voice &b) {
+		return a.vol > b.vol;
+	});
+
+	// keeps the quietest playing sound at the front
+	auto quieter_first = [](const obj_snd_voice &a, const obj_snd_voice &b) {
+		return a.vol > b.vol;
+	};
+	std::make_heap(playing.begin(), playing.end(), quieter_first);
+
+	for (auto &candidate : candidates) {
+		if (playing.size() >= max_voices) {
+			// since candidates get quieter, nothing else can start once this one can't
+			if (playing.empty() || !(playing.front().vol < candidate.vol)) {
+				break;
+			}
 
-		if((obj_snd_index == -1) || (obj_snd_index >= (int) objp->objsnd_num.size())){
-			Int3();		// get dave
-		} else {
-			obj_snd_stop(objp, obj_snd_index);
+			std::pop_heap(playing.begin(), playing.end(), quieter_first);
+			stopped.push_back(playing.back());
+			playing.pop_back();
 		}
 
-		return true;
+		started.push_back(candidate);
+		playing.push_back(candidate);
+		std::push_heap(playing.begin(), playing.end(), quieter_first);
 	}
-	
-	return false;
 }
 
 //int Debug_1 = 0, Debug_2 = 0;
@@ -435,26 +453,168 @@ void maybe_play_flyby_snd(float closest_dist, object *closest_objp, object *list
 	}
 }
 
+// how much extra distance do we add before attentuation?
+static float obj_snd_add_distance(const obj_snd *osp, const object *objp)
+{
+	if (osp->flags & OS_MAIN) {
+		return objp->radius;
+	}
+
+	return 0.0f;
+}
+
+// the multiplier of the sound's volume that depends on the state of the ship, 0 if it should be silent
+static float obj_snd_get_vol_mult(const obj_snd *osp, const object *objp)
+{
+	float speed_vol_multiplier = 1.0f;
+	float rot_vol_mult = 1.0f;
+	float alive_vol_mult = 1.0f;
+
+	if ( objp->type != OBJ_SHIP ) {
+		return 1.0f;
+	}
+
+	ship *sp = &Ships[objp->instance];
+	ship_info *sip = &Ship_info[sp->ship_info_index];
+
+	if (osp->flags & OS_ENGINE) {
+		bool disabled_and_silent = Disabled_or_disrupted_engines_silent && 
+		                           (sp->flags[Ship::Ship_Flags::Disabled] || ship_subsys_disrupted(sp, SUBSYSTEM_ENGINE));
+		if (!sp->flags[Ship::Ship_Flags::Engine_sound_on] || disabled_and_silent) {
+			// engine sound is disabled
+			return 0.0f;
+		}
+	}
+
+	// we don't want to start the engine sound unless the ship is
+	// moving (unless flag SIF_BIG_SHIP is set)
+	if ( (osp->flags & OS_ENGINE) && (!(sip->is_big_or_huge()) || Unify_minimum_engine_sound) ) {
+		float percent_max;
+		if ( objp->phys_info.max_vel.xyz.z <= 0.0f ) {
+			percent_max = 0.0f;
+		}
+		else
+			percent_max = objp->phys_info.fspeed / objp->phys_info.max_vel.xyz.z;
+
+		if ( sip->min_engine_vol == -1.0f) {
+			// Retail behavior: volume ramps from 0.5 (when stationary) to 1.0 (when at half speed)
+			if ( percent_max >= 0.5f ) {
+				speed_vol_multiplier = 1.0f;
+			} else {
+				speed_vol_multiplier = 0.5f + (percent_max);	// linear interp: 0.5->1.0 when 0.0->0.5
+			}
+		} else {
+			// Volume ramps from min_engine_vol (when stationary) to 1.0 (when at full speed)
+			speed_vol_multiplier = sip->min_engine_vol + ((1.0f - sip->min_engine_vol) * percent_max);
+		}
+	}
+
+	// check conditions for subsystem sounds
+	if (osp->ss != nullptr)
+	{
+		if (osp->flags & OS_TURRET_BASE_ROTATION)
+		{
+			if (osp->ss->base_rotation_rate_pct > 0.0f)
+				rot_vol_mult = ((0.25f + (0.75f * osp->ss->base_rotation_rate_pct)) * osp->ss->system_info->turret_base_rotation_snd_mult);
+			else
+				rot_vol_mult = 0.0f;
+		}
+		if (osp->flags & OS_TURRET_GUN_ROTATION)
+		{
+			if (osp->ss->gun_rotation_rate_pct > 0.0f)
+				rot_vol_mult = ((0.25f + (0.75f * osp->ss->gun_rotation_rate_pct)) * osp->ss->system_info->turret_gun_rotation_snd_mult);
+			else
+				rot_vol_mult = 0.0f;
+		}
+		if (osp->flags & OS_SUBSYS_ROTATION )
+		{
+			if (osp->ss->flags[Ship::Subsystem_Flags::Rotates]) {
+				rot_vol_mult = 1.0f;
+			} else {
+				rot_vol_mult = 0.0f;
+			}
+		}
+		if (osp->flags & OS_SUBSYS_ALIVE)
+		{
+			if (osp->ss->current_hits > 0.0f) {
+				alive_vol_mult = 1.0f;
+			} else {
+				alive_vol_mult = 0.0f;
+			}
+		}
+		if (osp->flags & OS_SUBSYS_DEAD)
+		{
+			if (osp->ss->current_hits <= 0.0f) {
+				alive_vol_mult = 1.0f;
+			} else {
+				alive_vol_mult = 0.0f;
+			}
+		}
+		if (osp->flags & OS_SUBSYS_DAMAGED)
+		{
+			alive_vol_mult = osp->ss->current_hits / osp->ss->max_hits;
+			CLAMP(alive_vol_mult, 0.0f, 1.0f);
+		}
+	}
+
+	return speed_vol_multiplier * rot_vol_mult * alive_vol_mult;
+}
+
+// re-establish the volume, position and velocity of a playing sound
+static void obj_snd_update_instance(obj_snd *osp, const object *objp, game_snd *gs, vec3d *source_pos, float add_distance)
+{
+	float vol_mult = obj_snd_get_vol_mult(osp, objp);
+	snd_set_volume( osp->instance, (vol_mult > 0.0f) ? gs->volume_range.next() * vol_mult : 0.0f );
+
+	vec3d vel = objp->phys_info.vel;
+
+	// Don't play doppler effect for cruisers or capitals
+	if (objp->type == OBJ_SHIP) {
+		if ( Ship_info[Ships[objp->instance].ship_info_index].is_big_or_huge() ) {
+			vel = vmd_zero_vector;
+		}
+	}
+
+	int channel = ds_get_channel(osp->instance);
+	ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), source_pos, &vel);
+	snd_get_3d_vol_and_pan(gs, source_pos, &osp->vol, &osp->pan, add_distance);
+}
+
+// far away sounds change too little per frame to be worth updating every time
+static UI_TIMESTAMP obj_snd_next_update(const game_snd *gs, float distance, UI_TIMESTAMP now)
+{
+	if ( distance > gs->max * OBJ_SND_FAR_FRACTION ) {
+		return ui_timestamp_delta(now, OBJ_SND_FAR_UPDATE_TIME);
+	}
+
+	return UI_TIMESTAMP::immediate();
+}
+
 // ---------------------------------------------------------------------------------------
 // obj_snd_do_frame()
 //
 // Called once per frame to process the persistent sound objects
 //
+// Sounds out of range are culled before doing any work on them.  Updates of the sounds that are
+// playing are batched so that OpenAL applies them at once, and the sounds which want to start
+// compete for the free voices by volume, see obj_snd_select_voices().
+//
 void obj_snd_do_frame()
 {
-	float				closest_dist, distance, speed_vol_multiplier, rot_vol_mult, percent_max, alive_vol_mult;
+	float				closest_dist, distance;
 	obj_snd			*osp;
 	object			*objp, *closest_objp;
 	game_snd			*gs;
-	int				channel;
 	vec3d			source_pos;
 	float				add_distance;
 
 	if ( Obj_snd_enabled == FALSE )
 		return;
 
-	if ( ui_timestamp_since(Obj_snd_last_update) > 20 ) {
-		Obj_snd_last_update = ui_timestamp();
+	UI_TIMESTAMP now = obj_snd_now();
+
+	if ( ui_timestamp_get_delta(Obj_snd_last_update, now) > 20 ) {
+		Obj_snd_last_update = now;
 	} else {
 		return;
 	}
@@ -472,30 +632,34 @@ void obj_snd_do_frame()
 		observer_obj = Player_obj;
 	}
 
+	Obj_snd_playing.clear();
+	Obj_snd_candidates.clear();
+	Obj_snd_stopped.clear();
+	Obj_snd_started.clear();
+
+	ds_defer_updates();
+
 	for ( osp = GET_FIRST(&obj_snd_list); osp !=END_OF_LIST(&obj_snd_list); osp = GET_NEXT(osp) ) {
 		Assert(osp != nullptr);
 		objp = &Objects[osp->objnum];
-		if ((Player_obj == objp) && (observer_obj == Player_obj) && !(osp->flags & OS_PLAY_ON_PLAYER)) {
-			// we don't play sounds if the view is from the player
-			// unless OS_PLAY_ON_PLAYER was set manually
-			continue;
-		}
+
+		int snd_index = static_cast<int>(osp - Objsnds);
 
 		gs = gamesnd_get_game_sound(osp->id);
-		if (gs->flags & GAME_SND_NOT_VALID) {
+		if (((Player_obj == objp) && (observer_obj == Player_obj) && !(osp->flags & OS_PLAY_ON_PLAYER)) || (gs->flags & GAME_SND_NOT_VALID)) {
+			// we don't play sounds if the view is from the player
+			// unless OS_PLAY_ON_PLAYER was set manually
+			// but a sound that is still playing keeps its voice
+			if (osp->instance.isValid()) {
+				Obj_snd_playing.push_back({ snd_index, osp->vol });
+			}
 			continue;
 		}
 
-		bool obj_is_ship = (objp->type == OBJ_SHIP);
-
 		obj_snd_source_pos(&source_pos, osp);
 		distance = vm_vec_dist_quick( &source_pos, &View_position );
 
-		// how much extra distance do we add before attentuation?
-		add_distance = 0.0f;
-		if(osp->flags & OS_MAIN){
-			add_distance = objp->radius;
-		}
+		add_distance = obj_snd_add_distance(osp, objp);
 
 		distance -= add_distance;
 		if ( distance < 0.0f ) {
@@ -503,196 +667,115 @@ void obj_snd_do_frame()
 		}
 
 		// save closest distance (used for flyby sound) if this is a small ship (and not the observer)
-		if ( (obj_is_ship) && (distance < closest_dist) && (objp != observer_obj) ) {
+		if ( (objp->type == OBJ_SHIP) && (distance < closest_dist) && (objp != observer_obj) ) {
 			if ( Ship_info[Ships[objp->instance].ship_info_index].is_small_ship() ) {
 				closest_dist = distance;
 				closest_objp = objp;
 			}
 		}
 
-		speed_vol_multiplier = 1.0f;
-		rot_vol_mult = 1.0f;
-		alive_vol_mult = 1.0f;
-		if ( obj_is_ship ) {
-			ship_info *sip = &Ship_info[Ships[objp->instance].ship_info_index];
-
-			// we don't want to start the engine sound unless the ship is
-			// moving (unless flag SIF_BIG_SHIP is set)
-			if ( (osp->flags & OS_ENGINE) && (!(sip->is_big_or_huge()) || Unify_minimum_engine_sound) ) {
-				if ( objp->phys_info.max_vel.xyz.z <= 0.0f ) {
-					percent_max = 0.0f;
-				}
-				else
-					percent_max = objp->phys_info.fspeed / objp->phys_info.max_vel.xyz.z;
-
-				if ( sip->min_engine_vol == -1.0f) {
-					// Retail behavior: volume ramps from 0.5 (when stationary) to 1.0 (when at half speed)
-					if ( percent_max >= 0.5f ) {
-						speed_vol_multiplier = 1.0f;
-					} else {
-						speed_vol_multiplier = 0.5f + (percent_max);	// linear interp: 0.5->1.0 when 0.0->0.5
-					}
-				} else {
-					// Volume ramps from min_engine_vol (when stationary) to 1.0 (when at full speed)
-					speed_vol_multiplier = sip->min_engine_vol + ((1.0f - sip->min_engine_vol) * percent_max);
-				}
+		if ( !osp->instance.isValid() ) {
+			// if this is a 3D sound, check distance
+			// (since non-3D sounds have gs->max set to 0, they will never be played)
+			if ( distance >= gs->max ) {
+				continue;
 			}
 
-			// check conditions for subsystem sounds
-			if (osp->ss != nullptr)
-			{
-				if (osp->flags & OS_TURRET_BASE_ROTATION)
-				{
-					if (osp->ss->base_rotation_rate_pct > 0.0f)
-						rot_vol_mult = ((0.25f + (0.75f * osp->ss->base_rotation_rate_pct)) * osp->ss->system_info->turret_base_rotation_snd_mult);
-					else
-						rot_vol_mult = 0.0f;
-				}
-				if (osp->flags & OS_TURRET_GUN_ROTATION)
-				{
-					if (osp->ss->gun_rotation_rate_pct > 0.0f)
-						rot_vol_mult = ((0.25f + (0.75f * osp->ss->gun_rotation_rate_pct)) * osp->ss->system_info->turret_gun_rotation_snd_mult);
-					else
-						rot_vol_mult = 0.0f;
-				}
-				if (osp->flags & OS_SUBSYS_ROTATION )
-				{
-					if (osp->ss->flags[Ship::Subsystem_Flags::Rotates]) {
-						rot_vol_mult = 1.0f;
-					} else {
-						rot_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_ALIVE)
-				{
-					if (osp->ss->current_hits > 0.0f) {
-						alive_vol_mult = 1.0f;
-					} else {
-						alive_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_DEAD)
-				{
-					if (osp->ss->current_hits <= 0.0f) {
-						alive_vol_mult = 1.0f;
-					} else {
-						alive_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_DAMAGED)
-				{
-					alive_vol_mult = osp->ss->current_hits / osp->ss->max_hits;
-					CLAMP(alive_vol_mult, 0.0f, 1.0f);
-				}
+			float new_vol;
+			float max_vol = gs->volume_range.max();
+			if ( distance <= gs->min ) {
+				new_vol = max_vol;
+			}
+			else {
+				new_vol = max_vol - (distance - gs->min) * max_vol
+					/ (gs->max - gs->min);
+			}
 
+			if ( new_vol < 0.1f ) {
+				continue;
 			}
-		}
 
-		if ( !osp->instance.isValid() ) {
-			bool go_ahead_flag = true;
-			float new_vol;
+			switch( objp->type ) {
+				case OBJ_SHIP:
+				case OBJ_DEBRIS:
+				case OBJ_ASTEROID:
+				case OBJ_WEAPON:
+					Obj_snd_candidates.push_back({ snd_index, new_vol });
+					break;
+
+				default:
+					UNREACHABLE("Unhandled object type %d for persistent sound; get a coder!", objp->type);
+					break;
+			} // end switch
+			continue;
+		}
 
-			// if this is a 3D sound, check distance
-			// (since non-3D sounds have gs->max set to 0, they will never be played)
-			if ( distance < gs->max ) {
-				float max_vol = gs->volume_range.max();
-				if ( distance <= gs->min ) {
-					new_vol = max_vol;
-				}
-				else {
-					new_vol = max_vol - (distance - gs->min) * max_vol
-						/ (gs->max - gs->min);
-				}
+		// sound has finished playing and won't be played again
+		if ((osp->flags & OS_LOOPING_DISABLED) && !snd_is_playing(osp->instance)) {
+			auto osp_prev = GET_PREV(osp);
 
-				if ( new_vol < 0.1f ) {
-					continue;
-				}
+			// non-looping sounds that have already played once need to be removed from the object sound list
+			int sound_index = obj_snd_find(objp, osp);
+			obj_snd_delete(objp, sound_index);
 
-				switch( objp->type ) {
-					case OBJ_SHIP:
-					case OBJ_DEBRIS:
-					case OBJ_ASTEROID:
-					case OBJ_WEAPON:
-						if ( Num_obj_sounds_playing >= MAX_OBJ_SOUNDS_PLAYING ) {
-							go_ahead_flag = obj_snd_stop_lowest_vol(new_vol);
-						}
-						break;
+			// don't corrupt the iterating loop (next iteration will move to the deleted osp's next sibling)
+			osp = osp_prev;
+			continue;
+		}
 
-					default:
-						UNREACHABLE("Unhandled object type %d for persistent sound; get a coder!", objp->type);
-						break;
-				} // end switch
+		// currently playing sound has gone past maximum
+		if ( distance > gs->max ) {
+			int sound_index = obj_snd_find(objp, osp);
 
-				if ( go_ahead_flag ) {
-					int is_looping = (osp->flags & OS_LOOPING_DISABLED) ? 0 : 1;
-					osp->instance = snd_play_3d(gs, &source_pos, &View_position, add_distance, &objp->phys_info.vel, is_looping, 1.0f, SND_PRIORITY_TRIPLE_INSTANCE, nullptr, 1.0f, 0, true);
-					if (osp->instance.isValid()) {
-						Num_obj_sounds_playing++;
-					}
-				}
-				Assert(Num_obj_sounds_playing <= MAX_OBJ_SOUNDS_PLAYING);
-			}
+			Assert(sound_index != -1);
+			obj_snd_stop(objp, sound_index);
+			continue;
 		}
-		else {
-			// sound has finished playing and won't be played again
-			if ((osp->flags & OS_LOOPING_DISABLED) && !snd_is_playing(osp->instance)) {
-				auto osp_prev = GET_PREV(osp);
 
-				// non-looping sounds that have already played once need to be removed from the object sound list
-				int sound_index = obj_snd_find(objp, osp);
-				obj_snd_delete(objp, sound_index);
+		if ( ui_timestamp_compare(now, osp->next_update) >= 0 ) {
+			obj_snd_update_instance(osp, objp, gs, &source_pos, add_distance);
+			osp->next_update = obj_snd_next_update(gs, distance, now);
+		}
 
-				// don't corrupt the iterating loop (next iteration will move to the deleted osp's next sibling)
-				osp = osp_prev;
-				continue;
-			}
+		Obj_snd_playing.push_back({ snd_index, osp->vol });
+	}	// end for
 
-			// currently playing sound has gone past maximum
-			if ( distance > gamesnd_get_game_sound(osp->id)->max ) {
-				int sound_index = obj_snd_find(objp, osp);
+	ds_process_updates();
 
-				Assert(sound_index != -1);
-				obj_snd_stop(objp, sound_index);
-			}
-		}
+	if ( !Obj_snd_candidates.empty() ) {
+		obj_snd_select_voices(Obj_snd_playing, Obj_snd_candidates, static_cast<size_t>(MAX_OBJ_SOUNDS_PLAYING), Obj_snd_stopped, Obj_snd_started);
 
-		if (!osp->instance.isValid())
-			continue;
+		for (const auto &voice : Obj_snd_stopped) {
+			osp = &Objsnds[voice.snd_index];
+			objp = &Objects[osp->objnum];
 
-		bool sound_allowed = true;
-		ship* sp = nullptr; 
-		if (obj_is_ship) {
-			sp = &Ships[objp->instance];
-			if (osp->flags & OS_ENGINE) {
-				bool disabled_and_silent = Disabled_or_disrupted_engines_silent && 
-				                           (sp->flags[Ship::Ship_Flags::Disabled] || ship_subsys_disrupted(sp, SUBSYSTEM_ENGINE));
-				sound_allowed = (sp->flags[Ship::Ship_Flags::Engine_sound_on]) && !disabled_and_silent;
+			int sound_index = obj_snd_find(objp, osp);
+			if ( sound_index == -1 ) {
+				Int3();		// get Alan
+				continue;
 			}
+			obj_snd_stop(objp, sound_index);
 		}
 
-		channel = ds_get_channel(osp->instance);
-		// for DirectSound3D sounds, re-establish the maximum speed based on the
-		//	speed_vol_multiplier
-		if ( sound_allowed ) {
-			snd_set_volume( osp->instance, gs->volume_range.next() *speed_vol_multiplier*rot_vol_mult*alive_vol_mult );
-		}
-		else {
-			// engine sound is disabled
-			snd_set_volume( osp->instance, 0.0f );
-		}
+		for (const auto &voice : Obj_snd_started) {
+			osp = &Objsnds[voice.snd_index];
+			objp = &Objects[osp->objnum];
+			gs = gamesnd_get_game_sound(osp->id);
 
-		vec3d vel = objp->phys_info.vel;
+			obj_snd_source_pos(&source_pos, osp);
+			add_distance = obj_snd_add_distance(osp, objp);
+
+			int is_looping = (osp->flags & OS_LOOPING_DISABLED) ? 0 : 1;
+			osp->instance = snd_play_3d(gs, &source_pos, &View_position, add_distance, &objp->phys_info.vel, is_looping, 1.0f, SND_PRIORITY_TRIPLE_INSTANCE, nullptr, 1.0f, 0, true);
+			if (osp->instance.isValid()) {
+				Num_obj_sounds_playing++;
 
-		// Don't play doppler effect for cruisers or capitals
-		if (obj_is_ship) {
-			if ( Ship_info[sp->ship_info_index].is_big_or_huge() ) {
-				vel = vmd_zero_vector;
+				obj_snd_update_instance(osp, objp, gs, &source_pos, add_distance);
+				osp->next_update = obj_snd_next_update(gs, vm_vec_dist_quick(&source_pos, &View_position) - add_distance, now);
 			}
 		}
-
-		ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), &source_pos, &vel);
-		snd_get_3d_vol_and_pan(gs, &source_pos, &osp->vol, &osp->pan, add_distance);
-	}	// end for
+		Assert(Num_obj_sounds_playing <= MAX_OBJ_SOUNDS_PLAYING);
+	}
 
 	// see if we want to play a flyby sound
 	maybe_play_flyby_snd(closest_dist, closest_objp, observer_obj);
@@ -765,7 +848,7 @@ int obj_snd_assign(int objnum, gamesnd_id sndnum, const vec3d *pos, int flags, c
 	snd->instance    = sound_handle::invalid();
 	snd->vol = 0.0f;
 	snd->objnum = OBJ_INDEX(objp);
-	snd->next_update = 1;
+	snd->next_update = UI_TIMESTAMP::immediate();
 	snd->offset = *pos;
 	snd->ss = associated_sub;
 	// vm_vec_sub(&snd->offset, pos, &objp->pos);	
@@ -801,6 +884,37 @@ void obj_snd_delete(object *objp, int index)
 	objp->objsnd_num[index] = -1;
 }
 
+// ---------------------------------------------------------------------------------------
+// obj_snd_get_instance()
+//
+// Get the sound that is playing for a persistent sound of an object.
+//
+// parameters:  objp		=> object the sound is assigned to
+//				index		=> index of sound in objsnd_num
+//
+// returns:     the handle of the playing sound, or an invalid handle if it is not playing
+//
+sound_handle obj_snd_get_instance(const object *objp, int index)
+{
+	if (index < 0 || index >= (int) objp->objsnd_num.size() || objp->objsnd_num[index] == -1) {
+		return sound_handle::invalid();
+	}
+
+	return Objsnds[objp->objsnd_num[index]].instance;
+}
+
+// ---------------------------------------------------------------------------------------
+// obj_snd_set_clock()
+//
+// Replace the clock that obj_snd_do_frame() schedules updates by, so tests can step through time.
+//
+// parameters:  clock		=> returns the current time, nullptr to go back to ui_timestamp()
+//
+void obj_snd_set_clock(obj_snd_clock_func clock)
+{
+	Obj_snd_clock = clock;
+}
+
 // ---------------------------------------------------------------------------------------
 // obj_snd_delete_type()
 //
@@ -46,10 +46,27 @@ int	obj_snd_assign(int objnum, gamesnd_id sndnum, const vec3d *pos, int flags =
 //Delete specific persistent sound on object
 void obj_snd_delete(object *objp, int index);
 
+// the sound playing for a persistent sound of an object, invalid if it is not playing
+sound_handle obj_snd_get_instance(const object *objp, int index);
+
+// replaces the clock object sound updates are scheduled by, nullptr goes back to ui_timestamp()
+typedef UI_TIMESTAMP (*obj_snd_clock_func)();
+void obj_snd_set_clock(obj_snd_clock_func clock);
+
 // if sndnum is not -1, deletes all instances of the given sound within the object
 void	obj_snd_delete_type(int objnum, gamesnd_id sndnum = gamesnd_id(), ship_subsys *ss = NULL);
 
 void	obj_snd_delete_all();
 void	obj_snd_stop_all();
 
+// a persistent sound competing for one of the limited number of voices
+struct obj_snd_voice {
+	int		snd_index;		// index into Objsnds[]
+	float	vol;
+};
+
+// picks the sounds to stop and start so that the loudest ones play, see objectsnd.cpp
+void	obj_snd_select_voices(SCP_vector<obj_snd_voice> &playing, SCP_vector<obj_snd_voice> &candidates, size_t max_voices,
+	SCP_vector<obj_snd_voice> &stopped, SCP_vector<obj_snd_voice> &started);
+
 #endif
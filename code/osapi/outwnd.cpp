@@ -11,6 +11,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
 
 #ifdef WIN32
 #include <direct.h>
@@ -59,9 +60,14 @@ static bool outwnd_inited         = false;
 static FILE* Log_fp                      = nullptr;
 static bool Log_close_fp                 = false;
 static const char* FreeSpace_logfilename = nullptr;
+static SCP_string Log_filename_override;
 
 static std::unique_ptr<osapi::DebugWindow> debugWindow;
 
+// Sound decoding and other work on the worker threads may log as well, so everything outwnd_print() touches is
+// guarded by this.  It is recursive since outwnd_print() prints the missing filter file banner through itself.
+static std::recursive_mutex Outwnd_mutex;
+
 void load_filter_info()
 {
 	FILE* fp;
@@ -201,6 +207,8 @@ void outwnd_print(const char *id, const char *tmp)
 	if (!outwnd_inited)
 		return;
 
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
+
 	if (Outwnd_no_filter_file == 1) {
 		Outwnd_no_filter_file = 2;
 
@@ -263,7 +271,9 @@ void outwnd_init()
 
 			/* Set where the log file is going to go */
 			// Zacam: Set various conditions based on what type of log to generate.
-			if (Fred_running) {
+			if (!Log_filename_override.empty()) {
+				FreeSpace_logfilename = Log_filename_override.c_str();
+			} else if (Fred_running) {
 				FreeSpace_logfilename = "fred2_open.log";
 			} else if (Is_standalone) {
 				FreeSpace_logfilename = "fs2_standalone.log";
@@ -308,6 +318,8 @@ void outwnd_init()
 
 void outwnd_close()
 {
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
+
 	if (!running_unittests && Log_fp != nullptr) {
 		time_t timedate = time(nullptr);
 		char datestr[50];
@@ -327,12 +339,33 @@ void outwnd_close()
 	outwnd_inited = false;
 }
 
+// switches to a new log file in a process forked from the one which opened the current log
+void outwnd_reopen(const char *logfilename)
+{
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
+
+	// the old file still belongs to the parent process, so don't write a trailer into it
+	if (Log_fp != nullptr && Log_close_fp) {
+		fclose(Log_fp);
+	}
+	Log_fp       = nullptr;
+	Log_close_fp = false;
+
+	outwnd_inited = false;
+
+	Log_filename_override = logfilename;
+	outwnd_init();
+}
+
 void outwnd_debug_window_init() {
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
 	debugWindow.reset(new osapi::DebugWindow());
 }
 void outwnd_debug_window_do_frame(float frametime) {
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
 	debugWindow->doFrame(frametime);
 }
 void outwnd_debug_window_deinit() {
+	std::lock_guard<std::recursive_mutex> guard(Outwnd_mutex);
 	debugWindow.reset();
 }
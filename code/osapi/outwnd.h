@@ -15,6 +15,7 @@
 void load_filter_info();
 void outwnd_init();
 void outwnd_close();
+void outwnd_reopen(const char *logfilename);
 void outwnd_printf(const char *id, SCP_FORMAT_STRING const char *format, ...) SCP_FORMAT_STRING_ARGS(2, 3);
 void outwnd_printf2(SCP_FORMAT_STRING const char *format, ...) SCP_FORMAT_STRING_ARGS(1, 2);
 
@@ -47,13 +47,17 @@ logfile logfiles[MAX_LOGFILES] = {
 //
 
 // initialize the logfile
-bool logfile_init(int logfile_type)
+bool logfile_init(int logfile_type, const char *filename)
 {
 	if((logfile_type < 0) || (logfile_type >= MAX_LOGFILES)) {
 		Warning(LOCATION, "Attempt to write illegal logfile number %d", logfile_type);
 		return false;
 	}
 
+	if (filename != nullptr) {
+		strcpy_s(logfiles[logfile_type].filename, filename);
+	}
+
 	// attempt to open the file
 	logfiles[logfile_type].log_file = cfopen(logfiles[logfile_type].filename, "wt", CF_TYPE_DATA);
 
@@ -23,8 +23,8 @@
 // MULTI LOGFILE FUNCTIONS
 //
 
-// initialize the multi logfile
-bool logfile_init(int logfile_type);
+// initialize the multi logfile, optionally under a different file name than the default one
+bool logfile_init(int logfile_type, const char *filename = nullptr);
 
 // close down the multi logfile
 void logfile_close(int logfile_type);
@@ -16,6 +16,7 @@
 
 #include <cctype>
 #include "globalincs/version.h"
+#include "io/timer.h"
 #include "localization/fhash.h"
 #include "localization/localize.h"
 #include "mission/missionparse.h"
@@ -28,11 +29,14 @@
 #include "mod_table/mod_table.h"
 
 #include "utils/encoding.h"
+#include "utils/threading.h"
 #include "utils/unicode.h"
 #include "utils/string_utils.h"
 
 #include <utf8.h>
 
+#include <mutex>
+
 using namespace parse;
 
 
@@ -61,6 +65,8 @@ SCP_vector<Bookmark> Bookmarks;	// Stack of all our previously paused parsing
 void allocate_parse_text(size_t size);
 static size_t Parse_text_size = 0;
 
+static bool use_prefetched_file_text(const char *filename, int mode);
+
 static const SCP_unordered_map<SCP_string, SCP_string> retail_hashes = {
 	{"strings.tbl", "84ab6e5392d7c54752a61161aac9f9fd"},
 	{"weapons.tbl", "ca2c7f305b1f36988c2bb8c371ab2027"}
@@ -261,10 +267,76 @@ char *next_tokens(bool terminate_before_parenthesis_or_comma)
 	return Error_str;
 }
 
-//	Return the line number given by the current mission pointer, ie Mp.
-//	A very slow function (scans all processed text), but who cares how long
-//	an error reporting function takes?
-int get_line_num()
+// ----------------------------------------------------------------------------------------------
+// LINE NUMBER INDEX
+//
+// get_line_num() used to scan all of Parse_text up to Mp on every call, which adds up when validating large mods
+// produces thousands of warnings.  Whenever Parse_text is filled, the same scan is now done once for the whole text,
+// recording where every line ends, so that a line number is a binary search.  Comments are skipped by the scan
+// without counting towards Mp, so the index stores the number of uncommented characters before every line ending.
+//
+
+static SCP_vector<size_t> Line_index;
+static size_t Line_index_text_len = 0;		// position of the terminating null
+static size_t Line_index_uncommented_len = 0;	// uncommented characters before it
+static bool Line_index_valid = false;
+
+static void build_line_num_index()
+{
+	Line_index.clear();
+	Line_index_valid = false;
+
+	if (Parse_text == nullptr)
+		return;
+
+	bool	inquote = false;
+	bool	incomment = false;
+	bool	multiline = false;
+	size_t	uncommented = 0;
+	const char *p;
+
+	for (p = Parse_text; *p != '\0'; ++p)
+	{
+		if ( !incomment && (*p == '\"') )
+			inquote = !inquote;
+
+		if ( !incomment && !inquote && (*p == COMMENT_CHAR) )
+			incomment = true;
+
+		if ( !incomment && (*p == '/') && (*(p+1) == '*') ) {
+			multiline = true;
+			incomment = true;
+		}
+
+		size_t uncommented_before = uncommented;
+		if ( !incomment )
+			uncommented++;
+
+		if ( multiline && (p > Parse_text) && (*(p-1) == '*') && (*p == '/') ) {
+			multiline = false;
+			incomment = false;
+		}
+
+		if (*p == EOLN) {
+			if ( !multiline && incomment )
+				incomment = false;
+			Line_index.push_back(uncommented_before);
+		}
+	}
+
+	Line_index_text_len = static_cast<size_t>(p - Parse_text);
+	Line_index_uncommented_len = uncommented;
+	Line_index_valid = true;
+}
+
+void invalidate_line_num_index()
+{
+	Line_index.clear();
+	Line_index_valid = false;
+}
+
+//	Return the line number given by the current mission pointer, ie Mp, by scanning all the processed text.
+static int scan_line_num()
 {
 	int		count = 1;
 	bool	inquote = false;
@@ -313,6 +385,28 @@ int get_line_num()
 	return count;
 }
 
+
+//	Return the line number given by the current mission pointer, ie Mp.
+int get_line_num()
+{
+	// if there is no parse text, then we have some ad-hoc text such as provided in an evaluateSEXP call or in the debug console
+	if (Parse_text == nullptr)
+		return 1;
+
+	// Mp may point somewhere else entirely, or past the end of the text, which the scan warns about
+	if ( !Line_index_valid || (Mp < Parse_text) || (Mp > Parse_text + Line_index_text_len) )
+		return scan_line_num();
+
+	auto offset = static_cast<size_t>(Mp - Parse_text);
+	if (offset > Line_index_uncommented_len)
+		return scan_line_num();
+
+	// every line ending the scan would have passed before reaching Mp
+	auto passed = std::lower_bound(Line_index.begin(), Line_index.end(), offset) - Line_index.begin();
+
+	return static_cast<int>(passed) + 1;
+}
+
 //	Call this function to display an error message.
 //	error_level == 0 means this is just a warning.
 //	            == 1 means this is an error message.
@@ -2206,8 +2300,8 @@ void strip_comments(char *line, bool &in_quote, bool &in_multiline_comment_a, bo
 }
 
 // Reads one line of text from the input, returning the number of input chars read. Also sets the line ending type if found;
-// and if there is a mismatch, displays a warning.
-int parse_get_line(char *lineout, int max_line_len, const char *textin, int input_len, int line_num, LineEndingType &file_line_ending_type, bool &warned_for_this_file)
+// and if there is a mismatch, displays a warning (unless quiet, in which case warned_for_this_file is only set).
+int parse_get_line(char *lineout, int max_line_len, const char *textin, int input_len, int line_num, LineEndingType &file_line_ending_type, bool &warned_for_this_file, bool quiet = false)
 {
 	auto found_line_ending = LineEndingType::UNKNOWN;
 	char prev_c = '\0';
@@ -2256,7 +2350,8 @@ int parse_get_line(char *lineout, int max_line_len, const char *textin, int inpu
 			else if (found_line_ending != file_line_ending_type && !warned_for_this_file)
 			{
 				// we can't use error_display() here because we're in the middle of reading the file
-				Warning(LOCATION, "In %s, an inconsistent line ending was detected on line %d.  Please check the file for line ending errors.", Current_filename_sub, line_num);
+				if (!quiet)
+					Warning(LOCATION, "In %s, an inconsistent line ending was detected on line %d.  Please check the file for line ending errors.", Current_filename_sub, line_num);
 				warned_for_this_file = true;
 			}
 
@@ -2305,6 +2400,10 @@ void read_file_text(const char *filename, int mode, char *processed_text, char *
 		Error(LOCATION, "ERROR: Neither processed_text nor raw_text may be NULL when parsing is paused!!\n");
 	}
 
+	// parse_modular_table() may already have read and processed it
+	if ((processed_text == NULL) && (raw_text == NULL) && use_prefetched_file_text(filename, mode))
+		return;
+
 	// read the raw text
 	read_raw_file_text(filename, mode, raw_text);
 
@@ -2359,6 +2458,8 @@ void stop_parse()
 {
 	Assert( Bookmarks.empty() );
 
+	invalidate_line_num_index();
+
 	if (Parse_text != nullptr) {
 		vm_free(Parse_text);
 		Parse_text = nullptr;
@@ -2379,6 +2480,8 @@ void allocate_parse_text(size_t size)
 	// Make sure that there is space for the terminating null character
 	size += 1;
 
+	invalidate_line_num_index();
+
 	if (size <= Parse_text_size) {
 		// Make sure that a new parsing session does not use uninitialized data.
 		memset( Parse_text, 0, sizeof(char) * Parse_text_size );
@@ -2577,7 +2680,8 @@ void coerce_to_utf8(SCP_string &buffer, const char *str)
 }
 
 // Goober5000
-void process_raw_file_text(char* processed_text, char* raw_text)
+// If inconsistent_line_endings is given, inconsistent line endings are reported through it instead of with a warning
+void process_raw_file_text(char* processed_text, char* raw_text, bool *inconsistent_line_endings)
 {
 	SCP_string parse_exception_1402;
 	unicode::convert_encoding(parse_exception_1402, "1402, \"Sie haben IPX-Protokoll als Protokoll ausgew\xE4hlt, aber dieses Protokoll ist auf Ihrer Maschine nicht installiert.\".\"\n", unicode::Encoding::Encoding_iso8859_1);
@@ -2614,7 +2718,8 @@ void process_raw_file_text(char* processed_text, char* raw_text)
 	int parsed_line_num = 1;
 	auto file_line_ending_type = LineEndingType::UNKNOWN;
 	bool warned_for_this_file = false;
-	while ((num_chars_read = parse_get_line(outbuf, PARSE_BUF_SIZE-1, mp_raw, remaining_raw_len, parsed_line_num, file_line_ending_type, warned_for_this_file)) != 0) {
+	bool quiet = (inconsistent_line_endings != nullptr);
+	while ((num_chars_read = parse_get_line(outbuf, PARSE_BUF_SIZE-1, mp_raw, remaining_raw_len, parsed_line_num, file_line_ending_type, warned_for_this_file, quiet)) != 0) {
 		mp_raw += num_chars_read;
 		remaining_raw_len -= num_chars_read;
 		parsed_line_num++;
@@ -2657,6 +2762,12 @@ void process_raw_file_text(char* processed_text, char* raw_text)
 
 	// Make sure the string is terminated properly
 	*mp = *mp_raw = '\0';
+
+	if (inconsistent_line_endings != nullptr)
+		*inconsistent_line_endings = warned_for_this_file;
+
+	if (processed_text == Parse_text)
+		build_line_num_index();
 /*
 	while (cfgets(outbuf, PARSE_BUF_SIZE, mf) != NULL) {
 		if (strlen(outbuf) >= PARSE_BUF_SIZE-1)
@@ -4974,6 +5085,133 @@ void parse_string_map(SCP_map<SCP_string, SCP_string>& outMap, const char* end_m
 	required_string(end_marker);
 }
 
+// ----------------------------------------------------------------------------------------------
+// MODULAR TABLE PREFETCH
+//
+// Reading a table file and stripping its comments does not depend on any other table, so parse_modular_table() does
+// that for all files of a family at once on the task pool before the files are parsed one by one.  read_file_text()
+// then hands out the prefetched text instead of reading the file again.  Anything out of the ordinary (encrypted
+// files, unexpected encodings, invalid UTF-8, inconsistent line endings) is left to read_file_text() itself, since
+// those produce warnings or conversions which have to happen on the main thread.
+//
+
+typedef struct prefetched_text {
+	SCP_string filename;
+	int mode = CF_TYPE_ANY;
+	bool usable = false;
+	SCP_vector<char> raw_text;
+	SCP_vector<char> processed_text;
+	std::uint64_t read_us = 0;
+} prefetched_text;
+
+static SCP_vector<prefetched_text> Prefetched_texts;
+
+// cfile keeps its open files in a shared table
+static std::mutex Prefetch_cfile_mutex;
+
+static bool prefetch_read_file(prefetched_text &entry, SCP_vector<char> &bytes)
+{
+	std::lock_guard<std::mutex> guard(Prefetch_cfile_mutex);
+
+	auto mf = cfopen(entry.filename.c_str(), "rb", entry.mode);
+	if (mf == nullptr)
+		return false;
+
+	int file_len = cfilelength(mf);
+	bytes.resize(static_cast<size_t>(MAX(file_len, 0)));
+
+	bool success = (file_len > 0) && (cfread(bytes.data(), file_len, 1, mf) == 1);
+
+	cfclose(mf);
+	return success;
+}
+
+// does what read_file_text() does for the file, but gives up on everything that would warn
+static void prefetch_file_text(prefetched_text &entry)
+{
+	auto start = timer_get_microseconds();
+
+	SCP_vector<char> bytes;
+	if (!prefetch_read_file(entry, bytes)) {
+		return;
+	}
+
+	// the encryption signature is at the start of the file
+	char header[10] = { 0 };
+	memcpy(header, bytes.data(), MIN(bytes.size(), sizeof(header)));
+	if (is_encrypted(header)) {
+		return;
+	}
+
+	// same checks as util::check_encoding_and_skip_bom()
+	SCP_string probe(bytes.data(), MIN(bytes.size(), static_cast<size_t>(10)));
+	auto encoding = util::guess_encoding(probe, Unicode_text_mode);
+	if (encoding != (Unicode_text_mode ? util::Encoding::UTF8 : util::Encoding::ASCII)) {
+		return;
+	}
+	size_t offset = (Unicode_text_mode && util::has_bom(probe)) ? 3 : 0;
+
+	entry.raw_text.assign(bytes.begin() + offset, bytes.end());
+	entry.raw_text.push_back('\0');
+
+	if (Unicode_text_mode && (utf8::find_invalid(entry.raw_text.begin(), entry.raw_text.end() - 1) != entry.raw_text.end() - 1)) {
+		return;
+	}
+
+	// comments only ever shrink the text, but foreign characters may be expanded
+	entry.processed_text.resize(entry.raw_text.size() * 2 + 1);
+
+	bool inconsistent_line_endings = false;
+	process_raw_file_text(entry.processed_text.data(), entry.raw_text.data(), &inconsistent_line_endings);
+	if (inconsistent_line_endings) {
+		return;
+	}
+
+	entry.processed_text.resize(strlen(entry.processed_text.data()) + 1);
+	entry.usable = true;
+	entry.read_us = timer_get_microseconds() - start;
+}
+
+static void prefetch_file_texts(const SCP_vector<SCP_string> &filenames, int mode)
+{
+	Prefetched_texts.clear();
+	Prefetched_texts.resize(filenames.size());
+
+	for (size_t i = 0; i < filenames.size(); ++i) {
+		Prefetched_texts[i].filename = filenames[i];
+		Prefetched_texts[i].mode = mode;
+	}
+
+	threading::parallel_for(Prefetched_texts.size(), 1, [](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			prefetch_file_text(Prefetched_texts[i]);
+		}
+	});
+}
+
+// copies the prefetched text of the file into Parse_text and Parse_text_raw, if there is any
+static bool use_prefetched_file_text(const char *filename, int mode)
+{
+	for (auto &entry : Prefetched_texts) {
+		if (!entry.usable || (entry.mode != mode) || stricmp(entry.filename.c_str(), filename) != 0) {
+			continue;
+		}
+
+		allocate_parse_text(MAX(entry.raw_text.size(), entry.processed_text.size()));
+		memcpy(Parse_text_raw, entry.raw_text.data(), entry.raw_text.size());
+		memcpy(Parse_text, entry.processed_text.data(), entry.processed_text.size());
+		build_line_num_index();
+
+		// a file parsed twice is read the normal way the second time
+		entry.usable = false;
+		entry.raw_text = SCP_vector<char>();
+		entry.processed_text = SCP_vector<char>();
+		return true;
+	}
+
+	return false;
+}
+
 // parse a modular table of type "name_check" and parse it using the specified function callback
 int parse_modular_table(const char *name_check, void (*parse_callback)(const char *filename), int path_type, int sort_type)
 {
@@ -4991,14 +5229,46 @@ int parse_modular_table(const char *name_check, void (*parse_callback)(const cha
 
 	const auto ext = strrchr(name_check, '.');
 
-	for (i = 0; i < num_files; i++){
-		if (ext != nullptr) {
-			tbl_file_names[i] += ext;
+	if (ext != nullptr) {
+		for (auto &filename : tbl_file_names) {
+			filename += ext;
 		}
+	}
+
+	auto start = timer_get_microseconds();
+
+	// no point in waking up the task pool for a single file
+	if (num_files > 1 && threading::is_threading()) {
+		prefetch_file_texts(tbl_file_names, path_type);
+	}
+
+	auto prefetch_us = timer_get_microseconds() - start;
+	std::uint64_t parse_us = 0;
+
+	for (i = 0; i < num_files; i++){
 		mprintf(("TBM  =>  Starting parse of '%s' ...\n", tbl_file_names[i].c_str()));
+
+		auto parse_start = timer_get_microseconds();
 		(*parse_callback)(tbl_file_names[i].c_str());
+		parse_us += timer_get_microseconds() - parse_start;
+	}
+
+	if (num_files > 0) {
+		int num_prefetched = 0;
+		std::uint64_t read_us = 0;
+		for (const auto &entry : Prefetched_texts) {
+			if (entry.read_us > 0) {
+				++num_prefetched;
+				read_us += entry.read_us;
+			}
+		}
+
+		mprintf(("TBM  =>  %s: %d file(s) in %.2f ms; %d prefetched in %.2f ms (%.2f ms of work), parsed in %.2f ms\n", name_check, num_files,
+			(prefetch_us + parse_us) / 1000.0, num_prefetched, prefetch_us / 1000.0, read_us / 1000.0, parse_us / 1000.0));
 	}
 
+	Prefetched_texts.clear();
+
 	Parsing_modular_table = false;
 
 	return num_files;
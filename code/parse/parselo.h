@@ -114,6 +114,7 @@ extern bool is_parenthesis(char ch);
 
 // error
 extern int get_line_num();
+extern void invalidate_line_num_index();
 extern char *next_tokens(bool terminate_before_parenthesis_or_comma = false);
 extern void diag_printf(SCP_FORMAT_STRING const char *format, ...) SCP_FORMAT_STRING_ARGS(1, 2);
 extern void error_display(int error_level, SCP_FORMAT_STRING const char *format, ...) SCP_FORMAT_STRING_ARGS(2, 3);
@@ -362,7 +363,7 @@ extern int read_file_bytes(const char *filename, int mode, char *raw_bytes = nul
 extern void read_file_text(const char *filename, int mode = CF_TYPE_ANY, char *processed_text = NULL, char *raw_text = NULL);
 extern void read_file_text_from_default(const default_file& file, char *processed_text = NULL, char *raw_text = NULL);
 extern void read_raw_file_text(const char *filename, int mode = CF_TYPE_ANY, char *raw_text = NULL);
-extern void process_raw_file_text(char *processed_text = NULL, char *raw_text = NULL);
+extern void process_raw_file_text(char *processed_text = NULL, char *raw_text = NULL, bool *inconsistent_line_endings = nullptr);
 extern void coerce_to_utf8(SCP_string &buffer, const char *src);
 extern void debug_show_mission_text();
 extern void convert_sexp_to_string(SCP_string &dest, int cur_node, int mode);
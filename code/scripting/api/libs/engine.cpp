@@ -122,6 +122,16 @@ ADE_FUNC(addHook,
 		}
 	}
 
+	// name the hook after the script adding it so that the profiler can tell runtime hooks apart
+	SCP_string source_name;
+	lua_Debug ar;
+	if (lua_getstack(L, 1, &ar) && lua_getinfo(L, "Sl", &ar)) {
+		sprintf(source_name, "%s:%d - %s", ar.short_src, ar.currentline, action_hook->getHookName().c_str());
+	} else {
+		sprintf(source_name, "<Runtime> - %s", action_hook->getHookName().c_str());
+	}
+	action.profile_source = hook_profiler_register_source(source_name.c_str());
+
 	Script_system.AddConditionedHook(action_hook->getHookId(), std::move(action));
 	return ADE_RETURN_TRUE;
 }
@@ -24,18 +24,11 @@ ADE_INDEXER(l_HookVar,
 
 	const auto scriptSystem = script_state::GetScriptState(L);
 
-	const auto& hookVars = scriptSystem->GetHookVariableReferences();
-	const auto iter = hookVars.find(name);
-	if (iter == hookVars.end()) {
-		return ADE_RETURN_NIL;
-	}
-	if (iter->second.empty()) {
-		// Hook variable existed at some point but was removed again
+	// Use the value on top of the stack, if the hook variable exists at the moment
+	if (!scriptSystem->PushHookVar(L, script_state::FindHookVarId(name))) {
 		return ADE_RETURN_NIL;
 	}
 
-	// Use the value on top of the stack
-	iter->second.back()->pushValue(L);
 	return 1;
 }
 
@@ -59,18 +52,16 @@ ADE_INDEXER(l_HookVar_Globals,
 
 	const auto scriptSystem = script_state::GetScriptState(L);
 
-	const auto& hookVars = scriptSystem->GetHookVariableReferences();
-
 	// List 'em
 	int count = 1;
-	for (const auto& pair : hookVars) {
-		if (pair.second.empty()) {
+	for (int id = 0; id < script_state::GetNumHookVarIds(); ++id) {
+		if (!scriptSystem->IsHookVarSet(id)) {
 			// Skip empty value stacks
 			continue;
 		}
 
 		if (count == idx) {
-			return ade_set_args(L, "s", pair.first);
+			return ade_set_args(L, "s", script_state::GetHookVarName(id).c_str());
 		}
 		count++;
 	}
@@ -82,12 +73,13 @@ ADE_FUNC(__len, l_HookVar_Globals, NULL, "Number of HookVariables", "number", "N
 {
 	const auto scriptSystem = script_state::GetScriptState(L);
 
-	const auto& hookVars = scriptSystem->GetHookVariableReferences();
-
-	// Since the values are on a stack, it is possible to have entries in the map that have no values at the moment
-	auto validHookVars = std::count_if(hookVars.cbegin(),
-		hookVars.cend(),
-		[](const std::pair<SCP_string, SCP_vector<luacpp::LuaReference>>& values) { return !values.second.empty(); });
+	// Since the values are on a stack, it is possible to have ids that have no values at the moment
+	int validHookVars = 0;
+	for (int id = 0; id < script_state::GetNumHookVarIds(); ++id) {
+		if (scriptSystem->IsHookVarSet(id)) {
+			validHookVars++;
+		}
+	}
 
 	return ade_set_args(L, "i", validHookVars);
 }
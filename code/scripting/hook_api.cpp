@@ -52,6 +52,11 @@ HookManager& getHookManager()
 } // namespace
 
 namespace detail {
+int get_hook_parameter_id(const HookBase& hook, const char* name)
+{
+	return hook.getParameterId(name);
+}
+
 ade_odata_setter<object_h> convert_arg_type(object* objp)
 {
 	return ade_object_to_odata(objp != nullptr ? OBJ_INDEX(objp) : -1);
@@ -75,6 +80,10 @@ HookBase::HookBase(SCP_string hookName,
 				   int32_t hookId)
 	: _conditions(conditions), _hookName(std::move(hookName)), _description(std::move(description)), _parameters(std::move(parameters)), _deprecation(std::move(deprecation))
 {
+	for (const auto& parameter : _parameters) {
+		_parameterIds.push_back(script_state::GetHookVarId(parameter.name));
+	}
+
 	// If we specify a forced id then use that. This is for special hooks that need a guaranteed id
 	if (hookId >= 0) {
 		_hookId = hookId;
@@ -89,6 +98,25 @@ const SCP_string& HookBase::getDescription() const { return _description; }
 const SCP_vector<HookVariableDocumentation>& HookBase::getParameters() const { return _parameters; }
 const std::optional<HookDeprecationOptions>& HookBase::getDeprecation() const { return _deprecation; }
 int32_t HookBase::getHookId() const { return _hookId; }
+
+int HookBase::getParameterId(const char* name) const
+{
+	for (const auto& cached : _parameterIdCache) {
+		if (cached.first == name) {
+			return cached.second;
+		}
+	}
+
+	for (size_t i = 0; i < _parameters.size(); ++i) {
+		if (!strcmp(_parameters[i].name, name)) {
+			_parameterIdCache.emplace_back(name, _parameterIds[i]);
+			return _parameterIds[i];
+		}
+	}
+
+	Assertion(false, "Hook '%s' does not accept parameter '%s'.", _hookName.c_str(), name);
+	return script_state::GetHookVarId(name);
+}
 HookBase::~HookBase() = default;
 
 const SCP_vector<HookBase*>& getHooks() { return getHookManager().getHooks(); }
@@ -8,6 +8,7 @@
 
 #include "utils/tuples.h"
 
+#include <array>
 #include <utility>
 #include <optional>
 
@@ -25,21 +26,27 @@ T&& convert_arg_type(T&& arg)
 
 template <typename T>
 struct HookParameterInstance {
-	SCP_string name;
+	const char* name = nullptr;
 	char type = '\0';
 	T value;
 	bool enabled = true;
 
-	HookParameterInstance(SCP_string name_, char type_, T&& value_, bool enabled_)
-		: name(std::move(name_)), type(type_), value(std::forward<T>(value_)), enabled(enabled_)
+	HookParameterInstance(const char* name_, char type_, T&& value_, bool enabled_)
+		: name(name_), type(type_), value(std::forward<T>(value_)), enabled(enabled_)
 	{
 	}
 };
 
+// Looks up the hook variable id of a parameter of the hook, see HookBase::getParameterId()
+int get_hook_parameter_id(const HookBase& hook, const char* name);
+
 struct SetSingleHookVarHelper {
-	SCP_vector<SCP_string>& paramNames;
+	const HookBase& hook;
+	int* paramIds;
+	size_t& numParams;
 
-	SetSingleHookVarHelper(SCP_vector<SCP_string>& paramNames_) : paramNames(paramNames_) {}
+	SetSingleHookVarHelper(const HookBase& hook_, int* paramIds_, size_t& numParams_)
+		: hook(hook_), paramIds(paramIds_), numParams(numParams_) {}
 
 	template <typename T>
 	void operator()(HookParameterInstance<T>&& instance)
@@ -49,9 +56,10 @@ struct SetSingleHookVarHelper {
 			return;
 		}
 
-		paramNames.push_back(instance.name);
+		const int id = get_hook_parameter_id(hook, instance.name);
+		paramIds[numParams++] = id;
 
-		Script_system.SetHookVar(instance.name.c_str(),
+		Script_system.SetHookVar(id,
 								 instance.type,
 								 detail::convert_arg_type(std::move(instance.value)));
 	}
@@ -66,20 +74,48 @@ struct HookParameterInstanceList {
 	{
 	}
 
-	void setHookVars(SCP_vector<SCP_string>& paramNames)
+	// paramIds has to have room for all parameters, numParams is set to how many of them were set
+	void setHookVars(const HookBase& hook, int* paramIds, size_t& numParams)
 	{
 		util::tuples::for_each<0, SetSingleHookVarHelper, HookParameterInstance<Args>...>(
 			std::move(params),
-			SetSingleHookVarHelper(paramNames));
+			SetSingleHookVarHelper(hook, paramIds, numParams));
+	}
+};
+
+// Sets the parameters of a hook run as hook variables, but only once RunCondition() finds a matching action
+template <typename... Args>
+class HookVariableSetter final : public HookVariableSetup {
+	const HookBase& _hook;
+	HookParameterInstanceList<Args...>& _argsList;
+	std::array<int, sizeof...(Args)> _paramIds;
+	size_t _numParams = 0;
+
+  public:
+	HookVariableSetter(const HookBase& hook, HookParameterInstanceList<Args...>& argsList)
+		: _hook(hook), _argsList(argsList)
+	{
+	}
+
+	void set() override
+	{
+		_argsList.setHookVars(_hook, _paramIds.data(), _numParams);
+	}
+
+	void remove() override
+	{
+		for (size_t i = 0; i < _numParams; ++i) {
+			Script_system.RemHookVar(_paramIds[i]);
+		}
 	}
 };
 
 } // namespace detail
 
 template <typename T>
-detail::HookParameterInstance<T> hook_param(SCP_string name_, char type_, T&& value_, bool enabled = true)
+detail::HookParameterInstance<T> hook_param(const char* name_, char type_, T&& value_, bool enabled = true)
 {
-	return detail::HookParameterInstance<T>(std::move(name_), type_, std::forward<T>(value_), enabled);
+	return detail::HookParameterInstance<T>(name_, type_, std::forward<T>(value_), enabled);
 }
 
 template <typename... Args>
@@ -123,6 +159,9 @@ class HookBase {
 	const std::optional<HookDeprecationOptions>& getDeprecation() const;
 	int32_t getHookId() const;
 
+	// The hook variable id of one of the parameters of this hook
+	int getParameterId(const char* name) const;
+
 	virtual bool isActive() const = 0;
 	virtual bool isOverridable() const = 0;
 
@@ -132,15 +171,12 @@ class HookBase {
 	SCP_string _hookName;
 	SCP_string _description;
 	SCP_vector<HookVariableDocumentation> _parameters;
+	SCP_vector<int> _parameterIds;
 	std::optional<HookDeprecationOptions> _deprecation;
 	int32_t _hookId = 0;
-	
-	bool hasParameter(const SCP_string& param) const
-	{
-		return std::find_if(_parameters.begin(), _parameters.end(), [&param](const HookVariableDocumentation& test) {
-				   return test.name == param;
-			   }) != _parameters.end();
-	}
+
+	// call sites pass string literals, so a parameter name is looked up by its address after the first time
+	mutable SCP_vector<std::pair<const char*, int>> _parameterIdCache;
 };
 
 template<typename condition_t>
@@ -150,31 +186,16 @@ class HookImpl : public HookBase {
 		: HookBase(std::move(hookName), std::move(description), std::move(parameters), condition_t::conditions, std::move(deprecation), hookId) { };
 
 	template <typename... Args>
-	int run(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
+	int run(const condition_t& condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
 		if (!Scripting_game_init_run)
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
-
-		const auto num_run = Script_system.RunCondition(this->_hookId, std::any(std::move(condition)));
-
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
-
-		return num_run;
+		const HookConditionContext context(condition);
+		detail::HookVariableSetter<Args...> hookVars(*this, argsList);
+		return Script_system.RunCondition(this->_hookId, context, &hookVars);
 	}
+
 };
 template<>
 class HookImpl<void> : public HookBase {
@@ -189,26 +210,11 @@ class HookImpl<void> : public HookBase {
 		if (!Scripting_game_init_run)
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
-
-		const auto num_run = Script_system.RunCondition(this->_hookId, std::any{});
-
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
-
-		return num_run;
+		const HookConditionContext context;
+		detail::HookVariableSetter<Args...> hookVars(*this, argsList);
+		return Script_system.RunCondition(this->_hookId, context, &hookVars);
 	}
+
 };
 
 template<typename condition_t = void>
@@ -243,31 +249,16 @@ class OverridableHookImpl : public Hook<condition_t> {
 		: Hook<condition_t>(std::move(hookName), std::move(description), std::move(parameters), std::move(deprecation), hookId) { }
 
 	template <typename... Args>
-	bool isOverride(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
+	bool isOverride(const condition_t& condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
 		if (!Scripting_game_init_run)
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
-
-		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any(std::move(condition)));
-
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
-
-		return ret_val;
+		const HookConditionContext context(condition);
+		detail::HookVariableSetter<Args...> hookVars(*this, argsList);
+		return Script_system.IsConditionOverride(this->_hookId, context, &hookVars);
 	}
+
 };
 
 template<>
@@ -282,26 +273,11 @@ protected:
 		if (!Scripting_game_init_run)
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
-		argsList.setHookVars(paramNames);
-
-#ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
-				"Hook '%s' does not accept parameter '%s'.",
-				this->_hookName.c_str(),
-				param.c_str());
-			});
-#endif
-
-		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any{});
-
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
-		}
-
-		return ret_val;
+		const HookConditionContext context;
+		detail::HookVariableSetter<Args...> hookVars(*this, argsList);
+		return Script_system.IsConditionOverride(this->_hookId, context, &hookVars);
 	}
+
 };
 
 
@@ -19,6 +19,11 @@
 	build.emplace(conditionParseName, std::make_unique<ParseableConditionImpl<conditionsClassName, \
 		decltype(std::declval<conditionsClassName>().argument), decltype(argumentParse(std::declval<SCP_string>()))>> \
 		(documentation, &conditionsClassName::argument, argumentParse, argumentValid))
+// For conditions which hold exactly when one of the keys argumentKey writes for the argument equals the parsed value
+#define HOOK_CONDITION_KEYED(conditionsClassName, conditionParseName, documentation, argument, argumentParse, argumentValid, argumentKey) \
+	build.emplace(conditionParseName, std::make_unique<ParseableConditionImpl<conditionsClassName, \
+		decltype(std::declval<conditionsClassName>().argument), decltype(argumentParse(std::declval<SCP_string>()))>> \
+		(documentation, &conditionsClassName::argument, argumentParse, argumentValid, argumentKey))
 
 extern const char *Scan_code_text_english[];
 
@@ -32,6 +37,8 @@ class ParseableConditionImpl : public ParseableCondition {
 	const operating_t conditions_t::* object;
 	std::function<cache_t(const SCP_string&)> cache;
 	std::function<bool(operating_t, const cache_t&)> evaluate;
+	// writes the keys of the argument to the array and returns how many there are, -1 being the key of nothing
+	std::function<int(operating_t, int*)> key;
 
 	template<typename _conditions_t, typename _operating_t, typename _cache_t> friend class EvaluatableConditionImpl;
 public:
@@ -39,8 +46,19 @@ public:
 		return std::make_unique<EvaluatableConditionImpl<conditions_t, operating_t, cache_t>>(*this, input);
 	}
 
-	ParseableConditionImpl(SCP_string documentation_, const operating_t conditions_t::* object_, std::function<cache_t(const SCP_string&)> cache_, std::function<bool(operating_t, const cache_t&)> evaluate_) :
-		ParseableCondition(std::move(documentation_)), object(object_), cache(std::move(cache_)), evaluate(std::move(evaluate_)) { }
+	int getContextKeys(const HookConditionContext& conditionContext, int* keys) const override {
+		if (!key)
+			return 0;
+
+		const auto conditions = conditionContext.get<conditions_t>();
+		if (conditions == nullptr)
+			return 0;
+
+		return key(conditions->*object, keys);
+	}
+
+	ParseableConditionImpl(SCP_string documentation_, const operating_t conditions_t::* object_, std::function<cache_t(const SCP_string&)> cache_, std::function<bool(operating_t, const cache_t&)> evaluate_, std::function<int(operating_t, int*)> key_ = nullptr) :
+		ParseableCondition(std::move(documentation_)), object(object_), cache(std::move(cache_)), evaluate(std::move(evaluate_)), key(std::move(key_)) { }
 };
 
 template<typename conditions_t, typename operating_t, typename cache_t>
@@ -51,9 +69,22 @@ class EvaluatableConditionImpl : public EvaluatableCondition {
 public:
 	EvaluatableConditionImpl(const ParseableConditionImpl<conditions_t, operating_t, cache_t>& _condition, const SCP_string& input) : condition(_condition), cached(condition.cache(input)) { }
 
-	bool evaluate(const std::any& conditionContext) const override {
-		const conditions_t& conditions = std::any_cast<conditions_t>(conditionContext);
-		return condition.evaluate(conditions.*(condition.object), cached);
+	bool evaluate(const HookConditionContext& conditionContext) const override {
+		const auto conditions = conditionContext.get<conditions_t>();
+		if (conditions == nullptr)
+			return false;
+		return condition.evaluate(conditions->*(condition.object), cached);
+	}
+
+	const ParseableCondition* getDispatchKey(int& key) const override {
+		if constexpr (std::is_same<cache_t, int>::value) {
+			// a value that failed to parse never matches, so it is simply evaluated
+			if (condition.key && cached >= 0) {
+				key = cached;
+				return &condition;
+			}
+		}
+		return nullptr;
 	}
 };
 
@@ -117,6 +148,56 @@ static int conditionCompareRawControl(int keypress, const int& cached_key) {
 }
 
 
+// ---- Hook Condition Dispatch Keys ----
+
+static int conditionKeyShipClass(const ship* shipp) {
+	return shipp != nullptr ? shipp->ship_info_index : -1;
+}
+
+static int conditionKeyShipType(const ship* shipp) {
+	return shipp != nullptr ? Ship_info[shipp->ship_info_index].class_type : -1;
+}
+
+static int conditionKeyWeaponClass(const weapon* wep) {
+	return wep != nullptr ? wep->weapon_info_index : -1;
+}
+
+static int conditionKeyObjecttype(const object* objp) {
+	return objp != nullptr ? objp->type : -1;
+}
+
+static int conditionKeyObjectShipClass(const object* objp) {
+	return (objp != nullptr && objp->type == OBJ_SHIP) ? conditionKeyShipClass(&Ships[objp->instance]) : -1;
+}
+
+static int conditionKeyObjectShipType(const object* objp) {
+	return (objp != nullptr && objp->type == OBJ_SHIP) ? conditionKeyShipType(&Ships[objp->instance]) : -1;
+}
+
+static int conditionKeyObjectWeaponClass(const object* objp) {
+	return (objp != nullptr && objp->type == OBJ_WEAPON) ? conditionKeyWeaponClass(&Weapons[objp->instance]) : -1;
+}
+
+// for conditions on a single value
+template<typename operating_t, int (*keyFnc)(operating_t)>
+static int conditionSingleKey(operating_t operand, int* keys) {
+	keys[0] = keyFnc(operand);
+	return 1;
+}
+
+// for collision conditions, which hold if either of the objects matches
+template<int (*keyFnc)(const object*)>
+static int conditionCollisionKeys(CollisionConditions::ParticipatingObjects po, int* keys) {
+	keys[0] = keyFnc(po.objp_a);
+	keys[1] = keyFnc(po.objp_b);
+	return 2;
+}
+
+static int conditionWeaponclassKey(int weaponclass, int* keys) {
+	keys[0] = weaponclass;
+	return 1;
+}
+
 static SCP_string conditionParseString(const SCP_string& name) {
 	return name;
 }
@@ -161,19 +242,19 @@ static int conditionParseRawControl(const SCP_string& name) {
 
 #define HOOK_CONDITION_SHIPP(classname, prefix, documentationAddendum, shipp) \
 	HOOK_CONDITION(classname, prefix "Ship", "Specifies the name of the ship " documentationAddendum, shipp, conditionParseString, conditionCompareShip); \
-	HOOK_CONDITION(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, shipp, conditionParseShipClass, conditionCompareShipClass); \
-	HOOK_CONDITION(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, shipp, conditionParseShipType, conditionCompareShipType); 
+	HOOK_CONDITION_KEYED(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, shipp, conditionParseShipClass, conditionCompareShipClass, (conditionSingleKey<const ship*, conditionKeyShipClass>)); \
+	HOOK_CONDITION_KEYED(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, shipp, conditionParseShipType, conditionCompareShipType, (conditionSingleKey<const ship*, conditionKeyShipType>)); 
 
 #define HOOK_CONDITION_SHIP_OBJP(classname, prefix, documentationAddendum, objp_) \
 	HOOK_CONDITION(classname, prefix "Ship", "Specifies the name of the ship " documentationAddendum, objp_, conditionParseString, [](const object* objp, const SCP_string& shipname) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShip, objp, shipname); \
 	}); \
-	HOOK_CONDITION(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, objp_, conditionParseShipClass, [](const object* objp, const int& shipclass) -> bool { \
+	HOOK_CONDITION_KEYED(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, objp_, conditionParseShipClass, [](const object* objp, const int& shipclass) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShipClass, objp, shipclass); \
-	}); \
-	HOOK_CONDITION(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, objp_, conditionParseShipType, [](const object* objp, const int& shiptype) -> bool { \
+	}, (conditionSingleKey<const object*, conditionKeyObjectShipClass>)); \
+	HOOK_CONDITION_KEYED(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, objp_, conditionParseShipType, [](const object* objp, const int& shiptype) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShipType, objp, shiptype); \
-	});
+	}, (conditionSingleKey<const object*, conditionKeyObjectShipType>));
 
 // ---- Hook Conditions ----
 
@@ -198,34 +279,34 @@ HOOK_CONDITIONS_START(CollisionConditions)
 			return true;
 		return false;
 	});
-	HOOK_CONDITION(CollisionConditions, "Ship class", "Specifies the class of the ship which was part of the collision. At least one ship must be part of the collision and match.", participating_objects, conditionParseShipClass, [](CollisionConditions::ParticipatingObjects po, const int& shipclass) -> bool {
+	HOOK_CONDITION_KEYED(CollisionConditions, "Ship class", "Specifies the class of the ship which was part of the collision. At least one ship must be part of the collision and match.", participating_objects, conditionParseShipClass, [](CollisionConditions::ParticipatingObjects po, const int& shipclass) -> bool {
 		if (conditionObjectIsShipDo(&conditionCompareShipClass, po.objp_a, shipclass))
 			return true;
 		if (conditionObjectIsShipDo(&conditionCompareShipClass, po.objp_b, shipclass))
 			return true;
 		return false;
-	});
-	HOOK_CONDITION(CollisionConditions, "Ship type", "Specifies the type of the ship which was part of the collision. At least one ship must be part of the collision and match.", participating_objects, conditionParseShipType, [](CollisionConditions::ParticipatingObjects po, const int& shiptype) -> bool {
+	}, conditionCollisionKeys<conditionKeyObjectShipClass>);
+	HOOK_CONDITION_KEYED(CollisionConditions, "Ship type", "Specifies the type of the ship which was part of the collision. At least one ship must be part of the collision and match.", participating_objects, conditionParseShipType, [](CollisionConditions::ParticipatingObjects po, const int& shiptype) -> bool {
 		if (conditionObjectIsShipDo(&conditionCompareShipType, po.objp_a, shiptype))
 			return true;
 		if (conditionObjectIsShipDo(&conditionCompareShipType, po.objp_b, shiptype))
 			return true;
 		return false;
-	});
-	HOOK_CONDITION(CollisionConditions, "Weapon class", "Specifies the name of the weapon class which was part of the collision. At least one weapon must be part of the collision and match.", participating_objects, conditionParseWeaponClass, [](CollisionConditions::ParticipatingObjects po, const int& weaponclass) -> bool {
+	}, conditionCollisionKeys<conditionKeyObjectShipType>);
+	HOOK_CONDITION_KEYED(CollisionConditions, "Weapon class", "Specifies the name of the weapon class which was part of the collision. At least one weapon must be part of the collision and match.", participating_objects, conditionParseWeaponClass, [](CollisionConditions::ParticipatingObjects po, const int& weaponclass) -> bool {
 		if (conditionObjectIsWeaponDo(&conditionCompareWeaponClass, po.objp_a, weaponclass))
 			return true;
 		if (conditionObjectIsWeaponDo(&conditionCompareWeaponClass, po.objp_b, weaponclass))
 			return true;
 		return false;
-	});
-	HOOK_CONDITION(CollisionConditions, "Object type", "Specifies the type of the object which was part of the collision. At least one object must match.", participating_objects, conditionParseObjectType, [](CollisionConditions::ParticipatingObjects po, const int& objecttype) -> bool {
+	}, conditionCollisionKeys<conditionKeyObjectWeaponClass>);
+	HOOK_CONDITION_KEYED(CollisionConditions, "Object type", "Specifies the type of the object which was part of the collision. At least one object must match.", participating_objects, conditionParseObjectType, [](CollisionConditions::ParticipatingObjects po, const int& objecttype) -> bool {
 		if (conditionIsObjecttype(po.objp_a, objecttype))
 			return true;
 		if (conditionIsObjecttype(po.objp_b, objecttype))
 			return true;
 		return false;
-	});
+	}, conditionCollisionKeys<conditionKeyObjecttype>);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ShipDeathConditions)
@@ -241,15 +322,15 @@ HOOK_CONDITIONS_START(ShipDepartConditions)
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponDeathConditions)
-	HOOK_CONDITION(WeaponDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_wep, conditionParseWeaponClass, conditionCompareWeaponClass);
+	HOOK_CONDITION_KEYED(WeaponDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_wep, conditionParseWeaponClass, conditionCompareWeaponClass, (conditionSingleKey<const weapon*, conditionKeyWeaponClass>));
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ObjectDeathConditions)
 	HOOK_CONDITION_SHIP_OBJP(ObjectDeathConditions, "", "that died.", dying_objp);
-	HOOK_CONDITION(ObjectDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
+	HOOK_CONDITION_KEYED(ObjectDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
 		return conditionObjectIsWeaponDo(&conditionCompareWeaponClass, objp, weaponclass);
-	});
-	HOOK_CONDITION(ObjectDeathConditions, "Object type", "Specifies the type of the object that died.", dying_objp, conditionParseObjectType, conditionIsObjecttype);
+	}, (conditionSingleKey<const object*, conditionKeyObjectWeaponClass>));
+	HOOK_CONDITION_KEYED(ObjectDeathConditions, "Object type", "Specifies the type of the object that died.", dying_objp, conditionParseObjectType, conditionIsObjecttype, (conditionSingleKey<const object*, conditionKeyObjecttype>));
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ShipArriveConditions)
@@ -258,8 +339,8 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponCreatedConditions)
 	HOOK_CONDITION_SHIP_OBJP(WeaponCreatedConditions, "", "that fired the weapon.", parent_objp);
-	HOOK_CONDITION(WeaponCreatedConditions, "Object type", "Specifies the type of the object that is the parent of this weapon.", parent_objp, conditionParseObjectType, conditionIsObjecttype);
-	HOOK_CONDITION(WeaponCreatedConditions, "Weapon class", "Specifies the class of the weapon that was fired.", spawned_wep, conditionParseWeaponClass, conditionCompareWeaponClass);
+	HOOK_CONDITION_KEYED(WeaponCreatedConditions, "Object type", "Specifies the type of the object that is the parent of this weapon.", parent_objp, conditionParseObjectType, conditionIsObjecttype, (conditionSingleKey<const object*, conditionKeyObjecttype>));
+	HOOK_CONDITION_KEYED(WeaponCreatedConditions, "Weapon class", "Specifies the class of the weapon that was fired.", spawned_wep, conditionParseWeaponClass, conditionCompareWeaponClass, (conditionSingleKey<const weapon*, conditionKeyWeaponClass>));
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponEquippedConditions)
@@ -286,20 +367,20 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponSelectedConditions)
 	HOOK_CONDITION_SHIPP(WeaponSelectedConditions, "", "that has selected the weapon.", user_shipp);
-	HOOK_CONDITION(WeaponSelectedConditions, "Weapon class", "Specifies the class of the weapon that was selected.", weaponclass, conditionParseWeaponClass, std::equal_to<int>());
+	HOOK_CONDITION_KEYED(WeaponSelectedConditions, "Weapon class", "Specifies the class of the weapon that was selected.", weaponclass, conditionParseWeaponClass, std::equal_to<int>(), conditionWeaponclassKey);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponDeselectedConditions)
 	HOOK_CONDITION_SHIPP(WeaponDeselectedConditions, "", "that has deselected the weapon.", user_shipp);
-	HOOK_CONDITION(WeaponDeselectedConditions, "Weapon class", "Specifies the class of the weapon that was deselected.", weaponclass_prev, conditionParseWeaponClass, std::equal_to<int>());
+	HOOK_CONDITION_KEYED(WeaponDeselectedConditions, "Weapon class", "Specifies the class of the weapon that was deselected.", weaponclass_prev, conditionParseWeaponClass, std::equal_to<int>(), conditionWeaponclassKey);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ObjectDrawConditions)
 	HOOK_CONDITION_SHIP_OBJP(ObjectDrawConditions, "", "that was drawn / drawn from.", drawn_from_objp);
-	HOOK_CONDITION(ObjectDrawConditions, "Weapon class", "Specifies the class of the weapon that was drawn / drawn from.", drawn_from_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
+	HOOK_CONDITION_KEYED(ObjectDrawConditions, "Weapon class", "Specifies the class of the weapon that was drawn / drawn from.", drawn_from_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
 		return conditionObjectIsWeaponDo(&conditionCompareWeaponClass, objp, weaponclass);
-	});
-	HOOK_CONDITION(ObjectDrawConditions, "Object type", "Specifies the type of the object that was drawn / drawn from.", drawn_from_objp, conditionParseObjectType, conditionIsObjecttype);
+	}, (conditionSingleKey<const object*, conditionKeyObjectWeaponClass>));
+	HOOK_CONDITION_KEYED(ObjectDrawConditions, "Object type", "Specifies the type of the object that was drawn / drawn from.", drawn_from_objp, conditionParseObjectType, conditionIsObjecttype, (conditionSingleKey<const object*, conditionKeyObjecttype>));
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(KeyPressConditions)
@@ -308,7 +389,7 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(CommOrderConditions)
 	HOOK_CONDITION_SHIPP(CommOrderConditions, "", "that sent the order.", source);
-	HOOK_CONDITION(CommOrderConditions, "Object type", "Specifies the type of object that is the target of the order.", target, conditionParseObjectType, conditionIsObjecttype);
+	HOOK_CONDITION_KEYED(CommOrderConditions, "Object type", "Specifies the type of object that is the target of the order.", target, conditionParseObjectType, conditionIsObjecttype, (conditionSingleKey<const object*, conditionKeyObjecttype>));
 	HOOK_CONDITION_SHIP_OBJP(CommOrderConditions, "Target ", "that is being targeted.", target);
 HOOK_CONDITIONS_END
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <any>
+#include <typeinfo>
 
 class object;
 class ship;
@@ -13,12 +13,39 @@ enum class ArrivalLocation;
 
 namespace scripting {
 
+// Refers to the conditions struct a hook is being run with, without copying it
+class HookConditionContext {
+	const void* _data = nullptr;
+	const std::type_info* _type = nullptr;
+
+public:
+	HookConditionContext() = default;
+
+	template<typename conditions_t>
+	explicit HookConditionContext(const conditions_t& data) : _data(&data), _type(&typeid(conditions_t)) { }
+
+	template<typename conditions_t>
+	const conditions_t* get() const {
+		if (_type == nullptr || *_type != typeid(conditions_t))
+			return nullptr;
+		return static_cast<const conditions_t*>(_data);
+	}
+};
+
+class ParseableCondition;
+
 class EvaluatableCondition {
 public:
-	virtual bool evaluate(const std::any& /*conditionContext*/) const {
+	virtual bool evaluate(const HookConditionContext& /*conditionContext*/) const {
 		return false;
 	};
 
+	// If this condition only holds when the key of its parsed condition for a context equals a fixed value, returns that
+	// parsed condition and the value so that the script system can look up the hooks that can match a context directly
+	virtual const ParseableCondition* getDispatchKey(int& /*key*/) const {
+		return nullptr;
+	}
+
 	virtual ~EvaluatableCondition() = default;
 };
 
@@ -30,6 +57,15 @@ public:
 		return std::make_unique<EvaluatableCondition>();
 	};
 
+	// the most keys a context can have for one condition, e.g. the two objects of a collision
+	static const int MAX_CONTEXT_KEYS = 2;
+
+	// Writes the keys a context has for conditions that support dispatching, see EvaluatableCondition::getDispatchKey(),
+	// and returns how many there are.  The condition holds for the context if any of them equals its key.
+	virtual int getContextKeys(const HookConditionContext& /*conditionContext*/, int* /*keys*/) const {
+		return 0;
+	}
+
 	ParseableCondition() : documentation("Invalid Condition. Will never evaluate.") { }
 
 	virtual ~ParseableCondition() = default;
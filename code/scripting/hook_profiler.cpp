@@ -0,0 +1,315 @@
+#include "scripting/hook_profiler.h"
+
+#include "cmdline/cmdline.h"
+#include "debugconsole/console.h"
+#include "globalincs/systemvars.h"
+#include "io/timer.h"
+#include "parse/parselo.h"
+#include "scripting/hook_api.h"
+#include "scripting/scripting.h"
+#include "tracing/Monitor.h"
+
+#include <numeric>
+
+MONITOR(LuaKBInUse)
+MONITOR(LuaKBPooled)
+MONITOR(LuaAllocationsPerFrame)
+
+namespace scripting {
+
+void lua_alloc_stats::record(const void* ptr, size_t osize, size_t nsize, const void* result)
+{
+	if (frame != Framecount) {
+		frame = Framecount;
+		last_frame_allocations = frame_allocations;
+		frame_allocations = 0;
+
+		mon_LuaKBInUse = static_cast<int>(bytes_in_use / 1024);
+		mon_LuaKBPooled = static_cast<int>(pooled_bytes / 1024);
+		mon_LuaAllocationsPerFrame = last_frame_allocations;
+	}
+
+	if (nsize == 0) {
+		if (ptr != nullptr) {
+			++frees;
+			bytes_in_use -= osize;
+		}
+		return;
+	}
+
+	// a failed allocation leaves the old block alone
+	if (result == nullptr) {
+		return;
+	}
+
+	++frame_allocations;
+
+	if (ptr == nullptr) {
+		++allocations;
+		bytes_in_use += nsize;
+		bytes_allocated += nsize;
+	} else {
+		++reallocations;
+		bytes_in_use = bytes_in_use - osize + nsize;
+		if (nsize > osize) {
+			bytes_allocated += nsize - osize;
+		}
+	}
+
+	peak_bytes = MAX(peak_bytes, bytes_in_use);
+}
+
+// ----------------------------------------------------------------------------------------------
+// HOOK PROFILER DEFINES/VARS
+//
+
+namespace {
+
+struct hook_timing {
+	std::uint64_t calls = 0;
+	std::uint64_t total_us = 0;
+	std::uint64_t max_us = 0;
+	std::uint64_t bytes_allocated = 0;
+	std::uint64_t worst_frame_us = 0;
+
+	int frame = -1;
+	std::uint64_t frame_us = 0;
+	int frames_over_budget = 0;
+
+	// returns true if this call took the frame's time over the budget
+	bool add(std::uint64_t elapsed_us, std::uint64_t allocated, std::uint64_t budget_us)
+	{
+		++calls;
+		total_us += elapsed_us;
+		max_us = MAX(max_us, elapsed_us);
+		bytes_allocated += allocated;
+
+		if (frame != Framecount) {
+			frame = Framecount;
+			frame_us = 0;
+		}
+
+		bool was_over = frame_us > budget_us;
+		frame_us += elapsed_us;
+		worst_frame_us = MAX(worst_frame_us, frame_us);
+
+		if (budget_us > 0 && !was_over && frame_us > budget_us) {
+			++frames_over_budget;
+			return true;
+		}
+		return false;
+	}
+};
+
+struct profile_source {
+	SCP_string name;
+	// trace events refer to their category until they are written out, so this is never freed
+	std::unique_ptr<tracing::Category> category;
+	hook_timing timing;
+};
+
+bool Profiling_enabled = false;
+
+SCP_vector<profile_source> Profile_sources;
+SCP_unordered_map<SCP_string, int> Profile_source_lookup;
+
+// indexed by hook id
+SCP_vector<hook_timing> Hook_timings;
+
+tracing::Category Unknown_source_category("Lua script", false);
+
+std::uint64_t frame_budget_us()
+{
+	return Cmdline_lua_frame_budget > 0.0f ? static_cast<std::uint64_t>(Cmdline_lua_frame_budget * 1000.0f) : 0;
+}
+
+const tracing::Category& source_category(int source)
+{
+	if (source < 0 || source >= static_cast<int>(Profile_sources.size())) {
+		return Unknown_source_category;
+	}
+	return *Profile_sources[source].category;
+}
+
+SCP_string hook_name(int hook_id)
+{
+	for (const auto hook : getHooks()) {
+		if (hook->getHookId() == hook_id) {
+			return hook->getHookName();
+		}
+	}
+
+	SCP_string name;
+	sprintf(name, "<Hook %d>", hook_id);
+	return name;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------
+// HOOK PROFILER FUNCTIONS
+//
+
+int hook_profiler_register_source(const char* name)
+{
+	auto it = Profile_source_lookup.find(name);
+	if (it != Profile_source_lookup.end()) {
+		return it->second;
+	}
+
+	int source = static_cast<int>(Profile_sources.size());
+
+	profile_source entry;
+	entry.name = name;
+	entry.category.reset(new tracing::Category(("Lua: " + entry.name).c_str(), false));
+	Profile_sources.push_back(std::move(entry));
+
+	Profile_source_lookup.emplace(name, source);
+	return source;
+}
+
+bool hook_profiler_is_timing()
+{
+	return Profiling_enabled || Cmdline_lua_frame_budget > 0.0f;
+}
+
+hook_profile_scope::hook_profile_scope(int hook_id, int source, const lua_alloc_stats& alloc_stats)
+	: _trace_event(source_category(source)), _hook_id(hook_id), _source(source), _alloc_stats(alloc_stats)
+{
+	if (hook_profiler_is_timing()) {
+		_timing = true;
+		_start_allocated = _alloc_stats.bytes_allocated;
+		_start_us = timer_get_microseconds();
+	}
+}
+
+hook_profile_scope::~hook_profile_scope()
+{
+	if (!_timing) {
+		return;
+	}
+
+	auto elapsed_us = timer_get_microseconds() - _start_us;
+	auto allocated = _alloc_stats.bytes_allocated - _start_allocated;
+	auto budget_us = frame_budget_us();
+
+	const char* source_name = "<unknown>";
+	if (_source >= 0 && _source < static_cast<int>(Profile_sources.size())) {
+		Profile_sources[_source].timing.add(elapsed_us, allocated, 0);
+		source_name = Profile_sources[_source].name.c_str();
+	}
+
+	if (_hook_id < 0) {
+		return;
+	}
+	if (_hook_id >= static_cast<int>(Hook_timings.size())) {
+		Hook_timings.resize(_hook_id + 1);
+	}
+
+	auto& timing = Hook_timings[_hook_id];
+	if (timing.add(elapsed_us, allocated, budget_us)) {
+		// don't flood the log with a hook that is always slow
+		if (timing.frames_over_budget <= 10 || timing.frames_over_budget % 100 == 0) {
+			mprintf(("LUA: Hook '%s' took %.2f ms in frame %d, over the budget of %.2f ms (%d times so far). '%s' took %.2f ms of that.\n",
+				hook_name(_hook_id).c_str(), timing.frame_us / 1000.0f, Framecount, Cmdline_lua_frame_budget,
+				timing.frames_over_budget, source_name, elapsed_us / 1000.0f));
+		}
+	}
+}
+
+void hook_profiler_reset()
+{
+	for (auto& source : Profile_sources) {
+		source.timing = hook_timing();
+	}
+	Hook_timings.clear();
+}
+
+void hook_profiler_print(const lua_alloc_stats& alloc_stats)
+{
+	SCP_string text;
+
+	auto print_timing = [&](const char* name, const hook_timing& timing) {
+		if (timing.calls == 0) {
+			return;
+		}
+		sprintf_concat(text, "%-56.56s %8" PRIu64 " %10.2f %10.1f %10.2f %10.2f %10.1f %6d\n", name, timing.calls,
+			timing.total_us / 1000.0, static_cast<double>(timing.total_us) / timing.calls, timing.max_us / 1000.0,
+			timing.worst_frame_us / 1000.0, timing.bytes_allocated / 1024.0, timing.frames_over_budget);
+	};
+	auto print_header = [&](const char* title) {
+		sprintf_concat(text, "%-56s %8s %10s %10s %10s %10s %10s %6s\n", title, "Calls", "Total ms", "Avg us", "Max ms",
+			"Frame ms", "Alloc KB", "Over");
+	};
+
+	if (!hook_profiler_is_timing()) {
+		text += "Hook profiling is off, use 'lua_profile on' to start collecting timings.\n";
+	}
+	if (Cmdline_lua_frame_budget > 0.0f) {
+		sprintf_concat(text, "Frame budget per hook: %.2f ms\n", Cmdline_lua_frame_budget);
+	}
+
+	// slowest first
+	SCP_vector<int> order(Hook_timings.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [](int a, int b) { return Hook_timings[a].total_us > Hook_timings[b].total_us; });
+
+	text += "\n";
+	print_header("Hook");
+	for (int hook_id : order) {
+		print_timing(hook_name(hook_id).c_str(), Hook_timings[hook_id]);
+	}
+
+	order.resize(Profile_sources.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [](int a, int b) { return Profile_sources[a].timing.total_us > Profile_sources[b].timing.total_us; });
+
+	text += "\n";
+	print_header("Source");
+	for (int source : order) {
+		print_timing(Profile_sources[source].name.c_str(), Profile_sources[source].timing);
+	}
+
+	sprintf_concat(text, "\nLua memory: %.1f KB in use, %.1f KB peak, %.1f KB allocated in total\n", alloc_stats.bytes_in_use / 1024.0,
+		alloc_stats.peak_bytes / 1024.0, alloc_stats.bytes_allocated / 1024.0);
+	sprintf_concat(text, "Lua pool: %.1f KB, %d allocations in the last frame\n", alloc_stats.pooled_bytes / 1024.0,
+		alloc_stats.last_frame_allocations);
+	sprintf_concat(text, "Lua allocator calls: %" PRIu64 " allocations, %" PRIu64 " reallocations, %" PRIu64 " frees\n",
+		alloc_stats.allocations, alloc_stats.reallocations, alloc_stats.frees);
+
+	mprintf(("%s", text.c_str())); // log for ease for copying data
+	dc_printf("%s", text.c_str());
+}
+
+} // namespace scripting
+
+DCF(lua_profile, "Collects and shows timings of scripting hooks")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: lua_profile [arg]\nWhere arg can be any of the following:\n");
+		dc_printf("\ton         Starts collecting timings.\n");
+		dc_printf("\toff        Stops collecting timings.\n");
+		dc_printf("\treset      Clears the collected timings.\n");
+		dc_printf("\tbudget [x] Logs hooks taking longer than x ms in one frame. (Set to 0 to turn off.)\n");
+		dc_printf("\tWithout an argument, shows the collected timings and Lua memory usage.\n");
+		return;
+	}
+
+	if (dc_optional_string("on")) {
+		scripting::Profiling_enabled = true;
+		dc_printf("Hook profiling is on\n");
+	} else if (dc_optional_string("off")) {
+		scripting::Profiling_enabled = false;
+		dc_printf("Hook profiling is off\n");
+	} else if (dc_optional_string("reset")) {
+		scripting::hook_profiler_reset();
+		dc_printf("Hook timings cleared\n");
+	} else if (dc_optional_string("budget")) {
+		float budget;
+		dc_stuff_float(&budget);
+		Cmdline_lua_frame_budget = MAX(budget, 0.0f);
+		dc_printf("Frame budget per hook set to %.2f ms\n", Cmdline_lua_frame_budget);
+	} else {
+		scripting::hook_profiler_print(Script_system.GetAllocStats());
+	}
+}
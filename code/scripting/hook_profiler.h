@@ -0,0 +1,65 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+
+namespace scripting {
+
+// What the Lua state has allocated through its lua_Alloc function
+struct lua_alloc_stats {
+	size_t bytes_in_use = 0;
+	size_t peak_bytes = 0;
+	std::uint64_t bytes_allocated = 0;
+	std::uint64_t allocations = 0;
+	std::uint64_t reallocations = 0;
+	std::uint64_t frees = 0;
+
+	// memory the pool holds on to, whether it is in use or not
+	size_t pooled_bytes = 0;
+
+	// allocations and reallocations in the current and the last frame
+	int frame = -1;
+	int frame_allocations = 0;
+	int last_frame_allocations = 0;
+
+	// records one call of the allocator, result is what it returned
+	void record(const void* ptr, size_t osize, size_t nsize, const void* result);
+};
+
+// ----------------------------------------------------------------------------------------------
+// HOOK PROFILER
+//
+// Times every script action a hook runs, both per hook and per source (the table and hook, or the script that added the
+// action at runtime), and puts a trace scope named after the source around it.  Times include any hooks run from within
+// the action.  Timings are only collected while the profiler is turned on with the lua_profile debug command or a frame
+// budget is set with -lua_frame_budget, in which case a hook taking longer than the budget in a single frame is logged.
+//
+
+// registers a source, sources with the same name share their timings
+int hook_profiler_register_source(const char* name);
+
+bool hook_profiler_is_timing();
+
+class hook_profile_scope {
+	tracing::complete::ScopedCompleteEvent _trace_event;
+	int _hook_id;
+	int _source;
+	const lua_alloc_stats& _alloc_stats;
+	bool _timing = false;
+	std::uint64_t _start_us = 0;
+	std::uint64_t _start_allocated = 0;
+
+public:
+	hook_profile_scope(int hook_id, int source, const lua_alloc_stats& alloc_stats);
+	~hook_profile_scope();
+
+	hook_profile_scope(const hook_profile_scope&) = delete;
+	hook_profile_scope& operator=(const hook_profile_scope&) = delete;
+};
+
+void hook_profiler_reset();
+
+// writes the collected timings and the allocation statistics to the debug console and the log
+void hook_profiler_print(const lua_alloc_stats& alloc_stats);
+
+} // namespace scripting
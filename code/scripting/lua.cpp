@@ -102,16 +102,15 @@ const char* ScriptStateReferenceName = "SCP_ScriptState";
 
 // *************************Housekeeping*************************
 
-static void *vm_lua_alloc(void*, void *ptr, size_t, size_t nsize) {
-	if (nsize == 0)
-	{
-		vm_free(ptr);
-		return NULL;
-	}
-	else
-	{
-		return vm_realloc(ptr, nsize);
-	}
+void* script_state::LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+	auto state = static_cast<script_state*>(ud);
+
+	auto result = state->LuaPool.reallocate(ptr, osize, nsize);
+
+	state->LuaAllocStats.pooled_bytes = state->LuaPool.pooled_bytes();
+	state->LuaAllocStats.record(ptr, osize, nsize, result);
+	return result;
 }
 
 //kind of fake, prevents true file access (only allows pipes and stuff) and also returns nil on fail instead of error handling string
@@ -166,7 +165,11 @@ static int io_open_limited (lua_State *L) {
 int script_state::CreateLuaState()
 {
 	mprintf(("LUA: Opening LUA state...\n"));
-	lua_State *L = lua_newstate(vm_lua_alloc, nullptr);
+	// the pool and the statistics are shared with the old state until that is closed
+	if (LuaState == nullptr) {
+		LuaAllocStats = scripting::lua_alloc_stats();
+	}
+	lua_State *L = lua_newstate(LuaAlloc, this);
 
 	if(L == NULL)
 	{
@@ -0,0 +1,105 @@
+#include "scripting/lua_pool.h"
+
+namespace scripting {
+
+// ----------------------------------------------------------------------------------------------
+// LUA POOL ALLOCATOR FUNCTIONS
+//
+
+lua_pool_allocator::~lua_pool_allocator()
+{
+	clear();
+}
+
+void lua_pool_allocator::clear()
+{
+	for (auto chunk : Chunks) {
+		vm_free(chunk);
+	}
+	Chunks.clear();
+
+	for (auto& list : Free_lists) {
+		list = nullptr;
+	}
+}
+
+void lua_pool_allocator::add_chunk(size_t size_class)
+{
+	const size_t block_size = (size_class + 1) * SIZE_CLASS_GRANULARITY;
+	const size_t num_blocks = CHUNK_SIZE / block_size;
+
+	auto chunk = static_cast<ubyte*>(vm_malloc(CHUNK_SIZE));
+	Chunks.push_back(chunk);
+
+	// linked back to front so that blocks are handed out in address order
+	auto& list = Free_lists[size_class];
+	for (size_t i = num_blocks; i > 0; --i) {
+		auto block = reinterpret_cast<free_block*>(chunk + (i - 1) * block_size);
+		block->next = list;
+		list = block;
+	}
+}
+
+void* lua_pool_allocator::acquire(size_t size)
+{
+	if (!is_pooled(size)) {
+		return vm_malloc(size, memory::quiet_alloc);
+	}
+
+	auto size_class_idx = size_class(size);
+	if (Free_lists[size_class_idx] == nullptr) {
+		add_chunk(size_class_idx);
+	}
+
+	auto block = Free_lists[size_class_idx];
+	Free_lists[size_class_idx] = block->next;
+	return block;
+}
+
+void lua_pool_allocator::release(void* ptr, size_t size)
+{
+	if (!is_pooled(size)) {
+		vm_free(ptr);
+		return;
+	}
+
+	auto block = static_cast<free_block*>(ptr);
+	auto& list = Free_lists[size_class(size)];
+	block->next = list;
+	list = block;
+}
+
+void* lua_pool_allocator::reallocate(void* ptr, size_t osize, size_t nsize)
+{
+	if (nsize == 0) {
+		if (ptr != nullptr) {
+			release(ptr, osize);
+		}
+		return nullptr;
+	}
+
+	if (ptr == nullptr) {
+		return acquire(nsize);
+	}
+
+	if (is_pooled(osize) && is_pooled(nsize)) {
+		if (size_class(osize) == size_class(nsize)) {
+			return ptr;
+		}
+	} else if (!is_pooled(osize) && !is_pooled(nsize)) {
+		return vm_realloc(ptr, nsize, memory::quiet_alloc);
+	}
+
+	// moving between size classes or between the pool and the heap
+	auto new_ptr = acquire(nsize);
+	if (new_ptr == nullptr) {
+		// Lua expects the old block to be left alone if this fails
+		return nullptr;
+	}
+
+	memcpy(new_ptr, ptr, MIN(osize, nsize));
+	release(ptr, osize);
+	return new_ptr;
+}
+
+} // namespace scripting
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace scripting {
+
+// ----------------------------------------------------------------------------------------------
+// LUA POOL ALLOCATOR
+//
+// Scripts create and drop lots of small objects every frame, mostly the userdata the API hands out for vectors,
+// orientations and object handles, and the tables and strings around them.  Blocks up to MAX_POOLED_SIZE bytes are
+// rounded up to a multiple of SIZE_CLASS_GRANULARITY and taken from a free list for that size, which is filled by
+// carving up large chunks.  Chunks are only freed when the pool is cleared.  Lua tells the allocator the size of every
+// block it frees or resizes, so blocks do not need a header to find their size class.  Larger blocks go straight to
+// the heap.
+//
+
+class lua_pool_allocator
+{
+public:
+	static const size_t SIZE_CLASS_GRANULARITY = 16;
+	static const size_t MAX_POOLED_SIZE = 256;
+	static const size_t CHUNK_SIZE = 16 * 1024;
+
+	lua_pool_allocator() = default;
+	~lua_pool_allocator();
+
+	lua_pool_allocator(const lua_pool_allocator&) = delete;
+	lua_pool_allocator& operator=(const lua_pool_allocator&) = delete;
+
+	// works like a lua_Alloc function, osize has to be the size the block was last allocated with
+	void* reallocate(void* ptr, size_t osize, size_t nsize);
+
+	// frees all chunks, only valid once nothing taken from the pool is in use any more
+	void clear();
+
+	size_t pooled_bytes() const { return Chunks.size() * CHUNK_SIZE; }
+	size_t num_chunks() const { return Chunks.size(); }
+
+private:
+	static const size_t NUM_SIZE_CLASSES = MAX_POOLED_SIZE / SIZE_CLASS_GRANULARITY;
+
+	typedef struct free_block {
+		free_block* next;
+	} free_block;
+
+	static bool is_pooled(size_t size) { return size <= MAX_POOLED_SIZE; }
+	static size_t size_class(size_t size) { return (size - 1) / SIZE_CLASS_GRANULARITY; }
+
+	void* acquire(size_t size);
+	void release(void* ptr, size_t size);
+
+	void add_chunk(size_t size_class);
+
+	free_block* Free_lists[NUM_SIZE_CLASSES] = {};
+	SCP_vector<void*> Chunks;
+};
+
+} // namespace scripting
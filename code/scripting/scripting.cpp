@@ -407,6 +407,100 @@ int cache_condition(ConditionalType type, const SCP_string& value){
 //*************************CLASS: script_state*************************
 //Most of the icky stuff is here. Lots of #ifdefs
 
+// The hook variable names in use, shared by all script states.  Hooks are created during static initialization, so this
+// has to exist before the first one asks for an id.
+struct hook_variable_names
+{
+	SCP_vector<SCP_string> names;
+	SCP_unordered_map<SCP_string, int> ids;
+};
+
+static hook_variable_names& get_hook_variable_names()
+{
+	static hook_variable_names names;
+	return names;
+}
+
+int script_state::GetHookVarId(const char *name)
+{
+	auto& registry = get_hook_variable_names();
+
+	auto it = registry.ids.find(name);
+	if (it != registry.ids.end())
+		return it->second;
+
+	int id = static_cast<int>(registry.names.size());
+	registry.names.emplace_back(name);
+	registry.ids.emplace(name, id);
+	return id;
+}
+
+int script_state::FindHookVarId(const char *name)
+{
+	const auto& registry = get_hook_variable_names();
+
+	auto it = registry.ids.find(name);
+	return (it != registry.ids.end()) ? it->second : -1;
+}
+
+const SCP_string& script_state::GetHookVarName(int id)
+{
+	const auto& registry = get_hook_variable_names();
+	Assertion(id >= 0 && id < static_cast<int>(registry.names.size()), "Invalid hook variable id %d!", id);
+
+	return registry.names[id];
+}
+
+int script_state::GetNumHookVarIds()
+{
+	return static_cast<int>(get_hook_variable_names().names.size());
+}
+
+// Stores the value on top of the Lua stack as the new value of the hook variable and removes it from the stack
+void script_state::PushHookVar(int id)
+{
+	Assertion(id >= 0 && id < GetNumHookVarIds(), "Invalid hook variable id %d!", id);
+
+	if (id >= static_cast<int>(HookVariableValues.size()))
+		HookVariableValues.resize(id + 1);
+
+	auto& stack = HookVariableValues[id];
+	if (stack.depth == stack.values.size()) {
+		lua_pushboolean(LuaState, 0);
+		stack.values.push_back(luacpp::UniqueLuaReference::create(LuaState));
+		stack.is_nil.push_back(false);
+		lua_pop(LuaState, 1);
+	}
+
+	// reuse the reference of an earlier value instead of creating a new one
+	bool is_nil = lua_isnil(LuaState, -1);
+	if (is_nil) {
+		lua_pop(LuaState, 1);
+		lua_pushboolean(LuaState, 0);
+	}
+	lua_rawseti(LuaState, LUA_REGISTRYINDEX, stack.values[stack.depth]->getReference());
+	stack.is_nil[stack.depth] = is_nil;
+	stack.depth++;
+}
+
+bool script_state::IsHookVarSet(int id) const
+{
+	return id >= 0 && id < static_cast<int>(HookVariableValues.size()) && HookVariableValues[id].depth > 0;
+}
+
+bool script_state::PushHookVar(lua_State* L, int id) const
+{
+	if (!IsHookVarSet(id))
+		return false;
+
+	const auto& stack = HookVariableValues[id];
+	if (stack.is_nil[stack.depth - 1])
+		lua_pushnil(L);
+	else
+		stack.values[stack.depth - 1]->pushValue(L);
+	return true;
+}
+
 //WMC - defined in parse/scripting.h
 void script_state::SetHookObject(const char *name, object *objp)
 {
@@ -427,36 +521,40 @@ void script_state::SetHookObjects(int num, ...)
 		object* objp = va_arg(vl, object*);
 
 		ade_set_object_with_breed(LuaState, OBJ_INDEX(objp));
-		auto reference = luacpp::UniqueLuaReference::create(LuaState);
-		lua_pop(LuaState, 1); // Remove object value from the stack
-
-		HookVariableValues[name].push_back(std::move(reference));
+		PushHookVar(GetHookVarId(name));
 	}
 
 	va_end(vl);
 }
 
+void script_state::RemHookVar(int id)
+{
+	if (LuaState == nullptr || id < 0 || id >= static_cast<int>(HookVariableValues.size()))
+		return;
+
+	auto& stack = HookVariableValues[id];
+	if (stack.depth == 0) {
+		// Nothing to do
+		return;
+	}
+	stack.depth--;
+
+	// keep the reference for the next value, but do not keep the old one alive
+	lua_pushboolean(LuaState, 0);
+	lua_rawseti(LuaState, LUA_REGISTRYINDEX, stack.values[stack.depth]->getReference());
+}
+
 void script_state::RemHookVar(const char* name)
 {
-	this->RemHookVars({name});
+	RemHookVar(FindHookVarId(name));
 }
 
 void script_state::RemHookVars(std::initializer_list<SCP_string> names)
 {
-	if (LuaState != nullptr) {
-		for (const auto& hookVar : names) {
-			if (HookVariableValues[hookVar].empty()) {
-				// Nothing to do
-				continue;
-			}
-			HookVariableValues[hookVar].pop_back();
-		}
+	for (const auto& hookVar : names) {
+		RemHookVar(FindHookVarId(hookVar.c_str()));
 	}
 }
-const SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>>& script_state::GetHookVariableReferences()
-{
-	return HookVariableValues;
-}
 
 int script_state::LoadBm(const char* name)
 {
@@ -488,7 +586,81 @@ void script_state::UnloadImages()
 	ScriptImages.clear();
 }
 
-int script_state::RunCondition(int action_type, const std::any& local_condition_data)
+// Calls fnc for every action of the hook that can match the context, in order, until it returns false
+template <typename F>
+void script_state::ForEachCandidateAction(int action_type, const HookConditionContext& local_condition_data, F&& fnc)
+{
+	auto action_it = ConditionalHooks.find(action_type);
+	if (action_it == ConditionalHooks.end())
+		return;
+
+	// added hooks are only processed once no hook is running anymore, so neither of these changes in here
+	const auto& actions = action_it->second;
+
+	auto dispatch_it = ActionDispatch.find(action_type);
+	if (dispatch_it == ActionDispatch.end() || dispatch_it->second.keyed_condition == nullptr) {
+		for (const auto& action : actions) {
+			if (!fnc(action))
+				return;
+		}
+		return;
+	}
+	const auto& dispatch = dispatch_it->second;
+
+	// the actions without a key can always match, the others only if their key is one of the context's
+	const SCP_vector<int>* lists[1 + ParseableCondition::MAX_CONTEXT_KEYS];
+	size_t positions[1 + ParseableCondition::MAX_CONTEXT_KEYS] = {};
+	int num_lists = 0;
+
+	lists[num_lists++] = &dispatch.unkeyed_actions;
+
+	int keys[ParseableCondition::MAX_CONTEXT_KEYS];
+	int num_keys = dispatch.keyed_condition->getContextKeys(local_condition_data, keys);
+	Assertion(num_keys <= ParseableCondition::MAX_CONTEXT_KEYS, "Hook condition returned too many context keys!");
+
+	for (int i = 0; i < num_keys; ++i) {
+		if (keys[i] < 0 || std::find(keys, keys + i, keys[i]) != keys + i)
+			continue;
+
+		auto keyed_it = dispatch.keyed_actions.find(keys[i]);
+		if (keyed_it != dispatch.keyed_actions.end())
+			lists[num_lists++] = &keyed_it->second;
+	}
+
+	// merge the lists back into the order the actions were added in
+	for (;;) {
+		int next = -1;
+		for (int i = 0; i < num_lists; ++i) {
+			if (positions[i] < lists[i]->size() && (next < 0 || (*lists[i])[positions[i]] < next))
+				next = (*lists[i])[positions[i]];
+		}
+
+		if (next < 0)
+			return;
+
+		for (int i = 0; i < num_lists; ++i) {
+			if (positions[i] < lists[i]->size() && (*lists[i])[positions[i]] == next)
+				positions[i]++;
+		}
+
+		if (!fnc(actions[next]))
+			return;
+	}
+}
+
+bool script_state::AnyConditionValid(int action_type, const HookConditionContext& local_condition_data)
+{
+	bool found = false;
+
+	ForEachCandidateAction(action_type, local_condition_data, [&](const script_action& action) {
+		found = action.ConditionsValid(local_condition_data);
+		return !found;
+	});
+
+	return found;
+}
+
+int script_state::RunCondition(int action_type, const HookConditionContext& local_condition_data, HookVariableSetup* hook_vars)
 {
 	TRACE_SCOPE(tracing::LuaHooks);
 	int num = 0;
@@ -497,44 +669,70 @@ int script_state::RunCondition(int action_type, const std::any& local_condition_
 		return num;
 	}
 
-	auto action_it = ConditionalHooks.find(action_type);
-	if (action_it == ConditionalHooks.end())
-		return num;
+	RunningConditions++;
 
-	for(const auto& action : action_it->second) 
-	{
+	ForEachCandidateAction(action_type, local_condition_data, [&](const script_action& action) {
 		if (action.ConditionsValid(local_condition_data))
 		{
+			// the hook variables are only needed once something runs
+			if (num == 0 && hook_vars != nullptr)
+				hook_vars->set();
+
+			hook_profile_scope profile(action_type, action.profile_source, LuaAllocStats);
 			RunBytecode(action.hook.hook_function);
 			num++;
 		}
-	}
+		return true;
+	});
+
+	if (num > 0 && hook_vars != nullptr)
+		hook_vars->remove();
 
-	ProcessAddedHooks();
+	RunningConditions--;
+
+	if (RunningConditions == 0)
+		ProcessAddedHooks();
 	return num;
 }
 
-bool script_state::IsConditionOverride(int action_type, const std::any& local_condition_data)
+bool script_state::IsConditionOverride(int action_type, const HookConditionContext& local_condition_data, HookVariableSetup* hook_vars)
 {
-	auto action_it = ConditionalHooks.find(action_type);
-	if (action_it == ConditionalHooks.end())
-		return false;
+	bool ret_val = false;
+	bool vars_set = false;
 
-	for (const auto& action : action_it->second)
-	{
+	RunningConditions++;
+
+	ForEachCandidateAction(action_type, local_condition_data, [&](const script_action& action) {
 		if (action.ConditionsValid(local_condition_data))
 		{
+			// the hook variables are only needed once something runs
+			if (!vars_set && hook_vars != nullptr) {
+				hook_vars->set();
+				vars_set = true;
+			}
+
+			hook_profile_scope profile(action_type, action.profile_source, LuaAllocStats);
 			if (IsOverride(action.hook))
-				return true;
+				ret_val = true;
 		}
-	}
-	return false;
+		return !ret_val;
+	});
+
+	if (vars_set)
+		hook_vars->remove();
+
+	RunningConditions--;
+
+	if (RunningConditions == 0)
+		ProcessAddedHooks();
+	return ret_val;
 }
 
 void script_state::Clear()
 {
 	// Free all lua value references
 	ConditionalHooks.clear();
+	AddedHooks.clear();
 	HookVariableValues.clear();
 
 	AssayActions();
@@ -543,6 +741,7 @@ void script_state::Clear()
 		OnStateDestroy(LuaState);
 
 		lua_close(LuaState);
+		LuaPool.clear();
 	}
 
 	StateName[0] = '\0';
@@ -839,7 +1038,7 @@ ConditionalType scripting_string_to_condition(const char* condition)
 	return CHC_NONE;
 }
 
-bool script_action::ConditionsValid(const std::any& local_condition_data) const {
+bool script_action::ConditionsValid(const HookConditionContext& local_condition_data) const {
 	for (const auto& global_condition : global_conditions) {
 		if (!global_condition_valid(global_condition))
 			return false;
@@ -858,6 +1057,10 @@ void script_state::ParseGlobalChunk(ConditionalActions hookType, const char* deb
 
 	ParseChunk(&sat.hook, debug_str);
 
+	SCP_string source_name;
+	sprintf(source_name, "%s - %s", Current_filename, debug_str != nullptr ? debug_str : "<Unknown>");
+	sat.profile_source = hook_profiler_register_source(source_name.c_str());
+
 	if (parentHook && parentHook->getDeprecation()) {
 		const auto& deprecation = *parentHook->getDeprecation();
 		bool shownWarn = false;
@@ -886,7 +1089,7 @@ void script_state::ParseGlobalChunk(ConditionalActions hookType, const char* deb
 		}
 	}
 
-	ConditionalHooks[hookType].emplace_back(std::move(sat));
+	AddConditionedHook(hookType, std::move(sat));
 }
 bool script_state::ParseCondition(const char *filename)
 {
@@ -931,6 +1134,7 @@ bool script_state::ParseCondition(const char *filename)
 		sprintf(buf, "%s - %s", filename, currHook->getHookName().c_str());
 
 		ParseChunk(&sat.hook, buf.c_str());
+		sat.profile_source = hook_profiler_register_source(buf.c_str());
 
 		sat.global_conditions = parsed_conditions;
 		for (const SCP_string& local_condition : conditions) {
@@ -998,6 +1202,9 @@ void script_state::AddConditionedHook(int action_id, script_action hook) {
 }
 
 void script_state::ProcessAddedHooks() {
+	if (AddedHooks.empty())
+		return;
+
 	for (auto& hook : AddedHooks) {
 		auto& conditionalHooks = ConditionalHooks[hook.first];
 		conditionalHooks.insert(conditionalHooks.end(), std::make_move_iterator(hook.second.begin()), std::make_move_iterator(hook.second.end()));
@@ -1013,9 +1220,63 @@ void script_state::AddGameInitFunction(script_function func) { GameInitFunctions
 // AssayActions() after modifying ConditionalHooks before returning to normal operation of the scripting system!
 void script_state::AssayActions() {
 	ActiveActions.clear();
+	ActionDispatch.clear();
 
 	for (const auto &hook : ConditionalHooks) {
 		ActiveActions[hook.first] = !hook.second.empty();
+		BuildActionDispatch(hook.first);
+	}
+}
+
+// Groups the actions of a hook by the dispatchable condition most of them use
+void script_state::BuildActionDispatch(int action_type) {
+	const auto& actions = ConditionalHooks[action_type];
+
+	SCP_vector<std::pair<const ParseableCondition*, int>> counts;
+	const ParseableCondition* best = nullptr;
+	int best_count = 0;
+
+	for (const auto& action : actions) {
+		for (const auto& local_condition : action.local_conditions) {
+			int key;
+			auto condition = local_condition->getDispatchKey(key);
+			if (condition == nullptr)
+				continue;
+
+			auto it = std::find_if(counts.begin(), counts.end(), [condition](const std::pair<const ParseableCondition*, int>& entry) {
+				return entry.first == condition;
+			});
+			if (it == counts.end())
+				it = counts.emplace(counts.end(), condition, 0);
+
+			// ties go to whichever came first, so that the result does not depend on pointer values
+			if (++it->second > best_count) {
+				best = condition;
+				best_count = it->second;
+			}
+		}
+	}
+
+	if (best == nullptr)
+		return;
+
+	auto& dispatch = ActionDispatch[action_type];
+	dispatch.keyed_condition = best;
+
+	for (int i = 0; i < static_cast<int>(actions.size()); ++i) {
+		bool keyed = false;
+
+		for (const auto& local_condition : actions[i].local_conditions) {
+			int key;
+			if (local_condition->getDispatchKey(key) == best) {
+				dispatch.keyed_actions[key].push_back(i);
+				keyed = true;
+				break;
+			}
+		}
+
+		if (!keyed)
+			dispatch.unkeyed_actions.push_back(i);
 	}
 }
 
@@ -8,6 +8,8 @@
 #include "scripting/ade.h"
 #include "scripting/ade_args.h"
 #include "scripting/hook_conditions.h"
+#include "scripting/hook_profiler.h"
+#include "scripting/lua_pool.h"
 #include "scripting/lua/LuaFunction.h"
 #include "utils/event.h"
 
@@ -20,6 +22,15 @@
 namespace scripting {
 struct ScriptingDocumentation;
 class HookBase;
+
+// Sets the hook variables of one hook run, RunCondition() only does so once an action matches
+class HookVariableSetup {
+  public:
+	virtual ~HookVariableSetup() = default;
+
+	virtual void set() = 0;
+	virtual void remove() = 0;
+};
 }
 
 struct image_desc
@@ -112,8 +123,29 @@ public:
 	SCP_vector<std::unique_ptr<scripting::EvaluatableCondition>> local_conditions;
 
 	script_hook hook;
+	// where the hook came from, for the hook profiler
+	int profile_source = -1;
 
-	bool ConditionsValid(const std::any& local_condition_data) const;
+	bool ConditionsValid(const scripting::HookConditionContext& local_condition_data) const;
+};
+
+// The actions of one hook, grouped by the key of the condition most of them are restricted by, so that running the hook
+// only has to look at the actions that can possibly match.  All lists hold indices into the hook's actions in order.
+struct script_action_dispatch
+{
+	const scripting::ParseableCondition* keyed_condition = nullptr;
+	SCP_unordered_map<int, SCP_vector<int>> keyed_actions;
+	SCP_vector<int> unkeyed_actions;
+};
+
+// The value stack of a single hook variable.  References above the current depth are kept around to be reused.
+struct hook_variable_stack
+{
+	// the registry slots of the values are never left nil, since luaL_ref() could hand out a slot with a nil hole in it
+	// again, so nil values and unused slots hold false and nil values are marked in is_nil instead
+	SCP_vector<luacpp::LuaReference> values;
+	SCP_vector<bool> is_nil;
+	size_t depth = 0;
 };
 
 //**********Main script_state function
@@ -132,21 +164,35 @@ class script_state
 	// Scripts can add new hooks at runtime; we collect all hooks to be added here and add them at the end of the current
 	// frame to avoid corrupting any iterators that the script system may be using.
 	SCP_unordered_map<int, SCP_vector<script_action>> AddedHooks;
+	SCP_unordered_map<int, script_action_dispatch> ActionDispatch;
+	// how many hooks are running right now, added hooks are only processed once the outermost one is done
+	int RunningConditions = 0;
 
 	SCP_vector<script_function> GameInitFunctions;
 
-	// Stores references to the Lua values for the hook variables. Uses a raw reference since we do not need the more
-	// advanced features of LuaValue
+	// Stores references to the Lua values for the hook variables, indexed by the id of the variable name. Uses a raw
+	// reference since we do not need the more advanced features of LuaValue
 	// values are a vector to provide a stack of values. This is necessary to ensure consistent behavior if a scripting
 	// hook is called from within another script (e.g. calls to createShip)
-	SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>> HookVariableValues;
+	SCP_vector<hook_variable_stack> HookVariableValues;
 
 	// ActiveActions lets code that might run scripting hooks know whether any scripts are even registered for it.
 	// AssayActions is responsible for keeping it up to date.
 	SCP_unordered_map<int, bool> ActiveActions;
 
+	// small blocks of the Lua state come from the pool, LuaAlloc fills in the statistics
+	scripting::lua_pool_allocator LuaPool;
+	scripting::lua_alloc_stats LuaAllocStats;
+
+	static void* LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
 	void ParseChunkSub(script_function& out_func, const char* debug_str=NULL);
 
+	void PushHookVar(int id);
+	void BuildActionDispatch(int action_type);
+	template <typename F>
+	void ForEachCandidateAction(int action_type, const scripting::HookConditionContext& local_condition_data, F&& fnc);
+
 	void SetLuaSession(struct lua_State *L);
 
 	static void OutputLuaDocumentation(scripting::ScriptingDocumentation& doc,
@@ -171,6 +217,7 @@ public:
 	void UnloadImages();
 
 	lua_State *GetLuaSession(){return LuaState;}
+	const scripting::lua_alloc_stats& GetAllocStats() const { return LuaAllocStats; }
 
 	//***Init functions for langs
 	int CreateLuaState();
@@ -181,14 +228,25 @@ public:
 	//***Moves data
 	//void MoveData(script_state &in);
 
+	// Hook variable names are turned into ids once, so that hooks can set them without looking up any strings
+	static int GetHookVarId(const char *name);
+	static int FindHookVarId(const char *name);
+	static const SCP_string& GetHookVarName(int id);
+	static int GetNumHookVarIds();
+
+	template<typename T>
+	void SetHookVar(int id, char format, T&& value);
 	template<typename T>
 	void SetHookVar(const char *name, char format, T&& value);
 	void SetHookObject(const char *name, object *objp);
 	void SetHookObjects(int num, ...);
+	void RemHookVar(int id);
 	void RemHookVar(const char *name);
 	void RemHookVars(std::initializer_list<SCP_string> names);
 
-	const SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>>& GetHookVariableReferences();
+	bool IsHookVarSet(int id) const;
+	// pushes the current value of the hook variable and returns true, or returns false if it is not set
+	bool PushHookVar(lua_State* L, int id) const;
 
 	//***Hook creation functions
 	template <typename T>
@@ -209,8 +267,9 @@ public:
 	int RunBytecode(const script_function& hd, char format = '\0', T* data = nullptr);
 	int RunBytecode(const script_function& hd);
 	bool IsOverride(const script_hook &hd);
-	int RunCondition(int action_type, const std::any& local_condition_data);
-	bool IsConditionOverride(int action_type, const std::any& local_condition_data);
+	bool AnyConditionValid(int action_type, const scripting::HookConditionContext& local_condition_data);
+	int RunCondition(int action_type, const scripting::HookConditionContext& local_condition_data, scripting::HookVariableSetup* hook_vars = nullptr);
+	bool IsConditionOverride(int action_type, const scripting::HookConditionContext& local_condition_data, scripting::HookVariableSetup* hook_vars = nullptr);
 
 	void RunInitFunctions();
 
@@ -222,7 +281,7 @@ public:
 };
 
 template<typename T>
-void script_state::SetHookVar(const char *name, char format, T&& value)
+void script_state::SetHookVar(int id, char format, T&& value)
 {
 	if(format == '\0')
 		return;
@@ -231,13 +290,16 @@ void script_state::SetHookVar(const char *name, char format, T&& value)
 	{
 		char fmt[2] = {format, '\0'};
 		::scripting::ade_set_args(LuaState, fmt, std::forward<T>(value));
-		auto reference = luacpp::UniqueLuaReference::create(LuaState);
-		lua_pop(LuaState, 1); // Remove object value from the stack
-
-		HookVariableValues[name].push_back(std::move(reference));
+		PushHookVar(id);
 	}
 }
 
+template<typename T>
+void script_state::SetHookVar(const char *name, char format, T&& value)
+{
+	SetHookVar(GetHookVarId(name), format, std::forward<T>(value));
+}
+
 template <typename T>
 bool script_state::EvalStringWithReturn(const char* string, const char* format, T* rtn, const char* debug_str)
 {
@@ -38,10 +38,19 @@ typedef struct awacs_entry {
 	int team;
 	ship_subsys *subsys;
 	object *objp;
+	vec3d pos;			// world position of the subsystem, updated once per frame
+	bool pos_valid;
 } awacs_entry;
 static awacs_entry Awacs[MAX_AWACS];
 static int Awacs_count = 0;
 
+// AWACS COVERAGE
+// whether a target is in range of any AWACS source of a team does not depend on the viewer, so awacs_process() computes
+// it once per frame for every target and team, and the HUD, radar and AI only read it
+
+static SCP_vector<std::bitset<MAX_OBJECTS>> Awacs_coverage_by_team;
+static int Awacs_coverage_signature[MAX_OBJECTS];	// signature of the object the coverage is for, -1 if there is none
+
 // TEAM SHIP VISIBILITY
 // team-wide shared visibility info
 // at start of each frame (maybe timestamp), compute visibility 
@@ -58,6 +67,9 @@ void awacs_update_all_levels();
 // update team visibility info
 void team_visibility_update();
 
+// update the AWACS coverage of all objects
+void awacs_update_coverage();
+
 
 // ----------------------------------------------------------------------------------------------------
 // AWACS FUNCTIONS
@@ -75,30 +87,42 @@ void awacs_level_init()
 		Awacs_team.reserve(Iff_info.size());
 		Ship_visibility_by_team.reserve(Iff_info.size());
 
+		Awacs_coverage_by_team.reserve(Iff_info.size());
+
 		for (auto idx = 0; idx < (int)Iff_info.size(); idx++) {
 			Awacs_team.push_back(0.0f);
 			Ship_visibility_by_team.emplace_back();
+			Awacs_coverage_by_team.emplace_back();
 		}
 
 		arrays_initted = true;
 	}
+
+	Awacs_count = 0;
+	std::fill(std::begin(Awacs_coverage_signature), std::end(Awacs_coverage_signature), -1);
 }
 
 // call every frame to process AWACS details
 void awacs_process()
 {
 	// if we need to update total AWACS levels, do so now
-	if (timestamp_elapsed(Awacs_stamp))
+	bool update_levels = timestamp_elapsed(Awacs_stamp);
+
+	if (update_levels)
 	{
 		// reset the timestamp
 		Awacs_stamp = _timestamp(AWACS_STAMP_TIME);
 
 		// recalculate everything
 		awacs_update_all_levels();
+	}
+
+	// everything may have moved since the last frame
+	awacs_update_coverage();
 
-		// update team visibility
+	// update team visibility, which needs the coverage of this frame
+	if (update_levels)
 		team_visibility_update();
-	}
 }
 
 
@@ -173,6 +197,93 @@ void awacs_update_all_levels()
 #endif
 }
 
+// determine if the target is within range of any AWACS source of the team
+static bool awacs_team_covers_sub(const object *target, int team, bool check_huge_ship)
+{
+	for (int idx = 0; idx < Awacs_count; idx++)
+	{
+		// if not on the same team as the viewer
+		if (Awacs[idx].team != team || !Awacs[idx].pos_valid)
+			continue;
+
+		const vec3d *subsys_pos = &Awacs[idx].pos;
+		float radius = Awacs[idx].subsys->awacs_radius;
+
+		// special case for HUGE_SHIPS
+		if (check_huge_ship)
+		{
+			// check if inside bbox expanded by awacs_radius
+			if (check_world_pt_in_expanded_ship_bbox(subsys_pos, target, radius))
+				return true;
+		}
+		// not a huge ship
+		else
+		{
+			// cull sources which are too far away on any axis before computing the distance
+			if (fl_abs(subsys_pos->xyz.x - target->pos.xyz.x) > radius || fl_abs(subsys_pos->xyz.y - target->pos.xyz.y) > radius
+				|| fl_abs(subsys_pos->xyz.z - target->pos.xyz.z) > radius)
+				continue;
+
+			if (vm_vec_dist_quick(subsys_pos, &target->pos) <= radius)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+// update the AWACS coverage of all objects
+void awacs_update_coverage()
+{
+	// get the positions of all AWACS sources for this frame
+	for (int idx = 0; idx < Awacs_count; idx++)
+	{
+		// if this awacs source has somehow become invalid
+		if (Awacs[idx].objp->type != OBJ_SHIP)
+		{
+			Awacs[idx].pos_valid = false;
+			continue;
+		}
+
+		Awacs[idx].pos_valid = get_subsystem_pos(&Awacs[idx].pos, Awacs[idx].objp, Awacs[idx].subsys) != 0;
+	}
+
+	std::fill(std::begin(Awacs_coverage_signature), std::end(Awacs_coverage_signature), -1);
+
+	// coverage is only ever looked up in these cases, see awacs_get_level()
+	bool nebula_enabled = The_mission.flags[Mission::Mission_Flags::Fullneb];
+
+	for (auto objp : list_range(&obj_used_list))
+	{
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		auto shipp = ((objp->type == OBJ_SHIP) && (objp->instance >= 0)) ? &Ships[objp->instance] : nullptr;
+		if (!nebula_enabled && !(shipp && shipp->flags[Ship::Ship_Flags::Stealth]))
+			continue;
+
+		int objnum = OBJ_INDEX(objp);
+		bool check_huge_ship = shipp && Ship_info[shipp->ship_info_index].is_huge_ship();
+
+		for (int team = 0; team < (int)Awacs_coverage_by_team.size(); team++)
+			Awacs_coverage_by_team[team][objnum] = awacs_team_covers_sub(objp, team, check_huge_ship);
+
+		Awacs_coverage_signature[objnum] = objp->signature;
+	}
+}
+
+// whether any AWACS source of the team covers the target this frame
+static bool awacs_team_covers(const object *target, int team, bool check_huge_ship)
+{
+	int objnum = OBJ_INDEX(target);
+
+	if (Awacs_coverage_signature[objnum] == target->signature)
+		return Awacs_coverage_by_team[team][objnum];
+
+	// the target was created or became stealthy after awacs_process() ran this frame
+	return awacs_team_covers_sub(target, team, check_huge_ship);
+}
+
 // get the total AWACS level for target to viewer
 // < 0.0f		: untargetable
 // 0.0 - 1.0f	: marginally targetable
@@ -182,11 +293,10 @@ float awacs_get_level(const object *target, const ship *viewer, bool use_awacs)
 	Assert(target);	// Goober5000
 	Assert(viewer);	// Goober5000
 
-	vec3d dist_vec, subsys_pos;
-	float closest = 0.0f;
+	vec3d dist_vec;
 	float test;
-	int closest_index = -1;
-	int idx, stealth_ship = 0, check_huge_ship = 0, friendly_stealth_invisible = 0;
+	bool in_awacs_range = false;
+	int stealth_ship = 0, check_huge_ship = 0, friendly_stealth_invisible = 0;
 	ship *shipp = nullptr;
 	ship_info *sip = nullptr;
 
@@ -252,60 +362,17 @@ const     float FULLY_TARGETABLE        = (viewer_has_primitive_sensors ? ((dist
 	}
 	
 	// only check for Awacs if stealth ship or Nebula mission
-	// determine the closest awacs on our team
+	// determine if any awacs on our team covers the target
 	if ((stealth_ship || nebula_enabled) && use_awacs)
 	{
-		for (idx=0; idx<Awacs_count; idx++)
-		{
-			// if not on the same team as the viewer
-			if (Awacs[idx].team != viewer->team)
-				continue;
-
-			// if this awacs source has somehow become invalid
-			if (Awacs[idx].objp->type != OBJ_SHIP)
-				continue;
-
-			// get the subsystem position
-			if (!get_subsystem_pos(&subsys_pos, Awacs[idx].objp, Awacs[idx].subsys))
-				continue;
-
-			// determine if its the closest
-			// special case for HUGE_SHIPS
-			if (check_huge_ship)
-			{
-				// check if inside bbox expanded by awacs_radius
-				if (check_world_pt_in_expanded_ship_bbox(&subsys_pos, target, Awacs[idx].subsys->awacs_radius))
-				{
-					closest_index = idx;
-					break;
-				}
-			}
-			// not a huge ship
-			else
-			{
-				// get distance from Subsys to target
-				vm_vec_sub(&dist_vec, &subsys_pos, &target->pos);
-				test = vm_vec_mag_quick(&dist_vec);
-
-				if (test > Awacs[idx].subsys->awacs_radius)
-					continue;
-
-				// coverity[dead_error_line:FALSE] - closest_index will be a value other than -1 on future loop iterations
-				if ((closest_index == -1) || (test < closest))
-				{
-					closest = test;
-					closest_index = idx;
-					break;
-				}
-			}
-		}
+		in_awacs_range = awacs_team_covers(target, viewer->team, check_huge_ship != 0);
 	}
 
 	// if this is a stealth ship
 	if (stealth_ship)
 	{
 		// if the ship is within range of an awacs
-		if (closest_index >= 0)
+		if (in_awacs_range)
 		{
 			// if the nebula effect is active, stealth ships are only partially targetable
 			if (nebula_enabled)
@@ -328,7 +395,7 @@ const     float FULLY_TARGETABLE        = (viewer_has_primitive_sensors ? ((dist
 			return FULLY_TARGETABLE;
 
 		// if the object is within range of an awacs, it's fully targetable
-		if (closest_index >= 0)
+		if (in_awacs_range)
 			return FULLY_TARGETABLE;
 
 
@@ -30,7 +30,8 @@ class ship;
 // call when initializing level, before parsing mission
 void awacs_level_init();
 
-// call every frame to process AWACS details
+// call every frame to process AWACS details, this also works out which objects each team's AWACS covers this frame,
+// so that awacs_get_level() and ship_is_visible_by_team() only read and can be called from several threads at once
 void awacs_process();
 
 // get the total AWACS level for target to viewer
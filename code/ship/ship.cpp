@@ -85,6 +85,8 @@
 #include "ship/shipcontrails.h"
 #include "ship/shipfx.h"
 #include "ship/shiphit.h"
+#include "ship/subsysbounds.h"
+#include "ship/subsyspool.h"
 #include "ship/subsysdamage.h"
 #include "species_defs/species_defs.h"
 #include "tracing/Monitor.h"
@@ -112,11 +114,8 @@ using namespace Ship;
 												//    have warped in.   So I put code in the paging code which knows all ships
 												//    that will warp in.
 
-static int Num_ship_subsystems = 0;
-static int Num_ship_subsystems_allocated = 0;
-
-static SCP_vector<ship_subsys*> Ship_subsystems;
-ship_subsys ship_subsys_free_list;
+// each ship gets its subsystems as one contiguous block out of this pool
+static ship_subsys_pool Ship_subsystem_pool(NUM_SHIP_SUBSYSTEMS_PER_SET);
 
 // The minimum required fuel to engage afterburners
 static const float DEFAULT_MIN_AFTERBURNER_FUEL_TO_ENGAGE = 10.0f;
@@ -6776,7 +6775,7 @@ void ship_init()
 		}
 
 		// We shouldn't already have any subsystem pointers at this point.
-		Assertion(Ship_subsystems.empty(), "Some pre-allocated subsystems didn't get cleared out: " SIZE_T_ARG " batches present during ship_init(); get a coder!\n", Ship_subsystems.size());
+		Assertion(Ship_subsystem_pool.num_chunks() == 0, "Some pre-allocated subsystems didn't get cleared out: " SIZE_T_ARG " batches present during ship_init(); get a coder!\n", Ship_subsystem_pool.num_chunks());
 	
 		radar_check_2d_icon_options();
 	}
@@ -6786,63 +6785,48 @@ static int Man_thruster_reset_timestamp = 0;
 
 static void ship_clear_subsystems()
 {
-	for (auto it = Ship_subsystems.begin(); it != Ship_subsystems.end(); ++it) {
-		delete[] *it;
-	}
-	Ship_subsystems.clear();
-
-	Num_ship_subsystems = 0;
-	Num_ship_subsystems_allocated = 0;
+	Ship_subsystem_pool.clear();
 }
 
-static int ship_allocate_subsystems(int num_so, bool page_in = false)
+/**
+ * Make sure that num_so subsystems can be handed out without growing the pool, used to
+ * grab as much as possible before mission start.
+ */
+static int ship_reserve_subsystems(int num_so)
 {
-	int i;
-	int num_subsystems_save = 0;
-
 	// "0" itself is safe
 	if (num_so < 0) {
 		Int3();
 		return 0;
 	}
 
-	// allow a page-in thingy, so that we can grab as much as possible before mission
-	// start, but without messing up our count for future things
-	if (page_in)
-		num_subsystems_save = Num_ship_subsystems;
-
-	Num_ship_subsystems += num_so;
-
-	// bail if we don't actually need any more
-	if ( Num_ship_subsystems < Num_ship_subsystems_allocated )
-		return 1;
-
-	mprintf(("Allocating space for at least %i new ship subsystems ... ", num_so));
-
-	// we might need more than one set worth of new subsystems, so make as many as required
-	do {
-		ship_subsys* new_batch = new ship_subsys[NUM_SHIP_SUBSYSTEMS_PER_SET];
-		Ship_subsystems.push_back(new_batch);
+	if (Ship_subsystem_pool.reserve(num_so)) {
+		mprintf(("Allocated space for at least %i new ship subsystems, a total of %i is now available (%i in-use).\n", num_so, Ship_subsystem_pool.num_allocated(), Ship_subsystem_pool.num_in_use()));
+	}
 
-		// append the new set to our free list
-		for (i = 0; i < NUM_SHIP_SUBSYSTEMS_PER_SET; i++)
-			list_append( &ship_subsys_free_list, &new_batch[i] );
+	return 1;
+}
 
-		Num_ship_subsystems_allocated += NUM_SHIP_SUBSYSTEMS_PER_SET;
-	} while ( (Num_ship_subsystems - Num_ship_subsystems_allocated) > 0 );
+/**
+ * Get a contiguous block of num_so subsystems for a ship.  Blocks never move, so pointers to them stay valid
+ * until the ship gives them back in ship_subsystems_delete().
+ */
+static ship_subsys *ship_allocate_subsystems(int num_so)
+{
+	// "0" itself is safe
+	if (num_so < 0) {
+		Int3();
+		return nullptr;
+	}
 
-	if (page_in)
-		Num_ship_subsystems = num_subsystems_save;
+	int num_allocated = Ship_subsystem_pool.num_allocated();
+	auto block = Ship_subsystem_pool.allocate(num_so);
 
-	// because the Ship_subsystems vector changed, it might have moved in memory, so invalidate all the subsystem caches
-	for (auto so : list_range(&Ship_obj_list))
-	{
-		// don't skip should-be-dead ships for this flag removal
-		Ships[Objects[so->objnum].instance].flags.remove(Ship::Ship_Flags::Subsystem_cache_valid);
+	if (Ship_subsystem_pool.num_allocated() != num_allocated) {
+		mprintf(("Allocated space for at least %i new ship subsystems, a total of %i is now available (%i in-use).\n", num_so, Ship_subsystem_pool.num_allocated(), Ship_subsystem_pool.num_in_use()));
 	}
 
-	mprintf(("a total of %i is now available (%i in-use).\n", Num_ship_subsystems_allocated, Num_ship_subsystems));
-	return 1;
+	return block;
 }
 
 /**
@@ -6855,6 +6839,7 @@ void ship_level_init()
 	// Reset everything between levels
 	Ships_exited.clear(); 
 	Ships_exited.reserve(100);
+	subsys_bounds_level_init();
 	for (i=0; i<MAX_SHIPS; i++ )
 	{
 		Ships[i].ship_name[0] = '\0';
@@ -6899,7 +6884,6 @@ void ship_level_init()
 
 	// Empty the subsys list
 	ship_clear_subsystems();
-	list_init( &ship_subsys_free_list );
 
 	Laser_energy_out_snd_timer = 1;
 	Missile_out_snd_timer		= 1;
@@ -7259,6 +7243,8 @@ void ship::clear()
 	// since these aren't cleared by clear()
 	subsys_list.next = NULL;
 	subsys_list.prev = NULL;
+	subsys_block = nullptr;
+	num_subsys_block = 0;
 
 	memset(&subsys_info, 0, SUBSYSTEM_MAX * sizeof(ship_subsys_info));
 
@@ -7691,7 +7677,7 @@ static void ship_set(int ship_index, int objnum, int ship_type)
 	if (!subsys_set(objnum))
 	{
 		char err_msg[512]; 
-		sprintf (err_msg, "Unable to allocate ship subsystems, which shouldn't be possible anymore. Current allocation is %d (%d in use). No subsystems have been assigned to %s.", Num_ship_subsystems_allocated, Num_ship_subsystems, shipp->ship_name);
+		sprintf (err_msg, "Unable to allocate ship subsystems, which shouldn't be possible anymore. Current allocation is %d (%d in use). No subsystems have been assigned to %s.", Ship_subsystem_pool.num_allocated(), Ship_subsystem_pool.num_in_use(), shipp->ship_name);
 
 		if (Fred_running) 
 			os::dialogs::Message(os::dialogs::MESSAGEBOX_ERROR, err_msg);
@@ -8102,8 +8088,10 @@ static int subsys_set(int objnum, int ignore_subsys_info)
 	shipp->subsys_list_indexer.reset();
 	shipp->flags.remove(Ship::Ship_Flags::Subsystem_cache_valid);
 
-	// make sure to have allocated the number of subsystems we require
-	if (!ship_allocate_subsystems( sinfo->n_subsystems )) {
+	// get one contiguous block for all the subsystems we require; the list is linked through it in order
+	shipp->subsys_block = ship_allocate_subsystems( sinfo->n_subsystems );
+	shipp->num_subsys_block = 0;
+	if ((shipp->subsys_block == nullptr) && (sinfo->n_subsystems > 0)) {
 		return 0;
 	}
 
@@ -8126,9 +8114,7 @@ static int subsys_set(int objnum, int ignore_subsys_info)
 		}
 
 		// set up the linked list
-		ship_system = GET_FIRST( &ship_subsys_free_list );		// get a new element from the ship_subsystem array
-		Assert ( ship_system != &ship_subsys_free_list );		// shouldn't have the dummy element
-		list_remove( ship_subsys_free_list, ship_system );		// remove the element from the array
+		ship_system = &shipp->subsys_block[shipp->num_subsys_block++];	// take the next element of the block
 		list_append( &shipp->subsys_list, ship_system );		// link the element into the ship
 		ship_system->clear();									// initialize it to a known blank slate
 
@@ -8381,6 +8367,12 @@ static int subsys_set(int objnum, int ignore_subsys_info)
 			model_set_submodel_instance_motion_info(&pm->submodel[model_system->subobj_num], ship_system->submodel_instance_1);
 	}
 
+	// give back whatever wasn't linked
+	Ship_subsystem_pool.release(shipp->subsys_block + shipp->num_subsys_block, sinfo->n_subsystems - shipp->num_subsys_block);
+	if (shipp->num_subsys_block == 0) {
+		shipp->subsys_block = nullptr;
+	}
+
 	if ( !ignore_subsys_info ) {
 		ship_recalc_subsys_strength( shipp );
 	}
@@ -8913,16 +8905,13 @@ static void ship_subsystems_delete(ship *shipp)
 {
 	if ( NOT_EMPTY(&shipp->subsys_list) )
 	{
-		ship_subsys *systemp, *temp;
+		Assertion(GET_FIRST(&shipp->subsys_list) == shipp->subsys_block, "The subsystem list of ship %s is not linked through its block!", shipp->ship_name);
+		list_init( &shipp->subsys_list );
 
-		systemp = GET_FIRST( &shipp->subsys_list );
-		while ( systemp != END_OF_LIST(&shipp->subsys_list) ) {
-			temp = GET_NEXT( systemp );								// use temporary since pointers will get screwed with next operation
-			list_remove( shipp->subsys_list, systemp );			// remove the element
-			list_append( &ship_subsys_free_list, systemp );		// and place back onto free list
-			Num_ship_subsystems--;								// subtract from our in-use total
-			systemp = temp;												// use the temp variable to move right along
-		}
+		// the whole block goes back to the pool at once
+		Ship_subsystem_pool.release(shipp->subsys_block, shipp->num_subsys_block);
+		shipp->subsys_block = nullptr;
+		shipp->num_subsys_block = 0;
 
 		shipp->subsys_list_indexer.reset();
 		shipp->flags.remove(Ship::Ship_Flags::Subsystem_cache_valid);
@@ -19196,8 +19185,8 @@ void ship_page_in()
 
 	// pre-allocate the subsystems, this really only needs to happen for ships
 	// which don't exist yet (ie, ships NOT in Ships[])
-	if (!ship_allocate_subsystems(num_subsystems_needed, true)) {
-		Error(LOCATION, "Attempt to page in new subsystems subsystems failed, which shouldn't be possible anymore. Currently allocated %d subsystems (%d in use)", Num_ship_subsystems_allocated, Num_ship_subsystems); 
+	if (!ship_reserve_subsystems(num_subsystems_needed)) {
+		Error(LOCATION, "Attempt to page in new subsystems subsystems failed, which shouldn't be possible anymore. Currently allocated %d subsystems (%d in use)", Ship_subsystem_pool.num_allocated(), Ship_subsystem_pool.num_in_use()); 
 	}
 
 	mprintf(("About to page in ships!\n"));
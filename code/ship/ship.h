@@ -655,6 +655,8 @@ public:
 	// describing the state of all engines combined) -- MWA 4/1/97
 	ship_subsys	subsys_list;									//	linked list of subsystems for this ship.
 	std::unique_ptr<ship_subsys*[]> subsys_list_indexer;		//	provides random-access lookup to the linked list
+	ship_subsys	*subsys_block;									//	the subsystems in subsys_list, contiguous and in the same order
+	int			num_subsys_block;								//	number of subsystems in subsys_block
 	ship_subsys	*last_targeted_subobject[MAX_PLAYERS];	// Last subobject that has been targeted.  NULL if none;(player specific)
 	ship_subsys_info	subsys_info[SUBSYSTEM_MAX];		// info on particular generic types of subsystems	
 
@@ -1811,6 +1813,40 @@ extern int ship_find_num_turrets(object *objp);
 extern void compute_slew_matrix(matrix *orient, angles *a);
 extern void object_get_eye(vec3d *eye_pos, matrix *eye_orient, const object *obj, bool do_slew = true, bool local_pos = false, bool local_orient = false);
 
+// The subsystems of a ship by index, in the same order as its subsys_list.  They are stored contiguously, so this
+// is the cheap way to walk all of them; the yielded pointers are the same ones the list holds.
+class ship_subsys_block_range
+{
+	ship_subsys *first, *last;
+
+public:
+	class iterator
+	{
+		ship_subsys *ptr;
+
+	public:
+		explicit iterator(ship_subsys *p) : ptr(p) {}
+
+		ship_subsys *operator*() const { return ptr; }
+		iterator &operator++() { ++ptr; return *this; }
+		bool operator==(const iterator &rhs) const { return ptr == rhs.ptr; }
+		bool operator!=(const iterator &rhs) const { return ptr != rhs.ptr; }
+	};
+
+	ship_subsys_block_range(ship_subsys *block, int count) : first(block), last(block + count) {}
+
+	iterator begin() const { return iterator(first); }
+	iterator end() const { return iterator(last); }
+
+	int size() const { return static_cast<int>(last - first); }
+	ship_subsys *operator[](int index) const { return first + index; }
+};
+
+inline ship_subsys_block_range ship_subsys_range(const ship *shipp)
+{
+	return ship_subsys_block_range(shipp->subsys_block, shipp->num_subsys_block);
+}
+
 extern ship_subsys *ship_find_first_subsys(ship *sp, int subsys_type, const vec3d *attacker_pos = nullptr);
 extern ship_subsys *ship_get_indexed_subsys(ship *sp, int index);	// returns index'th subsystem of this ship
 extern int ship_find_subsys(const ship *sp, const char *ss_name);		// returns numerical index in linked list of subsystems
@@ -51,6 +51,7 @@
 #include "ship/ship.h"
 #include "ship/shipfx.h"
 #include "ship/shiphit.h"
+#include "ship/subsysbounds.h"
 #include "weapon/beam.h"
 #include "weapon/emp.h"
 #include "weapon/shockwave.h"
@@ -467,6 +468,56 @@ typedef struct {
 	ship_subsys	*ptr;
 } sublist;
 
+// Scratch lists for the subsystems in range of a hit, reused so that hits don't allocate.  Destroying a subsystem can
+// run scripts which damage ships again, so nested hits get a list of their own.
+static SCP_vector<std::unique_ptr<SCP_vector<sublist>>> Subsys_scratch_lists;
+static size_t Subsys_scratch_depth = 0;
+
+class subsys_scratch_list
+{
+	SCP_vector<sublist> *m_list;
+
+  public:
+	subsys_scratch_list()
+	{
+		if (Subsys_scratch_lists.size() <= Subsys_scratch_depth) {
+			Subsys_scratch_lists.emplace_back(new SCP_vector<sublist>());
+		}
+
+		m_list = Subsys_scratch_lists[Subsys_scratch_depth++].get();
+		m_list->clear();
+	}
+	~subsys_scratch_list()
+	{
+		Subsys_scratch_depth--;
+	}
+
+	subsys_scratch_list(const subsys_scratch_list&) = delete;
+	subsys_scratch_list& operator=(const subsys_scratch_list&) = delete;
+
+	SCP_vector<sublist>& get() { return *m_list; }
+};
+
+// Gets the world position of a subsystem and its distance to the hit, unless it is a static subsystem which can be
+// ruled out in model space.  Returns false if the subsystem is certainly out of range.
+static bool subsys_get_hit_dist(float *dist, const subsys_bounds_entry &entry, const subsys_bounds_hit &local_hit, const object *ship_objp, const vec3d *hitpos, float range)
+{
+	vec3d g_subobj_pos;
+
+	if (subsys_bounds_is_static(entry, local_hit)) {
+		if (!subsys_bounds_may_be_in_range(entry, local_hit, range)) {
+			return false;
+		}
+
+		subsys_bounds_get_world_pos(&g_subobj_pos, entry, ship_objp);
+	} else {
+		get_subsystem_world_pos(ship_objp, entry.subsys, &g_subobj_pos);
+	}
+
+	*dist = vm_vec_dist_quick(hitpos, &g_subobj_pos);
+	return true;
+}
+
 // fundamentally similar to do_subobj_hit_stuff, but without many checks inherent to damaging instead of healing
 // most notably this does NOT return "remaining healing" (healing always carries), this is will NOT subtract from hull healing
 
@@ -476,7 +527,8 @@ std::pair<std::optional<ConditionData>, float> do_subobj_heal_stuff(const object
 	float			healing_left;
 	int				weapon_info_index;
 	ship* ship_p;
-	SCP_vector<sublist> subsys_list;
+	subsys_scratch_list scratch;
+	auto&			subsys_list = scratch.get();
 	int				subsys_hit_first = -1; // the subsys which should be hit first and take most of the healing; index into subsys_list
 	vec3d			hitpos2;
 
@@ -498,10 +550,14 @@ std::pair<std::optional<ConditionData>, float> do_subobj_heal_stuff(const object
 		hitpos2 = *hitpos;
 	}
 
+	subsys_bounds_hit local_hit;
+	subsys_bounds_make_hit(&local_hit, &hitpos2, ship_objp);
+
 	//	First, create a list of the N subsystems within range.
 	//	Then, one at a time, process them in order.
-	for (auto subsys : list_range(&ship_p->subsys_list))
+	for (const auto& entry : subsys_bounds_get(ship_objp))
 	{
+		ship_subsys* subsys = entry.subsys;
 		model_subsystem* mss = subsys->system_info;
 
 		if (subsys->current_hits > 0.0f) {
@@ -523,10 +579,10 @@ std::pair<std::optional<ConditionData>, float> do_subobj_heal_stuff(const object
 			else {
 				// Default behavior:
 				// get the distance between the hit and the subsystem center
-				get_subsystem_world_pos(ship_objp, subsys, &g_subobj_pos);
-				dist = vm_vec_dist_quick(&hitpos2, &g_subobj_pos);
-
 				range = subsys_get_range(other_obj, subsys);
+
+				if (!subsys_get_hit_dist(&dist, entry, local_hit, ship_objp, &hitpos2, range))
+					continue;
 			}
 
 			if (dist < range) {
@@ -726,7 +782,8 @@ std::pair<std::optional<ConditionData>, float> do_subobj_hit_stuff(object *ship_
 	float				damage_left, damage_if_hull;
 	int				weapon_info_index;
 	ship				*ship_p;
-	SCP_vector<sublist> subsys_list;
+	subsys_scratch_list scratch;
+	auto&			subsys_list = scratch.get();
 	int				subsys_hit_first = -1; // the subsys which should be hit first and take most of the damage; index into subsys_list
 	vec3d			hitpos2;
 	float			ss_dif_scale = 1.0f; // Nuke: Set a base dificulty scale for compatibility
@@ -823,10 +880,15 @@ std::pair<std::optional<ConditionData>, float> do_subobj_hit_stuff(object *ship_
 	polymodel_instance *pmi = nullptr;
 	polymodel *pm = nullptr;
 
+	// the hit only needs to be brought into model space once to rule out most subsystems
+	subsys_bounds_hit local_hit;
+	subsys_bounds_make_hit(&local_hit, &hitpos2, ship_objp);
+
 	//	First, create a list of the N subsystems within range.
 	//	Then, one at a time, process them in order.
-	for (auto subsys : list_range(&ship_p->subsys_list))
+	for (const auto& entry : subsys_bounds_get(ship_objp))
 	{
+		ship_subsys *subsys = entry.subsys;
 		model_subsystem *mss = subsys->system_info;
 
 		//Deal with cheat correctly. If damage is the negative of the subsystem type, then we'll just kill the subsystem
@@ -870,10 +932,10 @@ std::pair<std::optional<ConditionData>, float> do_subobj_hit_stuff(object *ship_
 			} else {
 				// Default behavior:
 				// get the distance between the hit and the subsystem center
-				get_subsystem_world_pos(ship_objp, subsys, &g_subobj_pos);
-				dist = vm_vec_dist_quick(&hitpos2, &g_subobj_pos);
-
 				range = subsys_get_range(other_obj, subsys);
+
+				if (!subsys_get_hit_dist(&dist, entry, local_hit, ship_objp, &hitpos2, range))
+					continue;
 			}
 
 			if ( dist < range) {
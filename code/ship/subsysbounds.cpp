@@ -0,0 +1,215 @@
+#include "ship/subsysbounds.h"
+
+#include "debugconsole/console.h"
+#include "globalincs/linklist.h"
+#include "model/model.h"
+#include "object/object.h"
+#include "ship/ship.h"
+
+// ----------------------------------------------------------------------------------------------
+// SUBSYSTEM BOUNDS DEFINES/VARS
+//
+
+// relative rounding error allowed for when comparing model space and world space distances, far above the actual error
+constexpr float SUBSYS_BOUNDS_RELATIVE_SLACK = 1e-4f;
+constexpr float SUBSYS_BOUNDS_MIN_SLACK = 0.01f;
+
+typedef struct subsys_bounds_cache {
+	// what the entries were built for, rebuilt whenever any of these changes
+	int signature = -1;
+	int ship_info_index = -1;
+	int model_instance_num = -1;
+	const ship_subsys *first_subsys = nullptr;
+
+	SCP_vector<subsys_bounds_entry> entries;
+} subsys_bounds_cache;
+
+static subsys_bounds_cache Subsys_bounds[MAX_SHIPS];
+
+int Subsys_bounds_culling = 1;
+DCF_BOOL(subsys_bounds_culling, Subsys_bounds_culling);
+
+// ----------------------------------------------------------------------------------------------
+// SUBSYSTEM BOUNDS FUNCTIONS
+//
+
+void subsys_bounds_level_init()
+{
+	for (auto &cache : Subsys_bounds) {
+		cache = subsys_bounds_cache();
+	}
+}
+
+// The origin of a submodel only moves relative to the ship if it translates itself or if any of its parents moves.
+// Its own rotation does not matter since subsystems sit at the submodel origin.
+static bool subsys_bounds_submodel_is_static(const polymodel *pm, int submodel_num)
+{
+	if (pm->submodel[submodel_num].translation_type != MOVEMENT_TYPE_NONE) {
+		return false;
+	}
+
+	for (int mn = pm->submodel[submodel_num].parent; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent) {
+		if (pm->submodel[mn].flags[Model::Submodel_flags::Can_move]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void subsys_bounds_get_submodel_pos(vec3d *local_pos, const polymodel *pm, int submodel_num)
+{
+	// the walk of model_instance_local_to_global_point() for a submodel chain without any instance rotation or
+	// translation, where rotating by the identity and adding a zero offset leave the point exactly as it was
+	*local_pos = vmd_zero_vector;
+
+	for (int mn = submodel_num; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent) {
+		vm_vec_add2(local_pos, &pm->submodel[mn].offset);
+	}
+}
+
+bool subsys_bounds_submodel_is_untransformed(const polymodel *pm, const polymodel_instance *pmi, int submodel_num)
+{
+	for (int mn = submodel_num; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent) {
+		const auto &smi = pmi->submodel[mn];
+
+		if (smi.canonical_offset.xyz.x != 0.0f || smi.canonical_offset.xyz.y != 0.0f || smi.canonical_offset.xyz.z != 0.0f) {
+			return false;
+		}
+
+		// the submodel the subsystem sits on may rotate freely, its parents may not
+		if (mn != submodel_num) {
+			for (int i = 0; i < 9; i++) {
+				if (smi.canonical_orient.a1d[i] != vmd_identity_matrix.a1d[i]) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+static void subsys_bounds_build(subsys_bounds_cache *cache, const object *ship_objp)
+{
+	auto shipp = &Ships[ship_objp->instance];
+
+	cache->signature = ship_objp->signature;
+	cache->ship_info_index = shipp->ship_info_index;
+	cache->model_instance_num = shipp->model_instance_num;
+	cache->first_subsys = GET_FIRST(&shipp->subsys_list);
+	cache->entries.clear();
+
+	polymodel *pm = nullptr;
+
+	if (shipp->model_instance_num >= 0) {
+		pm = model_get(model_get_instance(shipp->model_instance_num)->model_num);
+	}
+
+	for (auto subsys : list_range(&shipp->subsys_list)) {
+		model_subsystem *mss = subsys->system_info;
+		subsys_bounds_entry entry;
+
+		entry.subsys = subsys;
+		entry.local_pos = vmd_zero_vector;
+		entry.submodel_num = -1;
+		entry.is_static = false;
+
+		if (mss == nullptr) {
+			// get_subsystem_pos() just returns the ship position for these
+		} else if (mss->subobj_num < 0) {
+			entry.local_pos = mss->pnt;
+			entry.is_static = true;
+		} else if (pm != nullptr && subsys_bounds_submodel_is_static(pm, mss->subobj_num)) {
+			// scripts can still move the submodel, that is checked for every hit
+			subsys_bounds_get_submodel_pos(&entry.local_pos, pm, mss->subobj_num);
+			entry.submodel_num = mss->subobj_num;
+			entry.is_static = true;
+		}
+
+		cache->entries.push_back(entry);
+	}
+}
+
+const SCP_vector<subsys_bounds_entry> &subsys_bounds_get(const object *ship_objp)
+{
+	Assertion(ship_objp->type == OBJ_SHIP, "Only ships can have subsystems!");
+
+	auto shipp = &Ships[ship_objp->instance];
+	auto cache = &Subsys_bounds[ship_objp->instance];
+
+	// the subsystem list is only rebuilt when the ship class changes
+	bool valid = (cache->signature == ship_objp->signature)
+		&& (cache->ship_info_index == shipp->ship_info_index)
+		&& (cache->model_instance_num == shipp->model_instance_num)
+		&& (cache->first_subsys == GET_FIRST(&shipp->subsys_list));
+
+	if (!valid) {
+		subsys_bounds_build(cache, ship_objp);
+	}
+
+	return cache->entries;
+}
+
+void subsys_bounds_make_hit(subsys_bounds_hit *hit, const vec3d *world_hit, const object *objp)
+{
+	vec3d offset;
+
+	hit->pm = nullptr;
+	hit->pmi = nullptr;
+
+	if (objp->type == OBJ_SHIP && Ships[objp->instance].model_instance_num >= 0) {
+		hit->pmi = model_get_instance(Ships[objp->instance].model_instance_num);
+		hit->pm = model_get(hit->pmi->model_num);
+	}
+
+	vm_vec_sub(&offset, world_hit, &objp->pos);
+	vm_vec_rotate(&hit->local_pos, &offset, &objp->orient);
+
+	float magnitude = MAX(MAX(fl_abs(objp->pos.xyz.x), fl_abs(objp->pos.xyz.y)), fl_abs(objp->pos.xyz.z))
+		+ MAX(MAX(fl_abs(offset.xyz.x), fl_abs(offset.xyz.y)), fl_abs(offset.xyz.z));
+
+	hit->slack = SUBSYS_BOUNDS_MIN_SLACK + SUBSYS_BOUNDS_RELATIVE_SLACK * magnitude;
+}
+
+bool subsys_bounds_is_static(const subsys_bounds_entry &entry, const subsys_bounds_hit &hit)
+{
+	if (!entry.is_static || !Subsys_bounds_culling) {
+		return false;
+	}
+
+	// a script may have set the translation or rotation of the submodel or its parents since the entry was built
+	if (entry.submodel_num >= 0) {
+		return (hit.pm != nullptr) && subsys_bounds_submodel_is_untransformed(hit.pm, hit.pmi, entry.submodel_num);
+	}
+
+	return true;
+}
+
+bool subsys_bounds_may_be_in_range(const subsys_bounds_entry &entry, const subsys_bounds_hit &hit, float range)
+{
+	Assertion(entry.is_static, "Only static subsystems can be culled in model space!");
+
+	float limit = range + hit.slack;
+
+	if (fl_abs(hit.local_pos.xyz.x - entry.local_pos.xyz.x) > limit) {
+		return false;
+	}
+	if (fl_abs(hit.local_pos.xyz.y - entry.local_pos.xyz.y) > limit) {
+		return false;
+	}
+	if (fl_abs(hit.local_pos.xyz.z - entry.local_pos.xyz.z) > limit) {
+		return false;
+	}
+
+	return vm_vec_dist_squared(&hit.local_pos, &entry.local_pos) <= limit * limit;
+}
+
+void subsys_bounds_get_world_pos(vec3d *world_pos, const subsys_bounds_entry &entry, const object *objp)
+{
+	Assertion(entry.is_static, "Only static subsystems have a fixed model space position!");
+
+	// the same operations as in get_subsystem_pos() and model_instance_local_to_global_point()
+	vm_vec_unrotate(world_pos, &entry.local_pos, &objp->orient);
+	vm_vec_add2(world_pos, &objp->pos);
+}
@@ -0,0 +1,64 @@
+#ifndef _SHIP_SUBSYS_BOUNDS_HEADER_FILE
+#define _SHIP_SUBSYS_BOUNDS_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// ----------------------------------------------------------------------------------------------
+// SUBSYSTEM BOUNDS
+//
+// Model space positions of the subsystems of a ship, so that finding the subsystems near a hit only requires the hit
+// position to be transformed into model space once instead of computing the world position of every subsystem.
+//
+// Subsystems whose position relative to the ship can never change are culled in model space.  Only those which pass
+// get their world position computed, and that is done exactly like get_subsystem_pos() does it so that the distances
+// used for damage are the same to the last bit.  Subsystems on moving submodels always have to go the long way, and so
+// do subsystems on submodels that a script has translated or rotated, e.g. through subsystem.Translation.
+//
+
+class object;
+class polymodel;
+class ship_subsys;
+struct polymodel_instance;
+
+typedef struct subsys_bounds_entry {
+	ship_subsys *subsys;
+	vec3d local_pos;	// position in model space, only valid if is_static
+	int submodel_num;	// the submodel whose instance has to be checked for script movement, or -1
+	bool is_static;		// whether the position relative to the ship can never change on its own
+} subsys_bounds_entry;
+
+typedef struct subsys_bounds_hit {
+	vec3d local_pos;	// the hit in model space
+	float slack;		// how far off local_pos may be from the exact world space hit due to rounding
+	const polymodel *pm;				// model of the ship that was hit, or nullptr
+	const polymodel_instance *pmi;		// model instance of the ship that was hit, or nullptr
+} subsys_bounds_hit;
+
+// whether static subsystems are culled in model space, otherwise every subsystem goes the long way
+extern int Subsys_bounds_culling;
+
+// call when initializing a level
+void subsys_bounds_level_init();
+
+// get the subsystem entries of a ship, in the order of its subsystem list
+const SCP_vector<subsys_bounds_entry> &subsys_bounds_get(const object *ship_objp);
+
+// transform a world space hit into the model space of the object
+void subsys_bounds_make_hit(subsys_bounds_hit *hit, const vec3d *world_hit, const object *objp);
+
+// model space position of a submodel origin if neither it nor any of its parents is translated or rotated
+void subsys_bounds_get_submodel_pos(vec3d *local_pos, const polymodel *pm, int submodel_num);
+
+// whether the instance translation and the parent rotations of a submodel are all untouched
+bool subsys_bounds_submodel_is_untransformed(const polymodel *pm, const polymodel_instance *pmi, int submodel_num);
+
+// whether the model space position of an entry is valid for this hit
+bool subsys_bounds_is_static(const subsys_bounds_entry &entry, const subsys_bounds_hit &hit);
+
+// conservative test for a static entry, never rejects a subsystem whose world space distance to the hit is below range
+bool subsys_bounds_may_be_in_range(const subsys_bounds_entry &entry, const subsys_bounds_hit &hit, float range);
+
+// world position of a static entry, identical to what get_subsystem_pos() returns for it
+void subsys_bounds_get_world_pos(vec3d *world_pos, const subsys_bounds_entry &entry, const object *objp);
+
+#endif
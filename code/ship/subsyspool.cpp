@@ -0,0 +1,138 @@
+#include "ship/subsyspool.h"
+
+#include "ship/ship.h"
+
+// ----------------------------------------------------------------------------------------------
+// SUBSYSTEM POOL FUNCTIONS
+//
+
+ship_subsys_pool::ship_subsys_pool(int chunk_size)
+	: Chunk_size(chunk_size), Num_allocated(0), Num_in_use(0)
+{
+	Assertion(chunk_size > 0, "The subsystem pool needs a positive chunk size!");
+}
+
+ship_subsys_pool::~ship_subsys_pool() = default;
+
+void ship_subsys_pool::add_chunk(int size)
+{
+	subsys_chunk chunk;
+
+	chunk.subsystems.reset(new ship_subsys[size]);
+	chunk.size = size;
+	chunk.free_ranges.push_back({0, size});
+
+	Chunks.push_back(std::move(chunk));
+	Num_allocated += size;
+}
+
+ship_subsys *ship_subsys_pool::allocate(int count)
+{
+	Assertion(count >= 0, "Cannot allocate a negative number of subsystems!");
+
+	if (count == 0) {
+		return nullptr;
+	}
+
+	for (auto &chunk : Chunks) {
+		for (auto it = chunk.free_ranges.begin(); it != chunk.free_ranges.end(); ++it) {
+			if (it->count < count) {
+				continue;
+			}
+
+			// first fit, taken from the front of the range so the rest stays in place
+			ship_subsys *first = &chunk.subsystems[it->offset];
+
+			it->offset += count;
+			it->count -= count;
+			if (it->count == 0) {
+				chunk.free_ranges.erase(it);
+			}
+
+			Num_in_use += count;
+			return first;
+		}
+	}
+
+	add_chunk(MAX(Chunk_size, count));
+
+	auto &chunk = Chunks.back();
+	auto &range = chunk.free_ranges.front();
+
+	range.offset += count;
+	range.count -= count;
+	if (range.count == 0) {
+		chunk.free_ranges.clear();
+	}
+
+	Num_in_use += count;
+	return &chunk.subsystems[0];
+}
+
+void ship_subsys_pool::release(ship_subsys *first, int count)
+{
+	if (first == nullptr || count <= 0) {
+		return;
+	}
+
+	for (auto &chunk : Chunks) {
+		auto begin = chunk.subsystems.get();
+		if (first < begin || first >= begin + chunk.size) {
+			continue;
+		}
+
+		int offset = static_cast<int>(first - begin);
+		Assertion(offset + count <= chunk.size, "Released subsystem block runs past the end of its chunk!");
+
+		// find the first free range after the released block, then merge with it and the one before where they touch
+		auto next = std::lower_bound(chunk.free_ranges.begin(), chunk.free_ranges.end(), offset,
+			[](const free_range &range, int off) { return range.offset < off; });
+
+		Assertion(next == chunk.free_ranges.end() || next->offset >= offset + count, "Released subsystem block overlaps a free range!");
+
+		bool merge_next = (next != chunk.free_ranges.end()) && (next->offset == offset + count);
+		bool merge_prev = false;
+		if (next != chunk.free_ranges.begin()) {
+			auto prev = std::prev(next);
+			Assertion(prev->offset + prev->count <= offset, "Released subsystem block overlaps a free range!");
+			merge_prev = (prev->offset + prev->count == offset);
+		}
+
+		if (merge_prev && merge_next) {
+			auto prev = std::prev(next);
+			prev->count += count + next->count;
+			chunk.free_ranges.erase(next);
+		} else if (merge_prev) {
+			std::prev(next)->count += count;
+		} else if (merge_next) {
+			next->offset = offset;
+			next->count += count;
+		} else {
+			chunk.free_ranges.insert(next, {offset, count});
+		}
+
+		Num_in_use -= count;
+		return;
+	}
+
+	Assertion(false, "Released a subsystem block which does not belong to the pool!");
+}
+
+bool ship_subsys_pool::reserve(int count)
+{
+	int num_free = Num_allocated - Num_in_use;
+
+	if (count <= num_free) {
+		return false;
+	}
+
+	add_chunk(MAX(Chunk_size, count - num_free));
+	return true;
+}
+
+void ship_subsys_pool::clear()
+{
+	Chunks.clear();
+	Num_allocated = 0;
+	Num_in_use = 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _SHIP_SUBSYS_POOL_HEADER_FILE
+#define _SHIP_SUBSYS_POOL_HEADER_FILE
+
+#include "globalincs/pstypes.h"
+
+// ----------------------------------------------------------------------------------------------
+// SUBSYSTEM POOL
+//
+// Hands out the subsystems of a ship as one contiguous block, so that walking over them touches consecutive memory
+// instead of chasing list pointers across allocation batches.  Blocks are carved out of large chunks which are never
+// moved or freed before the pool is cleared, so pointers to subsystems stay valid for as long as the ship has them.
+//
+
+class ship_subsys;
+
+class ship_subsys_pool
+{
+public:
+	// chunk_size is the number of subsystems made at once unless a single block needs more
+	explicit ship_subsys_pool(int chunk_size);
+	~ship_subsys_pool();
+
+	ship_subsys_pool(const ship_subsys_pool&) = delete;
+	ship_subsys_pool& operator=(const ship_subsys_pool&) = delete;
+
+	// returns count contiguous subsystems, making a new chunk if no free range is large enough
+	ship_subsys *allocate(int count);
+
+	// gives a block (or the tail of one) back to the pool
+	void release(ship_subsys *first, int count);
+
+	// makes sure at least count subsystems are free, used to allocate up front when paging in a mission
+	// returns true if a new chunk had to be made
+	bool reserve(int count);
+
+	// frees all chunks, every subsystem handed out becomes invalid
+	void clear();
+
+	int num_allocated() const { return Num_allocated; }
+	int num_in_use() const { return Num_in_use; }
+	size_t num_chunks() const { return Chunks.size(); }
+
+private:
+	typedef struct free_range {
+		int offset;
+		int count;
+	} free_range;
+
+	typedef struct subsys_chunk {
+		std::unique_ptr<ship_subsys[]> subsystems;
+		int size;
+		SCP_vector<free_range> free_ranges;		// sorted by offset, never adjacent
+	} subsys_chunk;
+
+	void add_chunk(int size);
+
+	SCP_vector<subsys_chunk> Chunks;
+	int Chunk_size;
+	int Num_allocated;
+	int Num_in_use;
+};
+
+#endif
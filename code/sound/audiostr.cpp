@@ -103,6 +103,7 @@ public:
 	bool CreateMem (const uint8_t* snddata, size_t snd_len);
 	bool Destroy ();
 	void Play (float volume, int looping);
+	void Cue ();
 	bool Is_Playing(){ return m_fPlaying; }
 	bool Is_Paused(){ return m_bIsPaused; }
 	bool Is_Past_Limit() { return m_bPastLimit; }
@@ -118,6 +119,7 @@ public:
 	void	Set_Default_Volume(float vol) { m_lDefaultVolume = vol; }
 	float	Get_Default_Volume() { return m_lDefaultVolume; }
 	uint	Get_Samples_Committed();
+	int	Get_Time_Remaining();
 	int	Is_looping() { return m_bLooping; }
 	int	status;
 	int	type;
@@ -125,7 +127,7 @@ public:
 
 protected:
 	bool prepareOpened(const char *filename);
-	void Cue ();
+	int ReadWaveData (ubyte *data);
 	bool WriteWaveData (uint cbSize, uint *num_bytes_written, int service = 1);
 	uint GetMaxWriteSize ();
 	bool ServiceBuffer ();
@@ -144,6 +146,9 @@ protected:
 	uint m_cbBufSize;		// size of sound buffer in bytes
 	uint m_nBufService;		// service interval in msec
 	uint m_nTimeStarted;	// time (in system time) playback started
+	size_t m_nPrimeBuffers;	// number of buffers filled when the stream is cued
+	size_t m_nBuffersUsed;	// number of buffers filled since the stream was cued
+	size_t m_cbBytesPlayed;	// bytes in the buffers that finished playing since the stream was cued
 
 	bool	m_bLooping;				// whether or not to loop playback
 	bool	m_bFade;				// fade out music 
@@ -237,6 +242,12 @@ uint Timer::TimeProc(uint interval, void *dwUser)
 // The following constants are the defaults for our streaming buffer operation.
 const ushort DefBufferServiceInterval = 250;  // default buffer service interval in msec
 
+// Voice streams use shorter buffers and are serviced more often, and only the first few buffers are filled when the
+// stream is cued.  That keeps the decoding done before a voice starts playing down to a few hundred ms of audio.
+const ushort VoiceBufferServiceInterval = 100;
+const uint VoiceBuffersPerSecond = 8;
+const size_t VoicePrimeBuffers = 3;
+
 // Constructor
 AudioStream::AudioStream (void) : m_total_uncompressed_bytes_read(0), m_max_uncompressed_bytes_to_read(0)
 {
@@ -269,6 +280,9 @@ void AudioStream::Init_Data ()
 	m_cbBufSize = 0;
 	m_nBufService = DefBufferServiceInterval;
 	m_nTimeStarted = 0;
+	m_nPrimeBuffers = MAX_STREAM_BUFFERS;
+	m_nBuffersUsed = 0;
+	m_cbBytesPlayed = 0;
 
 	memset(m_buffer_ids, 0, sizeof(m_buffer_ids));
 	m_source_id = 0;
@@ -291,6 +305,15 @@ bool AudioStream::prepareOpened(const char *filename)
 	// if the requested buffer size is too big then cap it
 	m_cbBufSize = (m_cbBufSize > BIGBUF_SIZE) ? BIGBUF_SIZE : m_cbBufSize;
 
+	if (type == ASF_VOICE) {
+		const uint frame_size = m_fileProps.bytes_per_sample * m_fileProps.num_channels;
+
+		m_cbBufSize = (m_fileProps.sample_rate / VoiceBuffersPerSecond) * frame_size;
+		m_cbBufSize = (m_cbBufSize > BIGBUF_SIZE) ? (BIGBUF_SIZE - (BIGBUF_SIZE % frame_size)) : m_cbBufSize;
+		m_nBufService = VoiceBufferServiceInterval;
+		m_nPrimeBuffers = VoicePrimeBuffers;
+	}
+
 	//				nprintf(("SOUND", "SOUND => Stream buffer created using %d bytes\n", m_cbBufSize));
 
 	OpenAL_ErrorCheck( alGenSources(1, &m_source_id), { fRtn = false; goto ErrorExit; } );
@@ -404,6 +427,24 @@ bool AudioStream::Destroy (void)
 	return fRtn;
 }
 
+// ReadWaveData
+//
+// Reads one buffer worth of wave data, starting over at the beginning of the file if the stream
+// is looping.  Returns the number of bytes read or -1 if the end of the file was reached.
+int AudioStream::ReadWaveData (ubyte *data)
+{
+	int num_bytes_read = m_pwavefile->Read(data, m_cbBufSize);
+
+	// if looping then maybe reset wavefile and keep going
+	if ( (num_bytes_read < 0) && m_bLooping) {
+		m_pwavefile->Cue();
+		m_total_uncompressed_bytes_read = 0;
+		num_bytes_read = m_pwavefile->Read(data, m_cbBufSize);
+	}
+
+	return num_bytes_read;
+}
+
 // WriteWaveData
 //
 // Writes wave data to sound buffer. This is a helper method used by Create and
@@ -438,15 +479,10 @@ bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service
 	const auto alFormat = openal_get_format(m_fileProps.bytes_per_sample * 8, m_fileProps.num_channels);
 
 	if ( !service ) {
-		for (auto &buffer_id : m_buffer_ids) {
-			num_bytes_read = m_pwavefile->Read(uncompressed_wave_data, m_cbBufSize);
-
-			// if looping then maybe reset wavefile and keep going
-			if ( (num_bytes_read < 0) && m_bLooping) {
-				m_pwavefile->Cue();
-				m_total_uncompressed_bytes_read = 0;
-				num_bytes_read = m_pwavefile->Read(uncompressed_wave_data, m_cbBufSize);
-			}
+		for (m_nBuffersUsed = 0; m_nBuffersUsed < m_nPrimeBuffers; ) {
+			auto buffer_id = m_buffer_ids[m_nBuffersUsed++];
+
+			num_bytes_read = ReadWaveData(uncompressed_wave_data);
 
 			if (num_bytes_read < 0) {
 				m_bReadingDone = 1;
@@ -466,14 +502,11 @@ bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service
 			ALuint buffer_id = 0;
 			OpenAL_ErrorPrint( alSourceUnqueueBuffers(m_source_id, 1, &buffer_id) );
 
-			num_bytes_read = m_pwavefile->Read(uncompressed_wave_data, m_cbBufSize);
+			ALint buffer_size = 0;
+			OpenAL_ErrorPrint( alGetBufferi(buffer_id, AL_SIZE, &buffer_size) );
+			m_cbBytesPlayed += buffer_size;
 
-			// if looping then maybe reset wavefile and keep going
-			if ( (num_bytes_read < 0) && m_bLooping) {
-				m_pwavefile->Cue();
-				m_total_uncompressed_bytes_read = 0;
-				num_bytes_read = m_pwavefile->Read(uncompressed_wave_data, m_cbBufSize);
-			}
+			num_bytes_read = ReadWaveData(uncompressed_wave_data);
 
 			if (num_bytes_read < 0) {
 				m_bReadingDone = 1;
@@ -486,6 +519,22 @@ bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service
 
 			buffers_processed--;
 		}
+
+		// fill the buffers that were left empty when the stream was cued
+		while ( !m_bReadingDone && (m_nBuffersUsed < MAX_STREAM_BUFFERS) ) {
+			auto buffer_id = m_buffer_ids[m_nBuffersUsed++];
+
+			num_bytes_read = ReadWaveData(uncompressed_wave_data);
+
+			if (num_bytes_read < 0) {
+				m_bReadingDone = 1;
+			} else if (num_bytes_read > 0) {
+				OpenAL_ErrorPrint( alBufferData(buffer_id, alFormat, uncompressed_wave_data, num_bytes_read, m_fileProps.sample_rate) );
+				OpenAL_ErrorPrint( alSourceQueueBuffers(m_source_id, 1, &buffer_id) );
+
+				*num_bytes_written += num_bytes_read;
+			}
+		}
 	}
 
 ErrorExit:
@@ -674,6 +723,8 @@ void AudioStream::Cue (void)
 			buffers_processed--;
 		}
 
+		m_cbBytesPlayed = 0;
+
 		// Fill buffer with wave data
 		WriteWaveData (m_cbBufSize, &num_bytes_written, 0);
 
@@ -746,6 +797,31 @@ uint AudioStream::Get_Samples_Committed(void)
 	return (uint) (m_total_uncompressed_bytes_read / m_fileProps.bytes_per_sample);
 }
 
+// Time left until a stream that is not looping has played to the end, in ms
+int AudioStream::Get_Time_Remaining(void)
+{
+	if ( (m_pwavefile == NULL) || !(m_fPlaying || m_bIsPaused) || PlaybackDone() )
+		return 0;
+
+	SDL_LockMutex( write_lock );
+
+	// the offset counts from the start of the first buffer still queued
+	ALint offset = 0;
+	OpenAL_ErrorPrint( alGetSourcei(m_source_id, AL_BYTE_OFFSET, &offset) );
+
+	auto bytes_played = m_cbBytesPlayed + offset;
+
+	SDL_UnlockMutex( write_lock );
+
+	auto bytes_per_sec = m_fileProps.sample_rate * m_fileProps.bytes_per_sample * m_fileProps.num_channels;
+	if (bytes_per_sec <= 0)
+		return 0;
+
+	auto remaining = fl2i(1000.0f * m_fileProps.duration) - static_cast<int>((bytes_played * 1000) / bytes_per_sec);
+
+	return MAX(remaining, 0);
+}
+
 
 /** Have stream fade out and be destroyed when inaudabile.
 If stream is already done or never started just destroy it now.
@@ -1229,6 +1305,35 @@ uint audiostream_get_samples_committed(int i)
 	return Audio_streams[i].Get_Samples_Committed();
 }
 
+void audiostream_cue(int i)
+{
+	if (!Audiostream_inited)
+		return;
+
+	if ( i == -1 )
+		return;
+
+	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
+
+	if ( Audio_streams[i].status != ASF_USED )
+		return;
+
+	Audio_streams[i].Cue();
+}
+
+int audiostream_get_time_remaining(int i)
+{
+	if ( i == -1 )
+		return 0;
+
+	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
+
+	if ( Audio_streams[i].status == ASF_FREE )
+		return 0;
+
+	return Audio_streams[i].Get_Time_Remaining();
+}
+
 int audiostream_done_reading(int i)
 {
 	if ( i == -1 )
@@ -75,6 +75,12 @@ void audiostream_set_sample_cutoff(int i, unsigned int cutoff);
 // return the number of samples streamed to the Direct Sound buffer so far
 unsigned int audiostream_get_samples_committed(int i);
 
+// fill the buffers of an opened stream ahead of time, so that playing it later does not have to decode anything
+void audiostream_cue(int i);
+
+// get the time left until a stream that is not looping has played to the end, in ms
+int audiostream_get_time_remaining(int i);
+
 // check if the streaming has read all the bytes from disk yet
 int audiostream_done_reading(int i);
 
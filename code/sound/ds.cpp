@@ -143,6 +143,18 @@ typedef ALvoid (AL_APIENTRY * ALAUXILIARYEFFECTSLOTIV) (ALuint, ALenum, ALint*);
 typedef ALvoid (AL_APIENTRY * ALAUXILIARYEFFECTSLOTF) (ALuint, ALenum, ALfloat);
 typedef ALvoid (AL_APIENTRY * ALAUXILIARYEFFECTSLOTFV) (ALuint, ALenum, ALfloat*);
 
+typedef ALvoid (AL_APIENTRY * ALDEFERUPDATESSOFT) (void);
+typedef ALvoid (AL_APIENTRY * ALPROCESSUPDATESSOFT) (void);
+
+// ALC_SOFT_loopback, from alext.h
+#define DS_ALC_FORMAT_CHANNELS_SOFT		0x1990
+#define DS_ALC_FORMAT_TYPE_SOFT			0x1991
+#define DS_ALC_STEREO_SOFT				0x1501
+#define DS_ALC_FLOAT_SOFT				0x1406
+
+typedef ALCdevice* (ALC_APIENTRY * ALCLOOPBACKOPENDEVICESOFT) (const ALCchar*);
+typedef ALCvoid (ALC_APIENTRY * ALCRENDERSAMPLESSOFT) (ALCdevice*, ALCvoid*, ALCsizei);
+
 
 ALGENFILTERS v_alGenFilters = NULL;
 ALDELETEFILTERS v_alDeleteFilters = NULL;
@@ -166,6 +178,11 @@ ALAUXILIARYEFFECTSLOTIV v_alAuxiliaryEffectSlotiv = NULL;
 ALAUXILIARYEFFECTSLOTF v_alAuxiliaryEffectSlotf = NULL;
 ALAUXILIARYEFFECTSLOTFV v_alAuxiliaryEffectSlotfv = NULL;
 
+static ALDEFERUPDATESSOFT v_alDeferUpdatesSOFT = NULL;
+static ALPROCESSUPDATESSOFT v_alProcessUpdatesSOFT = NULL;
+
+static ALCRENDERSAMPLESSOFT v_alcRenderSamplesSOFT = NULL;
+
 ALCdevice *ds_sound_device = NULL;
 ALCcontext *ds_sound_context = NULL;
 
@@ -260,10 +277,9 @@ int ds_get_sid()
 	return (int)(sound_buffers.size() - 1);
 }
 
-int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
+int ds_load_buffer(int *sid, const sound::AudioFileProperties& fileProps, const SCP_vector<uint8_t>& audio_buffer)
 {
 	Assert(sid != NULL);
-	Assert(file != NULL);
 
 	// All sounds are required to have a software buffer
 	*sid = ds_get_sid();
@@ -275,10 +291,7 @@ int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
 	ALuint pi;
 	OpenAL_ErrorCheck(alGenBuffers(1, &pi), return -1);
 
-	const auto fileProps = file->getFileProperties();
-
 	ALenum format;
-	ALsizei size = fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels;
 	ALint n_channels = fileProps.num_channels;
 	ALsizei frequency;
 		
@@ -290,20 +303,6 @@ int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
 		return -1;
 	}
 
-	SCP_vector<uint8_t> audio_buffer;
-	audio_buffer.reserve(size);
-
-	SCP_vector<uint8_t> buffer(fileProps.sample_rate * fileProps.bytes_per_sample * fileProps.num_channels);
-	int read;
-	while((read = file->Read(&buffer[0], buffer.size())) >= 0) {
-		if (read == 0) {
-			// buffer not large enough
-			buffer.resize(buffer.size() * 2);
-		} else {
-			audio_buffer.insert(audio_buffer.end(), buffer.begin(), std::next(buffer.begin(), read));
-		}
-	}
-
 	Snd_sram += audio_buffer.size();
 
 	OpenAL_ErrorCheck(alBufferData(pi, format, audio_buffer.data(), (ALsizei)audio_buffer.size(), frequency), return -1; );
@@ -392,6 +391,8 @@ int ds_init()
 {
 	ALfloat list_orien[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
 	ALCint attrList[] = { ALC_FREQUENCY, 22050, 0 };
+	ALCint loopbackAttrList[] = { ALC_FREQUENCY, 22050, DS_ALC_FORMAT_CHANNELS_SOFT, DS_ALC_STEREO_SOFT, DS_ALC_FORMAT_TYPE_SOFT, DS_ALC_FLOAT_SOFT, 0 };
+	const ALCint *contextAttrList = attrList;
 	unsigned int sample_rate = 22050;
 
 	mprintf(("Initializing OpenAL...\n"));
@@ -419,23 +420,45 @@ int ds_init()
 	SCP_string playback_device;
 	SCP_string capture_device;
 
-	if ( openal_init_device(&playback_device, &capture_device) == false ) {
-		mprintf(("\n  ERROR: Unable to find suitable playback device!\n\n"));
-		goto AL_InitError;
-	}
+	if (Cmdline_loopback_sound) {
+		// mix into memory through ds_loopback_render() instead of playing on a device
+		ALCLOOPBACKOPENDEVICESOFT v_alcLoopbackOpenDeviceSOFT = NULL;
 
-	ds_sound_device = alcOpenDevice( (const ALCchar*) playback_device.c_str() );
+		if ( alcIsExtensionPresent(NULL, (const ALCchar*)"ALC_SOFT_loopback") == AL_TRUE ) {
+			v_alcLoopbackOpenDeviceSOFT = (ALCLOOPBACKOPENDEVICESOFT) alcGetProcAddress(NULL, "alcLoopbackOpenDeviceSOFT");
+			v_alcRenderSamplesSOFT = (ALCRENDERSAMPLESSOFT) alcGetProcAddress(NULL, "alcRenderSamplesSOFT");
+		}
+
+		if ( !v_alcLoopbackOpenDeviceSOFT || !v_alcRenderSamplesSOFT ) {
+			mprintf(("\n  ERROR: Loopback sound needs the \"ALC_SOFT_loopback\" extension!\n\n"));
+			v_alcRenderSamplesSOFT = NULL;
+			goto AL_InitError;
+		}
+
+		playback_device = "loopback";
+		ds_sound_device = v_alcLoopbackOpenDeviceSOFT(NULL);
+
+		loopbackAttrList[1] = sample_rate;
+		contextAttrList = loopbackAttrList;
+	} else {
+		if ( openal_init_device(&playback_device, &capture_device) == false ) {
+			mprintf(("\n  ERROR: Unable to find suitable playback device!\n\n"));
+			goto AL_InitError;
+		}
+
+		ds_sound_device = alcOpenDevice( (const ALCchar*) playback_device.c_str() );
+	}
 
 	if (ds_sound_device == NULL) {
 		mprintf(("  Failed to open playback_device (%s) returning error (%s)\n", playback_device.c_str(), openal_error_string(1)));
 		goto AL_InitError;
 	}
 
-	ds_sound_context = alcCreateContext(ds_sound_device, attrList);
+	ds_sound_context = alcCreateContext(ds_sound_device, contextAttrList);
 
 	if (ds_sound_context == NULL) {
 		mprintf(("  Failed to create context for playback_device (%s) with attrList = { 0x%x, %d, %d } returning error (%s)\n",
-			playback_device.c_str(), attrList[0], attrList[1], attrList[2], openal_error_string(1)));
+			playback_device.c_str(), contextAttrList[0], contextAttrList[1], contextAttrList[2], openal_error_string(1)));
 		goto AL_InitError;
 	}
 
@@ -466,6 +489,17 @@ int ds_init()
 		Ds_float_supported = 1;
 	}
 
+	if ( alIsExtensionPresent( (const ALchar*)"AL_SOFT_deferred_updates" ) == AL_TRUE ) {
+		mprintf(("  Found extension \"AL_SOFT_deferred_updates\".\n"));
+		v_alDeferUpdatesSOFT = (ALDEFERUPDATESSOFT) alGetProcAddress("alDeferUpdatesSOFT");
+		v_alProcessUpdatesSOFT = (ALPROCESSUPDATESSOFT) alGetProcAddress("alProcessUpdatesSOFT");
+
+		if ( !v_alDeferUpdatesSOFT || !v_alProcessUpdatesSOFT ) {
+			v_alDeferUpdatesSOFT = NULL;
+			v_alProcessUpdatesSOFT = NULL;
+		}
+	}
+
 	Ds_use_eax = 0;
 
 	if ( alcIsExtensionPresent(ds_sound_device, (const ALchar*)"ALC_EXT_EFX") == AL_TRUE ) {
@@ -560,6 +594,8 @@ int ds_init()
 AL_InitError:
 	alcMakeContextCurrent(NULL);
 
+	v_alcRenderSamplesSOFT = NULL;
+
 	if (ds_sound_context != NULL) {
 		alcDestroyContext(ds_sound_context);
 		ds_sound_context = NULL;
@@ -691,6 +727,10 @@ void ds_close()
 	delete [] Channels;
 	Channels = NULL;
 
+	v_alDeferUpdatesSOFT = NULL;
+	v_alProcessUpdatesSOFT = NULL;
+	v_alcRenderSamplesSOFT = NULL;
+
 	alcMakeContextCurrent(NULL);	// hangs on me for some reason
 
 	if (ds_sound_context != NULL) {
@@ -1906,6 +1946,44 @@ int ds_eax_is_inited()
 	return Ds_eax_inited;
 }
 
+/**
+ * Hold back changes to sources until ds_process_updates() is called, so that a batch of changes
+ * takes effect in the same mix.  Does nothing if the AL_SOFT_deferred_updates extension is missing.
+ */
+void ds_defer_updates()
+{
+	if ( v_alDeferUpdatesSOFT ) {
+		v_alDeferUpdatesSOFT();
+	}
+}
+
+/**
+ * Apply the changes held back since ds_defer_updates()
+ */
+void ds_process_updates()
+{
+	if ( v_alProcessUpdatesSOFT ) {
+		v_alProcessUpdatesSOFT();
+	}
+}
+
+/**
+ * Mix the sounds that are playing when running with -loopback_sound, which is the only way they advance then
+ * @param buffer Receives num_frames frames of interleaved stereo float samples
+ * @param num_frames Number of frames to mix
+ */
+void ds_loopback_render(float *buffer, int num_frames)
+{
+	Assertion( v_alcRenderSamplesSOFT != NULL, "Sound can only be rendered into memory with -loopback_sound!" );
+
+	if ( !v_alcRenderSamplesSOFT ) {
+		memset(buffer, 0, sizeof(float) * 2 * num_frames);
+		return;
+	}
+
+	v_alcRenderSamplesSOFT(ds_sound_device, buffer, num_frames);
+}
+
 /**
  * Called once per game frame to make sure voice messages aren't looping
  */
@@ -58,7 +58,7 @@ using ds_sound_handle = ::util::ID<ds_sound_handle_tag, int, -1>;
 
 int ds_init();
 void ds_close();
-int ds_load_buffer(int *sid, int flags, sound::IAudioFile* file);
+int ds_load_buffer(int *sid, const sound::AudioFileProperties& props, const SCP_vector<uint8_t>& pcm);
 void ds_unload_buffer(int sid);
 ds_sound_handle ds_play(int sid, int snd_id, int priority, const EnhancedSoundData* enhanced_sound_data, float volume,
                         float pan, int looping, bool is_voice_msg = false);
@@ -105,6 +105,13 @@ ds_sound_handle ds3d_play(int sid, int snd_id, const vec3d* pos, const vec3d* ve
 
 void ds_do_frame();
 
+// batch changes to sources so that they are applied together
+void ds_defer_updates();
+void ds_process_updates();
+
+// mix interleaved stereo float samples, only with -loopback_sound
+void ds_loopback_render(float *buffer, int num_frames);
+
 // --------------------
 //
 // Creative eax.h
@@ -0,0 +1,243 @@
+#include "sound/pcmcache.h"
+
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "parse/parselo.h"
+#include "sound/ds.h"
+
+// ----------------------------------------------------------------------------------------------
+// PCM CACHE DEFINES/VARS
+//
+
+static const int PCM_CACHE_FILE_VERSION = 1;
+static const char PCM_CACHE_FILE_ID[4] = { 'F', 'S', 'P', 'C' };
+
+static const int PCM_CACHE_LOCATION = CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT;
+
+static const char PCM_CACHE_PREFIX[] = "pcm_cache-";
+
+// decoded sounds are a lot larger than the files they come from, so the cache is kept below this size by deleting
+// the files written longest ago whenever a new one would not fit
+static const size_t PCM_CACHE_MAX_SIZE = 512 * 1024 * 1024;
+
+typedef struct pcm_cache_file {
+	SCP_string filename;
+	size_t size;
+} pcm_cache_file;
+
+// the files of the cache, written longest ago first
+static SCP_vector<pcm_cache_file> Pcm_cache_files;
+static size_t Pcm_cache_size = 0;
+static bool Pcm_cache_scanned = false;
+
+// ----------------------------------------------------------------------------------------------
+// PCM CACHE FUNCTIONS
+//
+
+bool pcm_cache_enabled()
+{
+	return !Cmdline_no_sound_cache;
+}
+
+bool pcm_cache_wanted(const uint8_t *data, size_t size)
+{
+	// a RIFF wave file whose format chunk comes first and says it is plain PCM
+	if (size >= 22 && !memcmp(data, "RIFF", 4) && !memcmp(data + 8, "WAVEfmt ", 8)) {
+		auto format_tag = static_cast<int>(data[20]) | (static_cast<int>(data[21]) << 8);
+		if (format_tag == 1) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+SCP_string pcm_cache_key(const uint8_t *data, size_t size, bool mono)
+{
+	// cf_add_chksum_long() only reads the buffer
+	auto chksum = cf_add_chksum_long(0, const_cast<uint8_t *>(data), size);
+
+	// the output format depends on the sound quality settings
+	SCP_string key;
+	sprintf(key, "%08x-%08x-%c%d%d", chksum, static_cast<uint>(size), mono ? 'm' : 's', Ds_sound_quality, Ds_float_supported);
+	return key;
+}
+
+static SCP_string pcm_cache_filename(const SCP_string &key)
+{
+	return PCM_CACHE_PREFIX + key + ".bin";
+}
+
+// finds the files earlier runs have left in the cache
+static void pcm_cache_scan()
+{
+	Pcm_cache_scanned = true;
+	Pcm_cache_files.clear();
+	Pcm_cache_size = 0;
+
+	SCP_vector<SCP_string> cache_files;
+	SCP_vector<file_list_info> file_info;
+	cf_get_file_list(cache_files, CF_TYPE_CACHE, "*.bin", CF_SORT_NONE, &file_info, PCM_CACHE_LOCATION);
+
+	Assertion(cache_files.size() == file_info.size(),
+			  "cf_get_file_list returned different sizes for file names and file informations!");
+
+	SCP_vector<std::pair<time_t, pcm_cache_file>> found;
+
+	for (size_t i = 0; i < cache_files.size(); ++i) {
+		auto &name = cache_files[i];
+
+		if (strnicmp(name.c_str(), PCM_CACHE_PREFIX, strlen(PCM_CACHE_PREFIX)) != 0) {
+			// not a PCM cache file
+			continue;
+		}
+
+		pcm_cache_file file;
+		file.filename = name + ".bin";
+		file.size = cf_find_file_location(file.filename.c_str(), CF_TYPE_CACHE, PCM_CACHE_LOCATION).size;
+
+		found.emplace_back(file_info[i].write_time, file);
+	}
+
+	std::stable_sort(found.begin(), found.end(), [](const std::pair<time_t, pcm_cache_file> &a, const std::pair<time_t, pcm_cache_file> &b) {
+		return a.first < b.first;
+	});
+
+	for (auto &entry : found) {
+		Pcm_cache_size += entry.second.size;
+		Pcm_cache_files.push_back(std::move(entry.second));
+	}
+}
+
+// makes room for a new file of the given size, returns false if it can't fit at all
+static bool pcm_cache_make_room(const SCP_string &filename, size_t size)
+{
+	if (!Pcm_cache_scanned) {
+		pcm_cache_scan();
+	}
+
+	if (size > PCM_CACHE_MAX_SIZE) {
+		return false;
+	}
+
+	// a damaged file of the same name is about to be replaced
+	for (auto it = Pcm_cache_files.begin(); it != Pcm_cache_files.end(); ++it) {
+		if (!stricmp(it->filename.c_str(), filename.c_str())) {
+			Pcm_cache_size -= it->size;
+			Pcm_cache_files.erase(it);
+			break;
+		}
+	}
+
+	size_t evicted = 0;
+	while (evicted < Pcm_cache_files.size() && Pcm_cache_size + size > PCM_CACHE_MAX_SIZE) {
+		auto &oldest = Pcm_cache_files[evicted++];
+
+		cf_delete(oldest.filename.c_str(), CF_TYPE_CACHE, PCM_CACHE_LOCATION);
+		Pcm_cache_size -= oldest.size;
+	}
+
+	Pcm_cache_files.erase(Pcm_cache_files.begin(), Pcm_cache_files.begin() + evicted);
+
+	return true;
+}
+
+bool pcm_cache_load(const SCP_string &key, decoded_sound &sound)
+{
+	if (!pcm_cache_enabled()) {
+		return false;
+	}
+
+	auto filename = pcm_cache_filename(key);
+
+	auto cfp = cfopen(filename.c_str(), "rb", CF_TYPE_CACHE, false, PCM_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		return false;
+	}
+
+	char id[sizeof(PCM_CACHE_FILE_ID)];
+	bool valid = (cfread(id, sizeof(id), 1, cfp) == 1) && !memcmp(id, PCM_CACHE_FILE_ID, sizeof(id))
+		&& (cfread_int(cfp) == PCM_CACHE_FILE_VERSION);
+
+	int length = 0;
+	uint chksum = 0;
+
+	if (valid) {
+		sound.props.bytes_per_sample = cfread_int(cfp);
+		sound.props.duration = cfread_float(cfp);
+		sound.props.total_samples = cfread_int(cfp);
+		sound.props.num_channels = cfread_int(cfp);
+		sound.props.sample_rate = cfread_int(cfp);
+		sound.original_channels = cfread_int(cfp);
+
+		length = cfread_int(cfp);
+		chksum = cfread_uint(cfp);
+		valid = (length >= 0) && (length == cfilelength(cfp) - cftell(cfp));
+	}
+
+	if (valid) {
+		sound.pcm.resize(static_cast<size_t>(length));
+		valid = (length == 0) || (cfread(sound.pcm.data(), length, 1, cfp) == 1);
+	}
+
+	cfclose(cfp);
+
+	// the data itself could have been cut short or damaged
+	if (valid && (cf_add_chksum_long(0, sound.pcm.data(), sound.pcm.size()) != chksum)) {
+		mprintf(("SOUND ==> Cached PCM data %s is damaged.\n", filename.c_str()));
+		valid = false;
+	}
+
+	if (!valid) {
+		sound = decoded_sound();
+		return false;
+	}
+
+	return true;
+}
+
+void pcm_cache_save(const SCP_string &key, const decoded_sound &sound)
+{
+	if (!pcm_cache_enabled()) {
+		return;
+	}
+
+	auto filename = pcm_cache_filename(key);
+
+	// the id and nine ints of header, so only the data differs in size between files
+	auto size = sizeof(PCM_CACHE_FILE_ID) + 9 * sizeof(int) + sound.pcm.size();
+
+	if (!pcm_cache_make_room(filename, size)) {
+		return;
+	}
+
+	auto cfp = cfopen(filename.c_str(), "wb", CF_TYPE_CACHE, false, PCM_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		mprintf(("SOUND ==> Could not open %s for writing!\n", filename.c_str()));
+		return;
+	}
+
+	// cf_add_chksum_long() only reads the buffer
+	auto data = const_cast<uint8_t *>(sound.pcm.data());
+
+	cfwrite(PCM_CACHE_FILE_ID, sizeof(PCM_CACHE_FILE_ID), 1, cfp);
+	cfwrite_int(PCM_CACHE_FILE_VERSION, cfp);
+
+	cfwrite_int(sound.props.bytes_per_sample, cfp);
+	cfwrite_float(static_cast<float>(sound.props.duration), cfp);
+	cfwrite_int(sound.props.total_samples, cfp);
+	cfwrite_int(sound.props.num_channels, cfp);
+	cfwrite_int(sound.props.sample_rate, cfp);
+	cfwrite_int(sound.original_channels, cfp);
+
+	cfwrite_int(static_cast<int>(sound.pcm.size()), cfp);
+	cfwrite_uint(cf_add_chksum_long(0, data, sound.pcm.size()), cfp);
+	if (!sound.pcm.empty()) {
+		cfwrite(data, static_cast<int>(sound.pcm.size()), 1, cfp);
+	}
+
+	cfclose(cfp);
+
+	Pcm_cache_files.push_back({ filename, size });
+	Pcm_cache_size += size;
+}
@@ -0,0 +1,38 @@
+#ifndef _PCM_CACHE_H
+#define _PCM_CACHE_H
+
+#include "globalincs/pstypes.h"
+#include "sound/IAudioFile.h"
+
+// ----------------------------------------------------------------------------------------------
+// PCM CACHE
+//
+// Decoding compressed sounds is most of the time spent loading them.  Once a sound has been decoded, its PCM data is
+// stored in the cache folder, keyed by a checksum of the compressed file and everything else that changes how it is
+// decoded, so later loads of the same file can skip the decoder.  Uncompressed wave files are not cached since reading
+// them is already as cheap as reading the cache.  The cache is kept below a fixed size by deleting the files that
+// were written longest ago.  The -no_sound_cache switch turns the cache off.
+//
+
+struct decoded_sound {
+	sound::AudioFileProperties props;
+	int original_channels = 0;		// before any downmixing for 3D sounds
+	SCP_vector<uint8_t> pcm;
+};
+
+// whether decoded sounds may be loaded from and stored in the cache
+bool pcm_cache_enabled();
+
+// whether the decoded form of the file is worth caching
+bool pcm_cache_wanted(const uint8_t *data, size_t size);
+
+// the key of the file's decoded data, mono is set if it is downmixed for use as a 3D sound
+SCP_string pcm_cache_key(const uint8_t *data, size_t size, bool mono);
+
+// reads the decoded data stored for the key, returns false if there is none
+bool pcm_cache_load(const SCP_string &key, decoded_sound &sound);
+
+// stores the decoded data for the key
+void pcm_cache_save(const SCP_string &key, const decoded_sound &sound);
+
+#endif
@@ -24,8 +24,11 @@
 #include "sound/ds.h"
 #include "sound/ds3d.h"
 #include "sound/dscap.h"
+#include "sound/pcmcache.h"
+#include "tracing/LoadProfiler.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 
 #ifdef WITH_FFMPEG
 #include "sound/ffmpeg/FFmpegWaveFile.h"
@@ -302,55 +305,32 @@ void snd_spew_debug_info()
 	gr_printf_no_resize(sx, sy, "Total sounds : %d\n", game_sounds + interface_sounds + message_sounds);
 }
 
-static std::unique_ptr<sound::IAudioFile> openAudioFile(const char* fileName)
-{
-#ifdef WITH_FFMPEG
-	{
-		std::unique_ptr<sound::IAudioFile> audio_file(new sound::ffmpeg::FFmpegWaveFile());
-
-		if (audio_file->Open(fileName, false)) {
-			return audio_file;
-		}
-	}
-#endif
-
-	return nullptr;
-}
-
 // ---------------------------------------------------------------------------------------
-// snd_load() 
-//
-// Load a sound into memory and prepare it for playback.  The sound will reside in memory as
-// a single instance, and can be played multiple times simultaneously.  Through the magic of
-// DirectSound, only 1 copy of the sound is used.
-//
-// parameters:		entry							=> entry of sound to load
-// parameters:		flags							=> pointer to flags of sound to load, so they
-//													   can be modified if necessary; can be nullptr
-//					allow_hardware_load				=> whether to try to allocate in hardware
+// Sound loading
 //
-// returns:			success => index of sound in Sounds[] array
-//						failure => -1
+// Decoding is most of the work of loading a sound, so sounds are loaded in batches and the
+// files of a batch are decoded at the same time on the worker threads.  Finding and reading
+// the files, the PCM cache and creating the sound buffers all stay on the main thread.
 //
-//int snd_load( char *filename, int hardware, int use_ds3d, int *sig)
-sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_load*/)
-{
-	int type;
-	sound_info* si;
-	loaded_sound* snd;
-	size_t n;
-
-	if (!ds_initialized)
-		return sound_load_id::invalid();
 
-	if (flags && *flags & GAME_SND_NOT_VALID)
-		return sound_load_id::invalid();
+// how many files are decoded at once, this limits the decoded data held before it is uploaded
+static const size_t SND_LOAD_BATCH_SIZE = 32;
+
+struct snd_load_job {
+	bool use_3d = false;
+	SCP_vector<uint8_t> file_data;		// the file as it is on disk, kept until it has been decoded
+	SCP_string cache_key;				// empty if the decoded data is not cached
+	bool from_cache = false;
+	bool valid = false;					// set once the file has been decoded or read from the cache
+	int num_requests = 0;				// requests that still need the decoded data
+	decoded_sound sound;
+};
 
-	if (!VALID_FNAME(entry->filename)) {
-		if (flags)
-			*flags |= GAME_SND_NOT_VALID;
-		return sound_load_id::invalid();
-	}
+// Looks for a loaded sound the entry can use.  If there is none, free_slot is set to the
+// slot in Sounds[] a new sound should go in.
+static sound_load_id snd_find_loaded(game_snd_entry* entry, int* flags, size_t* free_slot)
+{
+	size_t n;
 
 	for (n = 0; n < Sounds.size(); n++) {
 		if ( !(Sounds[n].flags & SND_F_USED) ) {
@@ -373,80 +353,192 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 		}
 	}
 
-	if ( n == Sounds.size() ) {
-		loaded_sound new_sound;
-		new_sound.sid   = -1;
-		new_sound.flags = 0;
+	if (free_slot != nullptr)
+		*free_slot = n;
 
-		Sounds.push_back(new_sound);
+	return sound_load_id::invalid();
+}
+
+// Reads the whole file into the job, or its decoded data if that is in the cache.  The
+// decoder works from memory since cfile may only be used from the main thread.
+static void snd_read_file(const char* filename, snd_load_job& job)
+{
+	auto res = cf_find_file_location_ext(filename, NUM_AUDIO_EXT, audio_ext_list, CF_TYPE_ANY);
+	if (!res.found) {
+		mprintf(("SOUND ==> Could not find sound file '%s'\n", filename));
+		return;
 	}
 
-	snd = &Sounds[n];
+	auto cfp = cfopen_special(res, "rb", CF_TYPE_ANY);
+	if (cfp == nullptr) {
+		mprintf(("SOUND ==> Could not open sound file '%s'\n", filename));
+		return;
+	}
 
-	si = &snd->info;
+	auto length = cfilelength(cfp);
+	bool read = (length > 0);
+	if (read) {
+		job.file_data.resize(static_cast<size_t>(length));
+		read = (cfread(job.file_data.data(), length, 1, cfp) == 1);
+	}
 
-	TRACE_SCOPE(tracing::LoadSound);
+	cfclose(cfp);
 
-	nprintf(("Sound", "SOUND ==> Loading '%s'\n", entry->filename));
+	if (!read) {
+		mprintf(("SOUND ==> Could not read sound file '%s'\n", filename));
+		SCP_vector<uint8_t>().swap(job.file_data);
+		return;
+	}
 
-	std::unique_ptr<sound::IAudioFile> audio_file = openAudioFile(entry->filename);
+	if (pcm_cache_enabled() && pcm_cache_wanted(job.file_data.data(), job.file_data.size())) {
+		job.cache_key = pcm_cache_key(job.file_data.data(), job.file_data.size(), job.use_3d);
 
-	if (audio_file == nullptr) {
-		if (flags)
-			*flags |= GAME_SND_NOT_VALID;
-		return sound_load_id::invalid();
+		if (pcm_cache_load(job.cache_key, job.sound)) {
+			nprintf(("Sound", "SOUND ==> Using cached PCM data for '%s'\n", filename));
+			job.from_cache = true;
+			job.valid = true;
+			SCP_vector<uint8_t>().swap(job.file_data);
+		}
+	}
+}
+
+// Decodes the file of the job.  This runs on the worker threads so it must not touch
+// anything but the job.  Logging is fine, FFmpeg and the decoder print through
+// outwnd_print() which serializes its callers.
+static bool snd_decode(snd_load_job& job)
+{
+#ifdef WITH_FFMPEG
+	std::unique_ptr<sound::IAudioFile> audio_file(new sound::ffmpeg::FFmpegWaveFile());
+
+	if (!audio_file->OpenMem(job.file_data.data(), job.file_data.size())) {
+		return false;
 	}
 
 	auto fileProps = audio_file->getFileProperties();
+	job.sound.original_channels = fileProps.num_channels;
 
-	type = 0;
-	if (flags && *flags & GAME_SND_USE_DS3D) {
-		type |= DS_3D;
+	if (job.use_3d && fileProps.num_channels > 1) {
+		// We need to resample the audio down to one channel
+		sound::ResampleProperties resample;
+		resample.num_channels = 1;
 
-		if (fileProps.num_channels > 1) {
-			// We need to resample the audio down to one channel
-			sound::ResampleProperties resample;
-			resample.num_channels = 1;
+		audio_file->setResamplingProperties(resample);
+		fileProps = audio_file->getFileProperties(); // Refresh properties so that we have accurate information
+	}
 
-			audio_file->setResamplingProperties(resample);
-			fileProps = audio_file->getFileProperties(); // Refresh properties so that we have accurate information
+	job.sound.props = fileProps;
 
-#ifndef NDEBUG
-			// Retail has a few sounds that triggers this warning so we need to ignore those
-			const char* warning_ignore_list[] = {
-				"l_hit.wav",
-				"m_hit.wav",
-				"s_hit_2.wav",
-				"Pirate.wav",
-			};
-
-			bool show_warning = true;
-			for (auto& name : warning_ignore_list) {
-				if (!stricmp(name, entry->filename)) {
-					show_warning = false;
-					break;
-				}
-			}
+	auto& audio_buffer = job.sound.pcm;
+	audio_buffer.reserve(fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels);
 
-			if (show_warning) {
-				if (mod_supports_version(3, 8, 0)) {
-					// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
-					// with more than one channel. This will silence the warnings for any mod that does not support
-					// 3.8.0.
-					Warning(LOCATION,
-							"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
-							"one channel.",
-							entry->filename);
-				} else {
-					mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
-							 "only have one channel.\n",
-							 entry->filename));
-				}
-			}
+	SCP_vector<uint8_t> buffer(fileProps.sample_rate * fileProps.bytes_per_sample * fileProps.num_channels);
+	int read;
+	while((read = audio_file->Read(&buffer[0], buffer.size())) >= 0) {
+		if (read == 0) {
+			// buffer not large enough
+			buffer.resize(buffer.size() * 2);
+		} else {
+			audio_buffer.insert(audio_buffer.end(), buffer.begin(), std::next(buffer.begin(), read));
+		}
+	}
+
+	return true;
+#else
+	return false;
 #endif
+}
+
+static void snd_decode_jobs(SCP_vector<snd_load_job>& jobs)
+{
+	SCP_vector<snd_load_job*> to_decode;
+	for (auto& job : jobs) {
+		if (!job.valid && !job.file_data.empty())
+			to_decode.push_back(&job);
+	}
+
+	auto decode = [&to_decode](size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i) {
+			auto job = to_decode[i];
+			job->valid = snd_decode(*job);
+			SCP_vector<uint8_t>().swap(job->file_data);
 		}
+	};
+
+	if (threading::is_threading() && to_decode.size() > 1) {
+		threading::parallel_for(to_decode.size(), 1, decode);
+	} else {
+		decode(0, to_decode.size());
+	}
+}
+
+#ifndef NDEBUG
+static void snd_warn_3d_channels(const char* filename)
+{
+	// Retail has a few sounds that triggers this warning so we need to ignore those
+	const char* warning_ignore_list[] = {
+		"l_hit.wav",
+		"m_hit.wav",
+		"s_hit_2.wav",
+		"Pirate.wav",
+	};
+
+	for (auto& name : warning_ignore_list) {
+		if (!stricmp(name, filename))
+			return;
+	}
+
+	if (mod_supports_version(3, 8, 0)) {
+		// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
+		// with more than one channel. This will silence the warnings for any mod that does not support
+		// 3.8.0.
+		Warning(LOCATION,
+				"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
+				"one channel.",
+				filename);
+	} else {
+		mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
+				 "only have one channel.\n",
+				 filename));
+	}
+}
+#endif
+
+// Creates the sound buffer for a request from the decoded data of its job
+static sound_load_id snd_finish_load(game_snd_entry* entry, int* flags, snd_load_job& job)
+{
+	size_t n = 0;
+
+	// an earlier request of the batch may have loaded the file already
+	auto id = snd_find_loaded(entry, flags, &n);
+	if (id.isValid())
+		return id;
+
+	if (!job.valid) {
+		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", entry->filename));
+		if (flags)
+			*flags |= GAME_SND_NOT_VALID;
+		return sound_load_id::invalid();
+	}
+
+	if ( n == Sounds.size() ) {
+		loaded_sound new_sound;
+		new_sound.sid   = -1;
+		new_sound.flags = 0;
+
+		Sounds.push_back(new_sound);
 	}
 
+	auto snd = &Sounds[n];
+	auto si = &snd->info;
+
+	const auto& fileProps = job.sound.props;
+
+#ifndef NDEBUG
+	if (job.use_3d && job.sound.original_channels > 1) {
+		snd_warn_3d_channels(entry->filename);
+	}
+#endif
+
 	// Load was a success
 	si->n_channels        = fileProps.num_channels; // 16-bit channel count (nChannels)
 	si->sample_rate       = fileProps.sample_rate;  // 32-bit sample rate (nSamplesPerSec)
@@ -457,7 +549,7 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 
 	snd->uncompressed_size = si->size;
 
-	auto rc = ds_load_buffer(&snd->sid, type, audio_file.get());
+	auto rc = ds_load_buffer(&snd->sid, fileProps, job.sound.pcm);
 	if (rc == -1) {
 		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", entry->filename));
 		if (flags)
@@ -465,6 +557,12 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 		return sound_load_id::invalid();
 	}
 
+	// only the first sound made from newly decoded data needs to store it
+	if (!job.from_cache && !job.cache_key.empty()) {
+		pcm_cache_save(job.cache_key, job.sound);
+		job.from_cache = true;
+	}
+
 	// NOTE: "si" values can change once loaded in the buffer
 	snd->duration = fl2i(1000.0f * fileProps.duration);
 
@@ -481,6 +579,146 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 	return sound_load_id(static_cast<int>(n));
 }
 
+// Loads the sounds of the requests, with the results in the same order.  If busy_text is set,
+// game_busy() is called with it as each request is done.
+static void snd_load_requests(const SCP_vector<snd_load_request>& requests, SCP_vector<sound_load_id>& ids, const char* busy_text)
+{
+	ids.assign(requests.size(), sound_load_id::invalid());
+
+	if (!ds_initialized)
+		return;
+
+	TRACE_SCOPE(tracing::LoadSound);
+
+	size_t next = 0;
+	while (next < requests.size()) {
+		SCP_vector<snd_load_job> jobs;
+		SCP_unordered_map<SCP_string, size_t> job_lookup;
+		SCP_vector<int> request_jobs;
+
+		// gather requests until there are enough files to decode
+		auto first = next;
+		jobs.reserve(SND_LOAD_BATCH_SIZE);
+		for (; next < requests.size() && jobs.size() < SND_LOAD_BATCH_SIZE; ++next) {
+			auto entry = requests[next].entry;
+			auto flags = requests[next].flags;
+
+			request_jobs.push_back(-1);
+
+			// these fail when their turn comes below
+			if ((flags && *flags & GAME_SND_NOT_VALID) || !VALID_FNAME(entry->filename))
+				continue;
+
+			ids[next] = snd_find_loaded(entry, flags, nullptr);
+			if (ids[next].isValid())
+				continue;
+
+			bool use_3d = flags && (*flags & GAME_SND_USE_DS3D);
+
+			// the same file is only decoded once per batch
+			SCP_string job_name = entry->filename;
+			SCP_tolower(job_name);
+			if (use_3d)
+				job_name += "|3d";
+
+			auto it = job_lookup.find(job_name);
+			if (it == job_lookup.end()) {
+				nprintf(("Sound", "SOUND ==> Loading '%s'\n", entry->filename));
+
+				it = job_lookup.emplace(job_name, jobs.size()).first;
+				jobs.emplace_back();
+				jobs.back().use_3d = use_3d;
+
+				snd_read_file(entry->filename, jobs.back());
+			}
+
+			jobs[it->second].num_requests++;
+			request_jobs.back() = static_cast<int>(it->second);
+		}
+
+		snd_decode_jobs(jobs);
+
+		for (auto i = first; i < next; ++i) {
+			auto entry = requests[i].entry;
+			auto flags = requests[i].flags;
+			auto job_idx = request_jobs[i - first];
+
+			if (busy_text != nullptr)
+				game_busy(busy_text);	// Animate loading cursor... does nothing if loading screen not active.
+
+			// once one entry of a sound has failed, the entries after it are not loaded, just like
+			// when they are loaded one by one
+			if (flags && *flags & GAME_SND_NOT_VALID) {
+				ids[i] = sound_load_id::invalid();
+				continue;
+			}
+
+			if (!VALID_FNAME(entry->filename)) {
+				if (flags)
+					*flags |= GAME_SND_NOT_VALID;
+				continue;
+			}
+
+			if (job_idx < 0)
+				continue;
+
+			auto& job = jobs[job_idx];
+			ids[i] = snd_finish_load(entry, flags, job);
+
+			// nothing else needs the decoded data
+			if (--job.num_requests == 0)
+				job.sound = decoded_sound();
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------
+// snd_load() 
+//
+// Load a sound into memory and prepare it for playback.  The sound will reside in memory as
+// a single instance, and can be played multiple times simultaneously.  Through the magic of
+// DirectSound, only 1 copy of the sound is used.
+//
+// parameters:		entry							=> entry of sound to load
+// parameters:		flags							=> pointer to flags of sound to load, so they
+//													   can be modified if necessary; can be nullptr
+//					allow_hardware_load				=> whether to try to allocate in hardware
+//
+// returns:			success => index of sound in Sounds[] array
+//						failure => -1
+//
+//int snd_load( char *filename, int hardware, int use_ds3d, int *sig)
+sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_load*/)
+{
+	SCP_vector<snd_load_request> requests;
+	requests.push_back({ entry, flags });
+
+	SCP_vector<sound_load_id> ids;
+	snd_load_requests(requests, ids, nullptr);
+
+	return ids[0];
+}
+
+// ---------------------------------------------------------------------------------------
+// snd_load_batch() 
+//
+// Load the sounds of several entries at once, which is a lot faster than calling snd_load()
+// for each of them since the files are decoded in parallel.  The id of each loaded sound is
+// stored in its entry, entries that fail to load keep an invalid id.  If busy_text is set,
+// game_busy() is called with it for every request as its sound is done.
+//
+void snd_load_batch(const SCP_vector<snd_load_request>& requests, const char* busy_text)
+{
+	LOAD_PROFILE_PHASE(SoundLoad, static_cast<int>(requests.size()));
+
+	SCP_vector<sound_load_id> ids;
+	snd_load_requests(requests, ids, busy_text);
+
+	for (size_t i = 0; i < requests.size(); ++i) {
+		requests[i].entry->id = ids[i];
+	}
+}
+
 // ---------------------------------------------------------------------------------------
 // snd_unload() 
 //
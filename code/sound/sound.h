@@ -134,6 +134,15 @@ void snd_set_voice_volume(float volume);
 //int	snd_load( char *filename, int hardware=0, int three_d=0, int *sig=NULL );
 sound_load_id snd_load(game_snd_entry* entry, int* flags, int allow_hardware_load = 0);
 
+struct snd_load_request {
+	game_snd_entry* entry;
+	int* flags; //!< can be nullptr
+};
+
+// Loads the sounds of all requests, decoding them in parallel. Sets the id of each entry.
+// If busy_text is set, game_busy() is called with it as each request is done.
+void snd_load_batch(const SCP_vector<snd_load_request>& requests, const char* busy_text = nullptr);
+
 int snd_unload(sound_load_id sndnum);
 void	snd_unload_all();
 
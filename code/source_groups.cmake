@@ -81,6 +81,8 @@ add_file_folder("AI"
 	ai/aiinternal.h
 	ai/ailua.cpp
 	ai/ailua.h
+	ai/aischedule.cpp
+	ai/aischedule.h
 	ai/aiturret.cpp
 )
 
@@ -981,6 +983,10 @@ add_file_folder("Network"
 	network/multi_respawn.h
 	network/multi_sexp.cpp
 	network/multi_sexp.h
+	network/multi_shard.cpp
+	network/multi_shard.h
+	network/multi_soak.cpp
+	network/multi_soak.h
 	network/multi_sw.cpp
 	network/multi_sw.h
 	network/multi_team.cpp
@@ -1041,6 +1047,8 @@ add_file_folder("Object"
 	object/object.h
 	object/objectdock.cpp
 	object/objectdock.h
+	object/objectgrid.cpp
+	object/objectgrid.h
 	object/objectshield.cpp
 	object/objectshield.h
 	object/objectsnd.cpp
@@ -1314,7 +1322,11 @@ add_file_folder("Scripting"
 	scripting/hook_api.h
 	scripting/hook_conditions.cpp
 	scripting/hook_conditions.h
+	scripting/hook_profiler.cpp
+	scripting/hook_profiler.h
 	scripting/lua.cpp
+	scripting/lua_pool.cpp
+	scripting/lua_pool.h
 	scripting/scripting.cpp
 	scripting/scripting.h
 	scripting/scripting_doc.h
@@ -1608,6 +1620,10 @@ add_file_folder("Ship"
 	ship/shipfx.h
 	ship/shiphit.cpp
 	ship/shiphit.h
+	ship/subsysbounds.cpp
+	ship/subsysbounds.h
+	ship/subsyspool.cpp
+	ship/subsyspool.h
 	ship/subsysdamage.h
 	ship/ship_flags.h
 )
@@ -1628,6 +1644,8 @@ add_file_folder("Sound"
 	sound/IAudioFile.h
 	sound/openal.cpp
 	sound/openal.h
+	sound/pcmcache.cpp
+	sound/pcmcache.h
 	sound/phrases.xml
 	sound/rtvoice.cpp
 	sound/rtvoice.h
@@ -1704,6 +1722,8 @@ add_file_folder("Tracing"
 	tracing/categories.h
 	tracing/FrameProfiler.h
 	tracing/FrameProfiler.cpp
+	tracing/LoadProfiler.h
+	tracing/LoadProfiler.cpp
 	tracing/MainFrameTimer.h
 	tracing/MainFrameTimer.cpp
 	tracing/Monitor.h
@@ -1749,6 +1769,8 @@ add_file_folder("Utils"
 	utils/id.h
 	utils/join_string.h
 	utils/modular_curves.h
+	utils/radix_sort.cpp
+	utils/radix_sort.h
 	utils/Random.cpp
 	utils/Random.h
 	utils/RandomRange.h
@@ -0,0 +1,265 @@
+#include "tracing/LoadProfiler.h"
+
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "globalincs/version.h"
+#include "io/timer.h"
+#include "libs/jansson.h"
+#include "parse/parselo.h"
+
+#include <ctime>
+#include <thread>
+
+namespace {
+
+using namespace tracing;
+using namespace tracing::load_profile;
+
+const size_t NUM_PHASES = static_cast<size_t>(Phase::NUM_PHASES);
+
+struct phase_stats {
+	std::uint64_t time = 0;		// in nanoseconds, without the time of nested phases
+	std::uint64_t bytes_read = 0;
+	int count = 0;
+	int calls = 0;
+};
+
+struct open_phase {
+	Phase phase;
+	std::uint64_t start_time;
+	std::uint64_t start_bytes;
+	std::uint64_t nested_time;
+	std::uint64_t nested_bytes;
+};
+
+bool Load_profile_active = false;
+std::thread::id Load_profile_thread;
+
+SCP_string Load_profile_mission;
+std::uint64_t Load_profile_start_time = 0;
+std::uint64_t Load_profile_start_bytes = 0;
+
+phase_stats Load_profile_phases[NUM_PHASES];
+SCP_vector<open_phase> Load_profile_stack;
+
+const Category& phase_category(Phase phase)
+{
+	switch (phase) {
+	case Phase::Parse:
+		return LoadPhaseParse;
+	case Phase::ObjectCreation:
+		return LoadPhaseObjectCreation;
+	case Phase::ModelLoad:
+		return LoadPhaseModelLoad;
+	case Phase::TexturePageIn:
+		return LoadPhaseTexturePageIn;
+	case Phase::SoundLoad:
+		return LoadPhaseSoundLoad;
+	case Phase::ScriptInit:
+		return LoadPhaseScriptInit;
+	case Phase::LoadingScreen:
+		return LoadPhaseLoadingScreen;
+	default:
+		UNREACHABLE("Unhandled load phase %d!", static_cast<int>(phase));
+		return LoadPhaseParse;
+	}
+}
+
+bool on_profiled_thread()
+{
+	return Load_profile_active && std::this_thread::get_id() == Load_profile_thread;
+}
+
+json_t* ms_value(std::uint64_t nanoseconds)
+{
+	return json_real(static_cast<double>(nanoseconds) / 1000000.0);
+}
+
+std::unique_ptr<json_t> build_report(bool success, std::uint64_t total_time, std::uint64_t total_bytes)
+{
+	std::unique_ptr<json_t> report(json_object());
+
+	json_object_set_new(report.get(), "mission", json_string(Load_profile_mission.c_str()));
+	json_object_set_new(report.get(), "version", json_string(gameversion::get_version_string().c_str()));
+	json_object_set_new(report.get(), "mod", json_string(Cmdline_mod != nullptr ? Cmdline_mod : ""));
+	json_object_set_new(report.get(), "time", json_integer(static_cast<json_int_t>(time(nullptr))));
+	json_object_set_new(report.get(), "success", json_boolean(success));
+
+	json_object_set_new(report.get(), "total_ms", ms_value(total_time));
+	json_object_set_new(report.get(), "bytes_read", json_integer(static_cast<json_int_t>(total_bytes)));
+
+	std::uint64_t phase_time = 0;
+	std::uint64_t phase_bytes = 0;
+
+	auto phases = json_array();
+	for (size_t i = 0; i < NUM_PHASES; ++i) {
+		const auto& stats = Load_profile_phases[i];
+
+		auto phase = json_object();
+		json_object_set_new(phase, "name", json_string(phase_name(static_cast<Phase>(i))));
+		json_object_set_new(phase, "time_ms", ms_value(stats.time));
+		json_object_set_new(phase, "count", json_integer(stats.count));
+		json_object_set_new(phase, "calls", json_integer(stats.calls));
+		json_object_set_new(phase, "bytes_read", json_integer(static_cast<json_int_t>(stats.bytes_read)));
+		json_array_append_new(phases, phase);
+
+		phase_time += stats.time;
+		phase_bytes += stats.bytes_read;
+	}
+	json_object_set_new(report.get(), "phases", phases);
+
+	// everything that happened outside of a marked phase
+	auto other = json_object();
+	json_object_set_new(other, "time_ms", ms_value(total_time > phase_time ? total_time - phase_time : 0));
+	json_object_set_new(other, "bytes_read", json_integer(static_cast<json_int_t>(total_bytes > phase_bytes ? total_bytes - phase_bytes : 0)));
+	json_object_set_new(report.get(), "other", other);
+
+	return report;
+}
+
+void write_report(const json_t* report)
+{
+	SCP_string filename = Load_profile_mission;
+	drop_extension(filename);
+	filename = "load_profile_" + filename + ".json";
+
+	auto cfp = cfopen(filename.c_str(), "wt", CF_TYPE_DATA);
+	if (cfp == nullptr) {
+		mprintf(("LOAD PROFILE: Unable to open %s for writing!\n", filename.c_str()));
+		return;
+	}
+
+	json_dump_cfile(report, cfp, JSON_INDENT(2) | JSON_PRESERVE_ORDER);
+	cfclose(cfp);
+
+	mprintf(("LOAD PROFILE: Wrote %s\n", filename.c_str()));
+}
+
+}
+
+namespace tracing {
+namespace load_profile {
+
+const char* phase_name(Phase phase)
+{
+	switch (phase) {
+	case Phase::Parse:
+		return "parse";
+	case Phase::ObjectCreation:
+		return "object_creation";
+	case Phase::ModelLoad:
+		return "model_load";
+	case Phase::TexturePageIn:
+		return "texture_page_in";
+	case Phase::SoundLoad:
+		return "sound_load";
+	case Phase::ScriptInit:
+		return "script_init";
+	case Phase::LoadingScreen:
+		return "loading_screen";
+	default:
+		UNREACHABLE("Unhandled load phase %d!", static_cast<int>(phase));
+		return "";
+	}
+}
+
+void begin(const char* mission_filename)
+{
+	if (!Cmdline_profile_load) {
+		return;
+	}
+
+	Assertion(!Load_profile_active, "A mission load is already being profiled!");
+
+	Load_profile_active = true;
+	Load_profile_thread = std::this_thread::get_id();
+
+	Load_profile_mission = mission_filename;
+	Load_profile_start_time = timer_get_nanoseconds();
+	Load_profile_start_bytes = cf_get_bytes_read();
+
+	for (auto& stats : Load_profile_phases) {
+		stats = phase_stats();
+	}
+	Load_profile_stack.clear();
+}
+
+void end(bool success)
+{
+	if (!on_profiled_thread()) {
+		return;
+	}
+
+	Assertion(Load_profile_stack.empty(), "Mission load profile ended inside of the %s phase!", phase_name(Load_profile_stack.back().phase));
+
+	auto total_time = timer_get_nanoseconds() - Load_profile_start_time;
+	auto total_bytes = cf_get_bytes_read() - Load_profile_start_bytes;
+
+	Load_profile_active = false;
+
+	auto report = build_report(success, total_time, total_bytes);
+	write_report(report.get());
+
+	mprintf(("LOAD PROFILE: %s took %.1f ms and read %.1f MB\n", Load_profile_mission.c_str(), total_time / 1000000.0, total_bytes / (1024.0 * 1024.0)));
+	for (size_t i = 0; i < NUM_PHASES; ++i) {
+		const auto& stats = Load_profile_phases[i];
+		mprintf(("LOAD PROFILE:   %-16s %9.1f ms %6d items %9.1f KB\n", phase_name(static_cast<Phase>(i)), stats.time / 1000000.0, stats.count, stats.bytes_read / 1024.0));
+	}
+}
+
+bool is_active()
+{
+	return Load_profile_active;
+}
+
+void add_count(Phase phase, int count)
+{
+	if (!on_profiled_thread()) {
+		return;
+	}
+
+	Load_profile_phases[static_cast<size_t>(phase)].count += count;
+}
+
+ScopedPhase::ScopedPhase(Phase phase, int count) : _phase(phase), _active(on_profiled_thread()), _event(phase_category(phase))
+{
+	if (!_active) {
+		return;
+	}
+
+	auto& stats = Load_profile_phases[static_cast<size_t>(_phase)];
+	stats.count += count;
+	++stats.calls;
+
+	Load_profile_stack.push_back({_phase, timer_get_nanoseconds(), cf_get_bytes_read(), 0, 0});
+}
+
+ScopedPhase::~ScopedPhase()
+{
+	// the load may have ended while the phase was open
+	if (!_active || !on_profiled_thread() || Load_profile_stack.empty()) {
+		return;
+	}
+
+	auto entry = Load_profile_stack.back();
+	Load_profile_stack.pop_back();
+
+	Assertion(entry.phase == _phase, "Load phases %s and %s overlap!", phase_name(entry.phase), phase_name(_phase));
+
+	auto time = timer_get_nanoseconds() - entry.start_time;
+	auto bytes = cf_get_bytes_read() - entry.start_bytes;
+
+	auto& stats = Load_profile_phases[static_cast<size_t>(_phase)];
+	stats.time += time - MIN(time, entry.nested_time);
+	stats.bytes_read += bytes - MIN(bytes, entry.nested_bytes);
+
+	if (!Load_profile_stack.empty()) {
+		Load_profile_stack.back().nested_time += time;
+		Load_profile_stack.back().nested_bytes += bytes;
+	}
+
+	counter::value(LoadBytesRead, static_cast<float>((cf_get_bytes_read() - Load_profile_start_bytes) / 1024));
+}
+
+}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include "tracing/tracing.h"
+
+/** @file
+ *  @ingroup tracing
+ *
+ *  The mission load profiler breaks down where the time of a mission load goes. It is enabled with -profile_load.
+ *
+ *  Loading code marks its phases with LOAD_PROFILE_PHASE(). Phases nest, the time and the bytes read through cfread()
+ *  while a phase is active are added to the innermost one, so a model loaded while a ship is created only counts as
+ *  model load time. Only the thread that started the load is profiled. At the end of every mission load a JSON report
+ *  named load_profile_<mission>.json is written to the data directory. The phases are also submitted as trace events
+ *  so that they show up in the -json_profiling output.
+ */
+
+namespace tracing {
+namespace load_profile {
+
+enum class Phase {
+	Parse,
+	ObjectCreation,
+	ModelLoad,
+	TexturePageIn,
+	SoundLoad,
+	ScriptInit,
+	LoadingScreen,
+
+	NUM_PHASES
+};
+
+/**
+ * @brief Gets the name of a phase as it is used in the report
+ */
+const char* phase_name(Phase phase);
+
+/**
+ * @brief Starts profiling a mission load, does nothing unless -profile_load was given
+ * @param mission_filename The file name of the mission that is being loaded
+ */
+void begin(const char* mission_filename);
+
+/**
+ * @brief Finishes profiling the current mission load and writes its report
+ * @param success Whether the mission was loaded
+ */
+void end(bool success);
+
+/**
+ * @brief Checks if a mission load is being profiled right now
+ */
+bool is_active();
+
+/**
+ * @brief Adds items to the count of a phase, for phases that handle a number of things that is only known later
+ */
+void add_count(Phase phase, int count);
+
+/**
+ * @brief Class for marking a load phase for the lifetime of the object
+ */
+class ScopedPhase {
+	Phase _phase;
+	bool _active;
+	complete::ScopedCompleteEvent _event;
+
+ public:
+	/**
+	 * @param phase The phase that starts
+	 * @param count How many items the phase handles
+	 */
+	explicit ScopedPhase(Phase phase, int count = 1);
+	~ScopedPhase();
+
+	ScopedPhase(const ScopedPhase&) = delete;
+	ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+}
+}
+
+#define LOAD_PROFILE_PHASE(phase, ...) ::tracing::load_profile::ScopedPhase SCP_TOKEN_CONCAT(load_profile_phase, __LINE__)(::tracing::load_profile::Phase::phase, ##__VA_ARGS__)
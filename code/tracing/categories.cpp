@@ -141,6 +141,15 @@ Category PageInSingleBitmap("Page in single bitmap", false);
 Category ShipPageIn("Ship page in", false);
 Category WeaponPageIn("Weapon page in", false);
 
+Category LoadPhaseParse("Load phase: parse", false);
+Category LoadPhaseObjectCreation("Load phase: object creation", false);
+Category LoadPhaseModelLoad("Load phase: model load", false);
+Category LoadPhaseTexturePageIn("Load phase: texture page in", false);
+Category LoadPhaseSoundLoad("Load phase: sound load", false);
+Category LoadPhaseScriptInit("Load phase: script init", false);
+Category LoadPhaseLoadingScreen("Load phase: loading screen", false);
+Category LoadBytesRead("Load bytes read (KB)", false);
+
 Category RenderDecals("Render all decals", true);
 Category RenderSingleDecal("Render single decal", true);
 Category GpuHeapAllocate("GPU heap allocate", false);
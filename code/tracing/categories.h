@@ -155,6 +155,16 @@ extern Category PageInSingleBitmap;
 extern Category ShipPageIn;
 extern Category WeaponPageIn;
 
+// Mission load profiler phases, see LoadProfiler.h
+extern Category LoadPhaseParse;
+extern Category LoadPhaseObjectCreation;
+extern Category LoadPhaseModelLoad;
+extern Category LoadPhaseTexturePageIn;
+extern Category LoadPhaseSoundLoad;
+extern Category LoadPhaseScriptInit;
+extern Category LoadPhaseLoadingScreen;
+extern Category LoadBytesRead;
+
 extern Category RenderDecals;
 extern Category RenderSingleDecal;
 
@@ -0,0 +1,63 @@
+
+#include "radix_sort.h"
+
+namespace util {
+
+namespace {
+const int RADIX_BITS = 8;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+const int RADIX_PASSES = 64 / RADIX_BITS;
+}
+
+void radix_sort(SCP_vector<radix_sort_item>& items, SCP_vector<radix_sort_item>& scratch)
+{
+	const size_t count = items.size();
+
+	if (count < 2) {
+		return;
+	}
+
+	// count every byte of every key in a single sweep
+	size_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+
+	for (const auto& item : items) {
+		for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+			++histograms[pass][(item.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+		}
+	}
+
+	scratch.resize(count);
+
+	auto src = &items;
+	auto dst = &scratch;
+
+	for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+		auto& histogram = histograms[pass];
+		const int shift = pass * RADIX_BITS;
+
+		// all keys share this byte, so this pass would not change the order
+		if (histogram[((*src)[0].key >> shift) & (RADIX_BUCKETS - 1)] == count) {
+			continue;
+		}
+
+		size_t offsets[RADIX_BUCKETS];
+		size_t total = 0;
+		for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+			offsets[bucket] = total;
+			total += histogram[bucket];
+		}
+
+		for (const auto& item : *src) {
+			(*dst)[offsets[(item.key >> shift) & (RADIX_BUCKETS - 1)]++] = item;
+		}
+
+		std::swap(src, dst);
+	}
+
+	// the sorted data ended up in the scratch buffer
+	if (src != &items) {
+		items.swap(scratch);
+	}
+}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace util {
+
+/**
+ * @brief An item sorted by radix_sort(), the value is carried along with its key
+ */
+struct radix_sort_item {
+	uint64_t key;
+	int value;
+};
+
+/**
+ * @brief Stable LSD radix sort of the items by their keys
+ *
+ * Sorts one byte of the key per pass and skips all passes in which every key has the same byte, so keys which only
+ * use a few of their bits are cheap to sort.
+ *
+ * @param items The items to sort, sorted in place
+ * @param scratch Temporary storage, resized as needed.  Keep it around between calls to avoid allocations.
+ */
+void radix_sort(SCP_vector<radix_sort_item>& items, SCP_vector<radix_sort_item>& scratch);
+
+}
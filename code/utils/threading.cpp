@@ -20,7 +20,7 @@ namespace threading {
 
 	static std::condition_variable wait_for_task;
 	static std::mutex wait_for_task_mutex;
-	static bool wait_for_task_condition;
+	static size_t wait_for_task_generation = 0;	//Counts the tasks started so far, so every worker runs every task exactly once
 
 	static std::condition_variable wait_for_spindown_tasks;
 	static std::mutex wait_for_spindown_task_mutex;
@@ -34,8 +34,20 @@ namespace threading {
 
 	static SCP_vector<std::thread> worker_threads;
 
+	static const std::function<void(size_t, size_t)>* parallel_for_body = nullptr;
+	static size_t parallel_for_count;
+	static size_t parallel_for_chunk_size;
+	static std::atomic_size_t parallel_for_next;
+
 	//Internal Functions
-	static void mp_worker_thread_main(size_t threadIdx) {
+	static void parallel_for_worker() {
+		size_t begin;
+		while ((begin = parallel_for_next.fetch_add(parallel_for_chunk_size, std::memory_order_relaxed)) < parallel_for_count) {
+			(*parallel_for_body)(begin, std::min(begin + parallel_for_chunk_size, parallel_for_count));
+		}
+	}
+
+	static void mp_worker_thread_main(size_t threadIdx, size_t seen_generation) {
 		while(true) {
 			{
 				std::scoped_lock lock {wait_for_spindown_task_mutex};
@@ -45,9 +57,10 @@ namespace threading {
 			//We're waiting for a new task, so spindown was successful
 			{
 				std::unique_lock<std::mutex> lk(wait_for_task_mutex);
-				wait_for_task.wait(lk, []() { return wait_for_task_condition; });
+				wait_for_task.wait(lk, [seen_generation]() { return wait_for_task_generation != seen_generation; });
+				seen_generation = wait_for_task_generation;
 			}
-			//Notify that we passed the wait and can now start processing. This is necessary, as slow thread wakeups in very low workloads could cause the wait_for_task_condition to be false, never waking up the thread, locking on spindown wait
+			//Notify that we passed the wait and can now start processing. A worker that finishes quickly waits for the next task instead of picking up the current one again, so this counts every worker exactly once
 			{
 				std::scoped_lock lock {wait_for_spinup_task_mutex};
 				++wait_for_spinup_tasks_counter;
@@ -61,6 +74,9 @@ namespace threading {
 				case WorkerThreadTask::COLLISION:
 					collide_mp_worker_thread(threadIdx);
 					break;
+				case WorkerThreadTask::PARALLEL_FOR:
+					parallel_for_worker();
+					break;
 				default:
 					UNREACHABLE("Invalid threaded worker task!");
 			}
@@ -175,7 +191,7 @@ namespace threading {
 		worker_task.store(task);
 		{
 			std::scoped_lock lock {wait_for_task_mutex};
-			wait_for_task_condition = true;
+			++wait_for_task_generation;
 			wait_for_task.notify_all();
 		}
 	}
@@ -187,10 +203,6 @@ namespace threading {
 			wait_for_spinup_tasks.wait(lk, []() { return wait_for_spinup_tasks_counter >= num_threads; });
 			wait_for_spinup_tasks_counter = 0;
 		}
-		{
-			std::scoped_lock lock {wait_for_task_mutex};
-			wait_for_task_condition = false;
-		}
 	}
 
 	void spin_down_wait_complete() {
@@ -217,9 +229,19 @@ namespace threading {
 
 		mprintf(("Spinning up threadpool with %d threads...\n", static_cast<int>(num_threads)));
 
+		//New workers only wait for tasks started after this point, even if they take a while to come up
+		size_t generation;
+		{
+			std::scoped_lock lock {wait_for_task_mutex};
+			generation = wait_for_task_generation;
+		}
+
 		for (size_t i = 0; i < num_threads; i++) {
-			worker_threads.emplace_back([i](){ mp_worker_thread_main(i); });
+			worker_threads.emplace_back([i, generation](){ mp_worker_thread_main(i, generation); });
 		}
+
+		//Otherwise a worker that is slow to come up could report its first spindown after the first task already started
+		spin_down_wait_complete();
 	}
 
 	void shut_down_task_pool() {
@@ -230,6 +252,18 @@ namespace threading {
 		for(auto& thread : worker_threads) {
 			thread.join();
 		}
+
+		//Leave the pool in a state where it can be started again
+		//The exiting workers still counted themselves as spun up, which would let the first spindown after a restart return too early
+		worker_threads.clear();
+		{
+			std::scoped_lock lock {wait_for_spinup_task_mutex};
+			wait_for_spinup_tasks_counter = 0;
+		}
+		{
+			std::scoped_lock lock {wait_for_spindown_task_mutex};
+			wait_for_spindown_tasks_counter = 0;
+		}
 	}
 
 	bool is_threading() {
@@ -239,4 +273,33 @@ namespace threading {
 	size_t get_num_workers() {
 		return worker_threads.size();
 	}
+
+	void parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t, size_t)>& body) {
+		Assertion(chunk_size > 0, "parallel_for needs a chunk size of at least one!");
+
+		if (count == 0) {
+			return;
+		}
+
+		//Not worth waking up the pool for a single chunk
+		if (!is_threading() || count <= chunk_size) {
+			body(0, count);
+			return;
+		}
+
+		parallel_for_body = &body;
+		parallel_for_count = count;
+		parallel_for_chunk_size = chunk_size;
+		parallel_for_next.store(0);
+
+		spin_up_threaded_task(WorkerThreadTask::PARALLEL_FOR);
+
+		//The main thread pitches in as well, and only stops once every chunk has been handed out
+		parallel_for_worker();
+
+		spin_down_threaded_task();
+		spin_down_wait_complete();
+
+		parallel_for_body = nullptr;
+	}
 }
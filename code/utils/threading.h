@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#include <functional>
 
 namespace threading {
-	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION };
+	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION, PARALLEL_FOR };
 
 	//Call this to start a task on the task pool. Note that task-specific data must be set up before calling this.
 	void spin_up_threaded_task(WorkerThreadTask task);
@@ -19,4 +21,8 @@ namespace threading {
 
 	bool is_threading();
 	size_t get_num_workers();
+
+	//Calls body(begin, end) for consecutive ranges of at most chunk_size out of [0, count), spread over the task pool and the calling thread.
+	//Blocks until all ranges are done. Only call this from the main thread, and only with a body that is safe to run concurrently with itself.
+	void parallel_for(size_t count, size_t chunk_size, const std::function<void(size_t, size_t)>& body);
 }
\ No newline at end of file
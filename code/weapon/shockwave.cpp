@@ -16,6 +16,7 @@
 #include "model/modelrender.h"
 #include "nebula/neb.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "options/Option.h"
 #include "render/3d.h"
 #include "render/batching.h"
@@ -39,6 +40,15 @@ shockwave Shockwaves[MAX_SHOCKWAVES];
 shockwave Shockwave_list;
 int Shockwave_inited = 0;
 
+// edge length of the cells of the grid shockwaves look for targets in
+static const float SHOCKWAVE_GRID_CELL_SIZE = 500.0f;
+
+// everything a shockwave could blast, gathered once per frame by shockwave_move_all()
+static object_grid Shockwave_targets(SHOCKWAVE_GRID_CELL_SIZE);
+static int Shockwave_target_signatures[MAX_OBJECTS];
+static bool Shockwave_targets_valid = false;
+static SCP_vector<int> Shockwave_found_targets;
+
 // -----------------------------------------------------------
 // Function macros
 // -----------------------------------------------------------
@@ -264,6 +274,51 @@ int shockwave_get_framenum(const int sw_idx, const int ani_id)
 	return bm_get_anim_frame(ani_id, sw->time_elapsed, sw->total_time);
 }
 
+/**
+ * Sort everything a shockwave could blast into a grid.  Nothing moves while the shockwaves are processed, so the grid
+ * holds for all of them.
+ */
+static void shockwave_gather_targets()
+{
+	Shockwave_targets.clear();
+
+	for (auto objp : list_range(&obj_used_list)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		float bound;
+
+		switch (objp->type) {
+		case OBJ_SHIP: {
+			// ships are measured by their bounding box, so take the farthest corner of it
+			auto pm = model_get(Ship_info[Ships[objp->instance].ship_info_index].model_num);
+			vec3d extent;
+			extent.xyz.x = MAX(fabsf(pm->mins.xyz.x), fabsf(pm->maxs.xyz.x));
+			extent.xyz.y = MAX(fabsf(pm->mins.xyz.y), fabsf(pm->maxs.xyz.y));
+			extent.xyz.z = MAX(fabsf(pm->mins.xyz.z), fabsf(pm->maxs.xyz.z));
+			bound = vm_vec_mag(&extent);
+			break;
+		}
+		case OBJ_ASTEROID:
+			bound = objp->radius;
+			break;
+		case OBJ_WEAPON:
+			// only missiles with hitpoints can be hurt
+			if (Weapon_info[Weapons[objp->instance].weapon_info_index].weapon_hitpoints <= 0)
+				continue;
+			bound = objp->radius;
+			break;
+		default:
+			continue;
+		}
+
+		Shockwave_targets.add(OBJ_INDEX(objp), &objp->pos, bound);
+		Shockwave_target_signatures[OBJ_INDEX(objp)] = objp->signature;
+	}
+
+	Shockwave_targets_valid = true;
+}
+
 /**
  * Simulate a single shockwave.  If the shockwave radius exceeds outer_radius, then
  * delete the shockwave.
@@ -313,9 +368,22 @@ void shockwave_move(object *shockwave_objp, float frametime)
 		return;
 	}
 
+	if (!Shockwave_targets_valid) {
+		shockwave_gather_targets();
+	}
+
 	// blast ships and asteroids
 	// And (some) weapons
-	for ( objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+	// only those which can be within reach of the shockwave are looked at, in the order of obj_used_list
+	Shockwave_found_targets.clear();
+	Shockwave_targets.query_sphere(&sw->pos, MIN(sw->radius, sw->outer_radius), Shockwave_found_targets);
+
+	for (int objnum : Shockwave_found_targets) {
+		objp = &Objects[objnum];
+
+		// deleted since the targets were gathered
+		if (objp->signature != Shockwave_target_signatures[objnum])
+			continue;
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 		if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) && (objp->type != OBJ_WEAPON)) {
@@ -697,6 +765,9 @@ void shockwave_move_all(float frametime)
 {
 	shockwave	*sw, *next;
 	
+	// the targets are gathered by the first shockwave to need them
+	Shockwave_targets_valid = false;
+
 	sw = GET_FIRST(&Shockwave_list);
 	while ( sw != &Shockwave_list ) {
 		next = sw->next;
@@ -704,6 +775,8 @@ void shockwave_move_all(float frametime)
 		shockwave_move(&Objects[sw->objnum], frametime);
 		sw = next;
 	}
+
+	Shockwave_targets_valid = false;
 }
 
 /**
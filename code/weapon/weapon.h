@@ -1029,8 +1029,17 @@ void	weapon_area_apply_blast(const vec3d *force_apply_pos, object *ship_objp, co
 int	weapon_area_calc_damage(const object *objp, const vec3d *pos, float inner_rad, float outer_rad, float max_blast, float max_damage,
 										float *blast, float *damage, float limit);
 
+// pick a target for a homing weapon that has none, from the ships and countermeasures in its seeker cone
+void find_homing_object(object *weapon_objp, int num);
+
 void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list);
 
+// forget the homing candidates gathered this frame, called when objects are added to obj_used_list
+void weapon_invalidate_homing_candidates();
+
+// whether homing weapons only look at targets that could be in their seeker cone, otherwise they look at all of them
+extern int Homing_candidate_culling;
+
 // THE FOLLOWING FUNCTION IS IN SHIP.CPP!!!!
 // JAS - figure out which thruster bitmap will get rendered next
 // time around.  ship_render needs to have shipp->thruster_bitmap set to
@@ -5010,6 +5010,7 @@ void weapon_level_init()
 
 	// Reset everything between levels
 	Num_weapons = 0;
+	weapon_invalidate_homing_candidates();
 	for (i=0; i<MAX_WEAPONS; i++)	{
 		Weapons[i].objnum = -1;
 		Weapons[i].weapon_info_index = -1;
@@ -5197,6 +5198,243 @@ void detonate_nearby_missiles(object* killer_objp, object* missile_objp)
 	}
 }
 
+// ----------------------------------------------------------------------------------------------
+// HOMING CANDIDATES
+//
+// Instead of walking all of obj_used_list for every homing weapon looking for a target, the ships and countermeasures
+// a weapon could home on are sorted into buckets by team and object class once per frame, and the members of every
+// bucket are grouped into spatial cells.  A weapon only looks at the cells whose bounding sphere touches its seeker
+// cone.  The buckets are built the first time a weapon looks for a target in a frame, while objects are still being
+// moved, so every cell is padded by how far its members can travel in one frame.  Objects which something other than
+// their own physics may move (docked objects, and ships arriving or departing) are never culled.
+//
+// The candidates a weapon looks at are visited in the order of obj_used_list, so ties and random picks come out the
+// same as walking the whole list.
+//
+
+// edge length of the spatial cells
+constexpr float HOMING_CANDIDATE_CELL_SIZE = 1000.0f;
+// extra angle, in radians, a cell may be outside of the seeker cone and still be searched
+constexpr float HOMING_CANDIDATE_CONE_SLACK = 0.01f;
+
+enum homing_candidate_class {
+	HOMING_CANDIDATE_SHIP = 0,
+	HOMING_CANDIDATE_CMEASURE,
+
+	NUM_HOMING_CANDIDATE_CLASSES
+};
+
+typedef struct homing_candidate {
+	int objnum;
+	int signature;
+} homing_candidate;
+
+typedef struct homing_candidate_cell {
+	vec3d center;
+	float radius;
+	SCP_vector<int> members;		// indexes into Homing_candidates, in list order
+} homing_candidate_cell;
+
+typedef struct homing_candidate_bucket {
+	SCP_vector<homing_candidate_cell> cells;
+	SCP_unordered_map<std::int64_t, int> cell_lookup;
+	SCP_vector<int> uncullable;
+} homing_candidate_bucket;
+
+static SCP_vector<homing_candidate> Homing_candidates;
+// one row of classes per team, and a last row for objects whose team is not a valid IFF
+static SCP_vector<homing_candidate_bucket> Homing_candidate_buckets;
+static int Homing_candidates_frame = -1;
+static int Homing_candidates_num_searched = 0;
+
+// the candidates found by the current search
+static SCP_vector<int> Homing_candidate_results;
+
+int Homing_candidate_culling = 1;
+DCF_BOOL(homing_candidate_culling, Homing_candidate_culling);
+
+MONITOR(HomingCandidatesSearched)
+
+void weapon_invalidate_homing_candidates()
+{
+	Homing_candidates_frame = -1;
+}
+
+static homing_candidate_bucket &homing_candidate_get_bucket(int team, homing_candidate_class cls)
+{
+	int num_teams = static_cast<int>(Iff_info.size());
+
+	if (team < 0 || team >= num_teams) {
+		team = num_teams;
+	}
+
+	return Homing_candidate_buckets[team * NUM_HOMING_CANDIDATE_CLASSES + cls];
+}
+
+static int homing_cell_coord(float value, float cell_size)
+{
+	return static_cast<int>(floorf(value / cell_size));
+}
+
+static std::int64_t homing_cell_key(int x, int y, int z)
+{
+	// far away cells may share a key, which only means a few more objects get looked at
+	return ((static_cast<std::int64_t>(x) & 0x1fffff) << 42) | ((static_cast<std::int64_t>(y) & 0x1fffff) << 21) | (static_cast<std::int64_t>(z) & 0x1fffff);
+}
+
+static std::int64_t homing_cell_key(const vec3d *pos, float cell_size)
+{
+	return homing_cell_key(homing_cell_coord(pos->xyz.x, cell_size), homing_cell_coord(pos->xyz.y, cell_size), homing_cell_coord(pos->xyz.z, cell_size));
+}
+
+// how far an object may move during the rest of this frame, with plenty of room to spare
+static float homing_candidate_travel(const object *objp)
+{
+	const physics_info *pi = &objp->phys_info;
+	float max_speed = MAX(vm_vec_mag(&pi->max_vel), vm_vec_mag(&pi->afterburner_max_vel));
+
+	return 2.0f * (vm_vec_mag(&pi->vel) + max_speed) * flFrametime + 1.0f;
+}
+
+static void homing_candidates_maybe_build()
+{
+	if (Homing_candidates_frame == Framecount) {
+		return;
+	}
+
+	mon_HomingCandidatesSearched = Homing_candidates_num_searched;
+	Homing_candidates_num_searched = 0;
+
+	Homing_candidates_frame = Framecount;
+	Homing_candidates.clear();
+	Homing_candidate_buckets.clear();
+	Homing_candidate_buckets.resize((Iff_info.size() + 1) * NUM_HOMING_CANDIDATE_CLASSES);
+
+	for (auto objp : list_range(&obj_used_list)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		homing_candidate_class cls;
+		if (objp->type == OBJ_SHIP) {
+			cls = HOMING_CANDIDATE_SHIP;
+		} else if ((objp->type == OBJ_WEAPON) && (Weapon_info[Weapons[objp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Cmeasure])) {
+			cls = HOMING_CANDIDATE_CMEASURE;
+		} else {
+			continue;
+		}
+
+		int idx = static_cast<int>(Homing_candidates.size());
+		Homing_candidates.push_back({ OBJ_INDEX(objp), objp->signature });
+
+		auto &bucket = homing_candidate_get_bucket(obj_team(objp), cls);
+
+		if ((objp->dock_list != nullptr) || ((objp->type == OBJ_SHIP) && (Ships[objp->instance].is_arriving() || Ships[objp->instance].is_departing()))) {
+			bucket.uncullable.push_back(idx);
+			continue;
+		}
+
+		auto key = homing_cell_key(&objp->pos, HOMING_CANDIDATE_CELL_SIZE);
+		auto it = bucket.cell_lookup.find(key);
+		if (it == bucket.cell_lookup.end()) {
+			it = bucket.cell_lookup.emplace(key, static_cast<int>(bucket.cells.size())).first;
+			bucket.cells.emplace_back();
+		}
+		bucket.cells[it->second].members.push_back(idx);
+	}
+
+	// bound every cell by a sphere around its members
+	for (auto &bucket : Homing_candidate_buckets) {
+		for (auto &cell : bucket.cells) {
+			vm_vec_zero(&cell.center);
+			for (int idx : cell.members) {
+				vm_vec_add2(&cell.center, &Objects[Homing_candidates[idx].objnum].pos);
+			}
+			vm_vec_scale(&cell.center, 1.0f / cell.members.size());
+
+			cell.radius = 0.0f;
+			for (int idx : cell.members) {
+				const object *objp = &Objects[Homing_candidates[idx].objnum];
+				cell.radius = MAX(cell.radius, vm_vec_dist(&cell.center, &objp->pos) + homing_candidate_travel(objp));
+			}
+		}
+	}
+}
+
+// whether any point of the cell could be inside the cone with the given cosine of its half angle
+static bool homing_candidate_cell_in_cone(const homing_candidate_cell &cell, const vec3d *apex, const vec3d *fvec, float fov)
+{
+	if (fov <= -1.0f) {
+		return true;
+	}
+
+	vec3d to_cell;
+	vm_vec_sub(&to_cell, &cell.center, apex);
+	float dist = vm_vec_mag(&to_cell);
+
+	if (dist <= cell.radius) {
+		return true;
+	}
+
+	float cone_angle = acosf(MIN(fov, 1.0f));
+	float spread = asinf(cell.radius / dist);
+
+	if (cone_angle + spread >= PI) {
+		return true;
+	}
+
+	float angle = acosf(MAX(-1.0f, MIN(vm_vec_dot(&to_cell, fvec) / dist, 1.0f)));
+
+	return angle <= cone_angle + spread + HOMING_CANDIDATE_CONE_SLACK;
+}
+
+static void homing_candidates_search_bucket(const homing_candidate_bucket &bucket, const object *weapon_objp, float fov)
+{
+	Homing_candidate_results.insert(Homing_candidate_results.end(), bucket.uncullable.begin(), bucket.uncullable.end());
+
+	for (const auto &cell : bucket.cells) {
+		if (homing_candidate_cell_in_cone(cell, &weapon_objp->pos, &weapon_objp->orient.vec.fvec, fov)) {
+			Homing_candidate_results.insert(Homing_candidate_results.end(), cell.members.begin(), cell.members.end());
+		}
+	}
+}
+
+// fills Homing_candidate_results with the objects the weapon could possibly home on, in list order
+static void homing_candidates_search(const object *weapon_objp, const weapon *wp, weapon_info *wip)
+{
+	homing_candidates_maybe_build();
+
+	Homing_candidate_results.clear();
+
+	if (!Homing_candidate_culling) {
+		// every candidate, just like walking all of obj_used_list
+		for (int idx = 0; idx < static_cast<int>(Homing_candidates.size()); ++idx) {
+			Homing_candidate_results.push_back(idx);
+		}
+
+		Homing_candidates_num_searched += static_cast<int>(Homing_candidate_results.size());
+		return;
+	}
+
+	bool any_team = weapon_has_iff_restrictions(wip);
+	// huge and javelin weapons never home on countermeasures
+	bool cmeasures = !(wip->wi_flags[Weapon::Info_Flags::Huge, Weapon::Info_Flags::Homing_javelin]);
+	int num_teams = static_cast<int>(Iff_info.size());
+
+	for (int team = 0; team <= num_teams; ++team) {
+		if (!any_team && (team < num_teams) && !iff_x_attacks_y(wp->team, team))
+			continue;
+
+		homing_candidates_search_bucket(homing_candidate_get_bucket(team, HOMING_CANDIDATE_SHIP), weapon_objp, wip->fov);
+		if (cmeasures) {
+			homing_candidates_search_bucket(homing_candidate_get_bucket(team, HOMING_CANDIDATE_CMEASURE), weapon_objp, wip->fov);
+		}
+	}
+
+	std::sort(Homing_candidate_results.begin(), Homing_candidate_results.end());
+
+	Homing_candidates_num_searched += static_cast<int>(Homing_candidate_results.size());
+}
+
 /**
  * Find an object for weapon #num (object *weapon_objp) to home on due to heat.
  */
@@ -5219,8 +5457,16 @@ void find_homing_object(object *weapon_objp, int num)
 	// only for random acquisition, accrue targets to later pick from randomly
 	SCP_vector<object*> prospective_targets;
 
-	//	Scan all objects, find a weapon to home on.
-	for ( object* objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+	//	Scan the ships and countermeasures that could be in the seeker cone, find one to home on.
+	homing_candidates_search(weapon_objp, wp, wip);
+
+	for (int idx : Homing_candidate_results) {
+		object* objp = &Objects[Homing_candidates[idx].objnum];
+
+		// deleted since the candidates were gathered
+		if (objp->signature != Homing_candidates[idx].signature)
+			continue;
+
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -5345,6 +5591,21 @@ void find_homing_object(object *weapon_objp, int num)
  */
 void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 {
+	// sort the countermeasures into cells at least as large as the largest effective radius, so that only the cells
+	// around a weapon can hold countermeasures close enough to decoy it
+	float cell_size = 1.0f;
+	for (auto cm_objp : cmeasure_list) {
+		cell_size = MAX(cell_size, Weapon_info[Weapons[cm_objp->instance].weapon_info_index].cm_effective_rad);
+	}
+	cell_size *= 1.01f;
+
+	SCP_unordered_map<std::int64_t, SCP_vector<int>> cmeasure_cells;
+	for (int i = 0; i < static_cast<int>(cmeasure_list.size()); ++i) {
+		cmeasure_cells[homing_cell_key(&cmeasure_list[i]->pos, cell_size)].push_back(i);
+	}
+
+	SCP_vector<int> nearby_cmeasures;
+
 	for (object *weapon_objp = GET_FIRST(&obj_used_list); weapon_objp != END_OF_LIST(&obj_used_list); weapon_objp = GET_NEXT(weapon_objp) ) {
 		if (weapon_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -5358,13 +5619,37 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 				continue;
 
 			if (wip->is_homing()) {
+				// gather the countermeasures from the surrounding cells, in the order of the list
+				int x = homing_cell_coord(weapon_objp->pos.xyz.x, cell_size);
+				int y = homing_cell_coord(weapon_objp->pos.xyz.y, cell_size);
+				int z = homing_cell_coord(weapon_objp->pos.xyz.z, cell_size);
+
+				nearby_cmeasures.clear();
+				for (int dx = -1; dx <= 1; ++dx) {
+					for (int dy = -1; dy <= 1; ++dy) {
+						for (int dz = -1; dz <= 1; ++dz) {
+							auto cell = cmeasure_cells.find(homing_cell_key(x + dx, y + dy, z + dz));
+							if (cell != cmeasure_cells.end()) {
+								nearby_cmeasures.insert(nearby_cmeasures.end(), cell->second.begin(), cell->second.end());
+							}
+						}
+					}
+				}
+
+				if (nearby_cmeasures.empty())
+					continue;
+
+				std::sort(nearby_cmeasures.begin(), nearby_cmeasures.end());
+
 				float best_dot = wip->fov;
-				for (auto cit = cmeasure_list.cbegin(); cit != cmeasure_list.cend(); ++cit) {
+				for (int i : nearby_cmeasures) {
+					object *cm_objp = cmeasure_list[i];
+
 					//don't have a weapon try to home in on itself
-					if (*cit == weapon_objp)
+					if (cm_objp == weapon_objp)
 						continue;
 
-					weapon *cm_wp = &Weapons[(*cit)->instance];
+					weapon *cm_wp = &Weapons[cm_objp->instance];
 					weapon_info *cm_wip = &Weapon_info[cm_wp->weapon_info_index];
 
 					//don't have a weapon try to home in on missiles fired by the same team, unless its the traitor team.
@@ -5372,7 +5657,7 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 						continue;
 
 					vec3d	vec_to_object;
-					float dist = vm_vec_normalized_dir(&vec_to_object, &(*cit)->pos, &weapon_objp->pos);
+					float dist = vm_vec_normalized_dir(&vec_to_object, &cm_objp->pos, &weapon_objp->pos);
 
 					if (dist < cm_wip->cm_effective_rad)
 					{
@@ -5384,9 +5669,9 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 						else {
 							bool found = false;
 							for (auto ii = wp->cmeasure_ignore_list->cbegin(); ii != wp->cmeasure_ignore_list->cend(); ++ii) {
-								if ((*cit)->signature == *ii) {
+								if (cm_objp->signature == *ii) {
 									nprintf(("CounterMeasures", "Weapon (%s-%04i) already seen CounterMeasure (%s-%04i) Frame: %i\n",
-												wip->name, weapon_objp->instance, cm_wip->name, (*cit)->signature, Framecount));
+												wip->name, weapon_objp->instance, cm_wip->name, cm_objp->signature, Framecount));
 									found = true;
 									break;
 								}
@@ -5405,12 +5690,12 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 						}
 
 						// remember this cmeasure so it can be ignored in future
-						wp->cmeasure_ignore_list->push_back((*cit)->signature);
+						wp->cmeasure_ignore_list->push_back(cm_objp->signature);
 
 						if (frand() >= chance) {
 							// failed to decoy
 							nprintf(("CounterMeasures", "Weapon (%s-%04i) ignoring CounterMeasure (%s-%04i) Frame: %i\n",
-										wip->name, weapon_objp->instance, cm_wip->name, (*cit)->signature, Framecount));
+										wip->name, weapon_objp->instance, cm_wip->name, cm_objp->signature, Framecount));
 						}
 						else {
 							// successful decoy, maybe chase the new cm
@@ -5419,10 +5704,10 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 							if (dot > best_dot)
 							{
 								best_dot = dot;
-								wp->homing_object = (*cit);
-								cmeasure_maybe_alert_success((*cit));
+								wp->homing_object = cm_objp;
+								cmeasure_maybe_alert_success(cm_objp);
 								nprintf(("CounterMeasures", "Weapon (%s-%04i) chasing CounterMeasure (%s-%04i) Frame: %i\n",
-											wip->name, weapon_objp->instance, cm_wip->name, (*cit)->signature, Framecount));
+											wip->name, weapon_objp->instance, cm_wip->name, cm_objp->signature, Framecount));
 							}
 						}
 					}
@@ -137,12 +137,15 @@
 #include "network/multi_pxo.h"
 #include "network/multi_rate.h"
 #include "network/multi_respawn.h"
+#include "network/multi_shard.h"
+#include "network/multi_soak.h"
 #include "network/multi_turret_manager.h"
 #include "network/multi_voice.h"
 #include "network/multimsgs.h"
 #include "network/multiteamselect.h"
 #include "network/multiui.h"
 #include "network/multiutil.h"
+#include "network/psnet2.h"
 #include "network/stand_gui.h"
 #include "object/objcollide.h"
 #include "object/objectsnd.h"
@@ -192,6 +195,7 @@
 #include "starfield/supernova.h"
 #include "stats/medals.h"
 #include "stats/stats.h"
+#include "tracing/LoadProfiler.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 #include "utils/Random.h"
@@ -1326,6 +1330,7 @@ void game_loading_callback_close()
 	// so this hook will let Lua scripts know we've finished no matter what
 	// game type is currently being played.
 	if (scripting::hooks::OnLoadComplete->isActive()) {
+		LOAD_PROFILE_PHASE(ScriptInit);
 		scripting::hooks::OnLoadComplete->run();
 	}
 }
@@ -1459,6 +1464,8 @@ void game_post_level_init()
 	mission_process_alt_types();
 
 	if (scripting::hooks::OnMissionStart->isActive()) {
+		LOAD_PROFILE_PHASE(ScriptInit);
+
 		// HACK: That scripting hook should be in mission so GM_IN_MISSION has to be set
 		Game_mode |= GM_IN_MISSION;
 		scripting::hooks::OnMissionStart->run(scripting::hook_param_list(
@@ -1477,6 +1484,8 @@ bool game_start_mission()
 
 	int s1 __UNUSED = timer_get_milliseconds();
 
+	tracing::load_profile::begin(Game_current_mission_filename);
+
 	// clear post processing settings
 	gr_post_process_set_defaults();
 
@@ -1521,6 +1530,8 @@ bool game_start_mission()
 
 		game_level_close();
 
+		tracing::load_profile::end(false);
+
 		return false;
 	}
 
@@ -1530,6 +1541,8 @@ bool game_start_mission()
 	if (L != nullptr)
 	{
 		game_busy(NOX("** cleaning up Lua objects **"));
+
+		LOAD_PROFILE_PHASE(ScriptInit, 0);
 		lua_gc(L, LUA_GCCOLLECT, 0);
 	}
 
@@ -1555,6 +1568,9 @@ bool game_start_mission()
 	int e1 __UNUSED = timer_get_milliseconds();
 
 	mprintf(("Level load took %f seconds.\n", (e1 - s1) / 1000.0f ));
+
+	tracing::load_profile::end(true);
+
 	return true;
 }
 
@@ -4181,6 +4197,126 @@ void game_do_full_frame(DEBUG_TIMER_SIG const vec3d* offset = nullptr, const mat
 	}
 }
 
+#define FIXED_STEP_MAX_SKIPPED_RENDERS	4	// with -fixed_timestep, how many frames in a row may skip rendering to catch up
+
+// fixed timestep simulation, enabled with -fixed_timestep
+static fix Fixed_step_accumulator = 0;		// real time that has passed but has not been simulated yet
+static bool Fixed_step_simulate = true;		// does this frame advance the simulation
+static bool Fixed_step_render = true;		// does this frame get rendered
+static fix Fixed_step_frametime = 0;		// the time compressed length of the step this frame simulates, or 0
+static int Fixed_step_skipped_renders = 0;	// frames in a row that only simulated to catch up
+
+static SCP_vector<light> Fixed_step_lights, Fixed_step_static_lights;
+
+struct fixed_step_saved_transform {
+	int objnum;
+	vec3d pos;
+	matrix orient;
+};
+
+static SCP_vector<fixed_step_saved_transform> Fixed_step_saved_transforms;
+
+static void game_fixed_step_reset()
+{
+	Fixed_step_accumulator = 0;
+	Fixed_step_simulate = true;
+	Fixed_step_render = true;
+	Fixed_step_frametime = 0;
+	Fixed_step_skipped_renders = 0;
+}
+
+// The simulation advances by exactly one step, but input, the HUD and everything else that runs once per frame keeps
+// using the real frametime.  This swaps the step in for as long as the simulation runs.
+class fixed_step_frametime_scope
+{
+	fix m_frametime;
+	float m_flframetime;
+
+  public:
+	fixed_step_frametime_scope() : m_frametime(Frametime), m_flframetime(flFrametime)
+	{
+		if (Fixed_step_frametime > 0) {
+			Frametime = Fixed_step_frametime;
+			flFrametime = f2fl(Frametime);
+		}
+	}
+	~fixed_step_frametime_scope()
+	{
+		Frametime = m_frametime;
+		flFrametime = m_flframetime;
+	}
+
+	fixed_step_frametime_scope(const fixed_step_frametime_scope&) = delete;
+	fixed_step_frametime_scope& operator=(const fixed_step_frametime_scope&) = delete;
+};
+
+// Objects only move in whole simulation steps, so when rendering between two steps every object is drawn part of the
+// way from where it was at the previous step.  This has to be undone with game_fixed_step_render_end() after rendering.
+static void game_fixed_step_render_begin()
+{
+	if (Cmdline_fixed_timestep <= 0) {
+		return;
+	}
+
+	// anything rendering adds to the lights has to go away again, since the next frame may not simulate and reset them
+	Fixed_step_lights = Lights;
+	Fixed_step_static_lights = Static_light;
+
+	fix step = F1_0 / Cmdline_fixed_timestep;
+	float alpha = f2fl(Fixed_step_accumulator) / f2fl(step);
+
+	if (alpha <= 0.0f) {
+		return;
+	}
+
+	CLAMP(alpha, 0.0f, 1.0f);
+
+	// the render lags one step behind the simulation, so alpha == 1 is the current step
+	for (auto objp: list_range(&obj_used_list)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead] || !objp->flags[Object::Object_Flags::Physics]) {
+			continue;
+		}
+
+		// interpolated multiplayer objects keep last_pos for collisions, not for the previous step
+		if (multi_oo_is_interp_object(objp)) {
+			continue;
+		}
+
+		// don't smear objects which just warped or were moved directly
+		float max_dist = (vm_vec_mag(&objp->phys_info.vel) * f2fl(step) * 2.0f) + 1.0f;
+		if (vm_vec_dist_squared(&objp->pos, &objp->last_pos) > max_dist * max_dist) {
+			continue;
+		}
+
+		Fixed_step_saved_transforms.push_back({OBJ_INDEX(objp), objp->pos, objp->orient});
+
+		vm_vec_linear_interpolate(&objp->pos, &objp->last_pos, &objp->pos, alpha);
+
+		vec4 q0, q1, q;
+		vm_matrix_to_quaternion(&q0, &objp->last_orient);
+		vm_matrix_to_quaternion(&q1, &objp->orient);
+		vm_quaternion_nlerp(&q, &q0, &q1, alpha);
+		vm_quaternion_to_matrix(&objp->orient, q.xyzw.x, q.xyzw.y, q.xyzw.z, q.xyzw.w);
+	}
+}
+
+static void game_fixed_step_render_end()
+{
+	if (Cmdline_fixed_timestep <= 0) {
+		return;
+	}
+
+	for (const auto& saved : Fixed_step_saved_transforms) {
+		Objects[saved.objnum].pos = saved.pos;
+		Objects[saved.objnum].orient = saved.orient;
+	}
+
+	Fixed_step_saved_transforms.clear();
+
+	Lights = std::move(Fixed_step_lights);
+	Static_light = std::move(Fixed_step_static_lights);
+}
+
 void game_frame(bool paused)
 {
 #ifndef NDEBUG
@@ -4213,8 +4349,17 @@ void game_frame(bool paused)
 		// Reset the lights here or they just keep on increasing
 		light_reset();
 	}
+	else if (!Fixed_step_simulate)
+	{
+		// no simulation step is due yet, so this frame only renders
+		if ((Game_mode & GM_MULTIPLAYER) && ((Netgame.game_state == NETGAME_STATE_SERVER_TRANSFER) || !game_actually_playing())) {
+			return;
+		}
+	}
 	else
 	{
+		fixed_step_frametime_scope step_frametime;
+
 		// var to hold which state we are in
 		bool actually_playing = game_actually_playing();
 
@@ -4273,8 +4418,10 @@ void game_frame(bool paused)
 
 	}
 
-	if (!Pre_player_entry) {
+	if (!Pre_player_entry && Fixed_step_render) {
 		if (! (Game_mode & GM_STANDALONE_SERVER)) {
+			game_fixed_step_render_begin();
+
 			DEBUG_GET_TIME( clear_time1 )
 			if (!openxr_enabled()) {
 				game_do_full_frame(DEBUG_TIMER_CALL_CLEAN);
@@ -4302,6 +4449,8 @@ void game_frame(bool paused)
 				game_do_full_frame(DEBUG_TIMER_CALL &pose.eyes[1].offset, &pose.eyes[1].orientation, &pose.eyes[1].zoom);
 				std::swap(Stars, Stars_XRBuffer);
 			}
+
+			game_fixed_step_render_end();
 		} else {
 			game_show_standalone_framerate();
 		}
@@ -4346,6 +4495,8 @@ void game_time_level_init()
 	// stop time while we're loading so that timestamps set on initialization will all be consistent, among other things
 	game_stop_time();
 
+	game_fixed_step_reset();
+
 	Missiontime = 0;
 	timestamp_start_mission();
 }
@@ -4484,6 +4635,49 @@ void game_set_frametime(int state)
 		Frametime = MAX_FRAMETIME;
 	}
 
+	Fixed_step_simulate = true;
+	Fixed_step_render = true;
+	Fixed_step_frametime = 0;
+
+	// With a fixed timestep, the simulation only advances in whole steps of real time.  Frames in between only render,
+	// and when the simulation falls behind it catches up by skipping a few renders.  Frametime itself stays the real
+	// frametime, game_frame() swaps in the step while simulating.
+	if ((Cmdline_fixed_timestep > 0) && (state == GS_STATE_GAME_PLAY) && !do_pre_player_skip) {
+		fix step = F1_0 / Cmdline_fixed_timestep;
+
+		Fixed_step_accumulator += Frametime;
+
+		// a standalone server never renders, so just wait for the next step instead
+		if ((Game_mode & GM_STANDALONE_SERVER) && (Fixed_step_accumulator < step)) {
+			fix wait = step - Fixed_step_accumulator;
+			os_sleep(static_cast<int>(f2fl(wait) * 1000.0f));
+
+			thistime += wait;
+			Frametime += wait;
+			Fixed_step_accumulator = step;
+		}
+
+		if (Fixed_step_accumulator < step) {
+			Fixed_step_simulate = false;
+		} else {
+			Fixed_step_accumulator -= step;
+			Fixed_step_frametime = step;
+
+			if (Fixed_step_accumulator >= step) {
+				if (Fixed_step_skipped_renders < FIXED_STEP_MAX_SKIPPED_RENDERS) {
+					Fixed_step_render = false;
+					Fixed_step_skipped_renders++;
+				} else {
+					// too far behind to ever catch up, so let the game slow down instead
+					Fixed_step_accumulator = step - 1;
+					Fixed_step_skipped_renders = 0;
+				}
+			} else {
+				Fixed_step_skipped_renders = 0;
+			}
+		}
+	}
+
 	flRealframetime = f2fl(Frametime);
 
 	//Handle changes in time compression
@@ -4518,6 +4712,11 @@ void game_set_frametime(int state)
 		Frametime = 1;
 	}
 
+	if (Fixed_step_frametime > 0)
+	{
+		Fixed_step_frametime = MAX(fixmul(Fixed_step_frametime, Game_time_compression), 1);
+	}
+
 	Last_time = thistime;
 
 	// Unlike Last_frame_ui_timestamp, it's probably ok to leave this here for the following reasons:
@@ -6355,6 +6554,9 @@ void game_do_state_common(int state,int no_networking)
 
 	multi_log_process();	
 
+	// don't let queued unreliable packets sit around in states that skip networking
+	psnet_send_queue_flush();
+
 	if (no_networking) {
 		return;
 	}
@@ -6881,6 +7083,12 @@ int game_main(int argc, char *argv[])
 		return 1;
 	}
 
+	// with -standalone_shards this process only hands out games to forked workers, which carry on from here
+	if (!multi_shard_run()) {
+		game_shutdown();
+		return 0;
+	}
+
 	if (!Is_standalone && !headtracking::init())
 	{
 		mprintf(("Headtracking is not enabled...\n"));
@@ -6997,6 +7205,7 @@ void game_shutdown(void)
 	mission_parse_close();		// clear out any extra memory that may be in use by mission parsing
 	multi_voice_close();			// close down multiplayer voice (including freeing buffers, etc)
 	multi_log_close();
+	multi_soak_close();
 	logfile_close(LOGFILE_EVENT_LOG); // close down the mission log
 #ifdef MULTI_USE_LAG
 	multi_lag_close();
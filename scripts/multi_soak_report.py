@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+import argparse
+import csv
+
+parser = argparse.ArgumentParser(description="Summarize standalone server soak reports written with -soak_report")
+parser.add_argument("reports", nargs="+", help="The soak_report.csv files to summarize")
+parser.add_argument("--all", action="store_true",
+                    help="Include report lines from outside of a mission")
+args = parser.parse_args()
+
+
+def mean(values):
+    return sum(values) / len(values) if values else 0.0
+
+
+def summarize(path):
+    with open(path, newline="") as f:
+        rows = [row for row in csv.DictReader(f) if args.all or row["in_mission"] == "1"]
+
+    if not rows:
+        return None
+
+    return {
+        "clients": max(int(row["clients"]) for row in rows),
+        "seconds": len(rows),
+        "frametime_avg": mean([float(row["frametime_avg_ms"]) for row in rows]),
+        "frametime_max": max(float(row["frametime_max_ms"]) for row in rows),
+        "sent": mean([float(row["bytes_sent_per_client"]) for row in rows]),
+        "recvd": mean([float(row["bytes_recvd_per_client"]) for row in rows]),
+        "rollbacks": mean([float(row["rollbacks"]) for row in rows]),
+        "rollback_ships": mean([float(row["rollback_ships"]) for row in rows]),
+    }
+
+
+results = []
+
+for report in args.reports:
+    summary = summarize(report)
+
+    if summary is None:
+        print("{}: no data".format(report))
+        continue
+
+    results.append(summary)
+
+results.sort(key=lambda r: r["clients"])
+
+print("{:>7} {:>7} {:>12} {:>12} {:>14} {:>14} {:>11} {:>14}".format(
+    "clients", "seconds", "frame avg ms", "frame max ms", "sent B/s/cl", "recvd B/s/cl", "rollback/s", "rb ships/s"))
+
+for r in results:
+    print("{:>7} {:>7} {:>12.3f} {:>12.3f} {:>14.1f} {:>14.1f} {:>11.2f} {:>14.2f}".format(
+        r["clients"], r["seconds"], r["frametime_avg"], r["frametime_max"], r["sent"], r["recvd"],
+        r["rollbacks"], r["rollback_ships"]))
@@ -0,0 +1,168 @@
+#!/usr/bin/env bash
+
+# Soak tests a standalone server with a growing number of simulated clients over the loopback interface.
+#
+# For every client count the standalone server is started with -soak_report and the clients connect to it with
+# -connect 127.0.0.1.  Nothing needs a human: the clients create their pilots on the fly (-soak_client), the first
+# client to join becomes the game host and autoloads the mission once every client has joined, and all clients load a
+# small scripting mod which commits the briefing and then flies the player ship and fires weapons on its own.
+#
+# The server writes one line per second to soak_report.csv in its data directory.  After every step the report is
+# copied to the output directory as soak_<clients>.csv and summarized by multi_soak_report.py.
+#
+# The game runs with HOME and XDG_DATA_HOME pointing at a temporary directory, so the mod, the pilots, the settings and
+# the reports all end up there instead of in FS2PATH or the user's own profile.  It is removed again on exit.
+
+set -e
+
+if [ "$#" -lt 2 ] || [ "$1" == "--help" ]; then
+    echo "Runs a standalone server together with simulated clients and reports the server load"
+    echo "Usage: ./multi_soak_test.sh <fso_binary> <mission> [max_clients] [seconds_per_step] [output_dir]"
+    echo ""
+    echo "FS2PATH must point to the game data directory.  The mission must be a multiplayer mission with a player"
+    echo "slot for every client."
+    exit 1
+fi
+
+FSO_BINARY=$(readlink -f "$1")
+MISSION="$2"
+MAX_CLIENTS="${3:-11}"
+STEP_TIME="${4:-120}"
+OUTPUT_DIR=$(readlink -f "${5:-soak_results}")
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+FSO_DIR="$(printenv FS2PATH)"
+PORT=7808
+
+# a standalone server takes up one of the MAX_PLAYERS (12) slots
+if [ "$MAX_CLIENTS" -gt 11 ]; then
+    echo "At most 11 clients can connect to a standalone server"
+    exit 1
+fi
+
+mkdir -p "$OUTPUT_DIR"
+
+SOAK_HOME=$(mktemp -d)
+export HOME="$SOAK_HOME"
+export XDG_DATA_HOME="$SOAK_HOME"
+
+# the user directory the game writes to, see SDL_GetPrefPath()
+USER_DIR="$SOAK_HOME/HardLightProductions/FreeSpaceOpen"
+
+CLIENT_PIDS=()
+SERVER_PID=""
+
+function stop_clients {
+    for pid in "${CLIENT_PIDS[@]}"; do
+        kill "$pid" 2> /dev/null || true
+    done
+
+    CLIENT_PIDS=()
+}
+
+function cleanup {
+    stop_clients
+
+    if [ -n "$SERVER_PID" ]; then
+        kill "$SERVER_PID" 2> /dev/null || true
+        wait "$SERVER_PID" 2> /dev/null || true
+    fi
+
+    rm -rf "$SOAK_HOME"
+}
+
+trap cleanup EXIT
+
+# the scripting mod used to drive the clients, mods in the user directory are found just like the ones in FS2PATH
+SOAK_MOD="$USER_DIR/soak_test"
+mkdir -p "$SOAK_MOD/data/tables"
+
+cat > "$SOAK_MOD/data/tables/soak-sct.tbm" << 'EOF'
+#Conditional Hooks
+
+$Application: FS2_Open
+
+$State: GS_STATE_BRIEFING
+$On Frame: [
+	-- stand in for the host pressing commit, the other clients just wait for it
+	if soak_committed == nil then
+		for i = 1, #ui.MultiGeneral.NetPlayers do
+			local player = ui.MultiGeneral.NetPlayers[i]
+			if player:isValid() and player:isSelf() and player.Host then
+				if ui.Briefing.commitToMission() == COMMIT_SUCCESS then
+					soak_committed = true
+				end
+			end
+		end
+	end
+]
+
+$Application: FS2_Open
+
+$On Gameplay Start: [
+	ba.setControlMode(LUA_FULL_CONTROLS)
+]
+
+$On Simulation: [
+	local ci = ba.getControlInfo()
+	local t = mn.getMissionTime()
+
+	-- weave around at full throttle so the server has to interpolate and send updates constantly
+	ci.Forward = 1
+	ci.Pitch = math.sin(t * 0.7) * 0.6
+	ci.Heading = math.cos(t * 0.5) * 0.6
+	ci.Bank = math.sin(t * 0.3) * 0.2
+
+	-- fire in bursts to exercise lag compensated primary fire and secondary tracking
+	if math.fmod(t, 4) < 2 then
+		ci.PrimaryCount = 1
+	else
+		ci.PrimaryCount = 0
+	end
+
+	if math.fmod(t, 15) < 0.05 then
+		ci.SecondaryCount = 1
+	end
+]
+
+#End
+EOF
+
+pushd "$FSO_DIR" > /dev/null
+
+for (( clients = 2; clients <= MAX_CLIENTS; clients++ )); do
+    echo "Running soak test with $clients clients for $STEP_TIME seconds"
+
+    rm -f "$USER_DIR/data/soak_report.csv"
+
+    "$FSO_BINARY" -standalone -soak_report -port "$PORT" -nosound -nomusic -noninteractive &
+    SERVER_PID=$!
+
+    # give the server some time to load its tables
+    sleep 10
+
+    # the first client becomes the host, it waits for everyone to join and then starts the mission
+    "$FSO_BINARY" -mod soak_test -connect "127.0.0.1:$PORT" -pilot soak1 -soak_client -almission "$MISSION" -almission_players "$clients" -window -nosound -nomusic -noninteractive &
+    CLIENT_PIDS+=($!)
+
+    # make sure the host has joined before anyone else does
+    sleep 5
+
+    for (( idx = 2; idx <= clients; idx++ )); do
+        "$FSO_BINARY" -mod soak_test -connect "127.0.0.1:$PORT" -pilot "soak$idx" -soak_client -window -nosound -nomusic -noninteractive &
+        CLIENT_PIDS+=($!)
+    done
+
+    sleep "$STEP_TIME"
+
+    stop_clients
+    kill "$SERVER_PID" 2> /dev/null || true
+    wait "$SERVER_PID" 2> /dev/null || true
+    SERVER_PID=""
+
+    cp "$USER_DIR/data/soak_report.csv" "$OUTPUT_DIR/soak_$clients.csv"
+done
+
+popd > /dev/null
+
+"$DIR/multi_soak_report.py" "$OUTPUT_DIR"/soak_*.csv
@@ -719,3 +719,61 @@ TEST_F(VecmatTest, orthogonalize_matrix) {
 	}
 }
 
+
+TEST_F(VecmatTest, matrix_quaternion_roundtrip) {
+	for (int i = 0; i < 1000; i++) {
+		angles a;
+		a.p = frand_range(-PI, PI);
+		a.b = frand_range(-PI, PI);
+		a.h = frand_range(-PI, PI);
+
+		matrix orient, result;
+		vm_angles_2_matrix(&orient, &a);
+
+		vec4 q;
+		vm_matrix_to_quaternion(&q, &orient);
+
+		float mag = sqrtf(q.xyzw.x * q.xyzw.x + q.xyzw.y * q.xyzw.y + q.xyzw.z * q.xyzw.z + q.xyzw.w * q.xyzw.w);
+		EXPECT_NEAR(mag, 1.0f, 1e-5);
+
+		vm_quaternion_to_matrix(&result, q.xyzw.x, q.xyzw.y, q.xyzw.z, q.xyzw.w);
+		EXPECT_MATRIX_NEAR(result, orient);
+	}
+}
+
+TEST_F(VecmatTest, quaternion_nlerp) {
+	matrix start, goal, result;
+	angles a_start = { 0.1f, 0.2f, 0.3f };
+	angles a_goal = { 0.2f, 0.1f, 0.5f };
+
+	vm_angles_2_matrix(&start, &a_start);
+	vm_angles_2_matrix(&goal, &a_goal);
+
+	vec4 q_start, q_goal, q_out;
+	vm_matrix_to_quaternion(&q_start, &start);
+	vm_matrix_to_quaternion(&q_goal, &goal);
+
+	// the endpoints are returned unchanged
+	vm_quaternion_nlerp(&q_out, &q_start, &q_goal, 0.0f);
+	vm_quaternion_to_matrix(&result, q_out.xyzw.x, q_out.xyzw.y, q_out.xyzw.z, q_out.xyzw.w);
+	EXPECT_MATRIX_NEAR(result, start);
+
+	vm_quaternion_nlerp(&q_out, &q_start, &q_goal, 1.0f);
+	vm_quaternion_to_matrix(&result, q_out.xyzw.x, q_out.xyzw.y, q_out.xyzw.z, q_out.xyzw.w);
+	EXPECT_MATRIX_NEAR(result, goal);
+
+	// -q is the same rotation as q, so interpolating towards it must not change anything
+	vec4 q_negated;
+	for (int i = 0; i < 4; i++) {
+		q_negated.a1d[i] = -q_start.a1d[i];
+	}
+
+	vm_quaternion_nlerp(&q_out, &q_start, &q_negated, 0.5f);
+	vm_quaternion_to_matrix(&result, q_out.xyzw.x, q_out.xyzw.y, q_out.xyzw.z, q_out.xyzw.w);
+	EXPECT_MATRIX_NEAR(result, start);
+
+	// the halfway point is at the same angle from both ends
+	vm_quaternion_nlerp(&q_out, &q_start, &q_goal, 0.5f);
+	vm_quaternion_to_matrix(&result, q_out.xyzw.x, q_out.xyzw.y, q_out.xyzw.z, q_out.xyzw.w);
+	EXPECT_NEAR(vm_vec_dot(&result.vec.fvec, &start.vec.fvec), vm_vec_dot(&result.vec.fvec, &goal.vec.fvec), 1e-5);
+}
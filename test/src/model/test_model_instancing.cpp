@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <lighting/lighting.h>
+#include <model/modelrender.h>
+
+#include "util/FSTestFixture.h"
+
+class ModelInstancingTest : public test::FSTestFixture {
+  public:
+	ModelInstancingTest() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) { pushModDir("model"); }
+
+  protected:
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+
+		buffer.flags = VB_FLAG_MODEL_ID;
+		buffer.tex_buf.emplace_back();
+	}
+	void TearDown() override
+	{
+		light_reset();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	// queues the same batched buffer once per object, the way model_render_queue does for a model without submodels
+	void queue_objects(model_draw_list& scene, const model_material& mat, int n_objects, uint tmap_flags)
+	{
+		for (int i = 0; i < n_objects; ++i) {
+			vec3d pos = vmd_zero_vector;
+			pos.xyz.x = i * 100.0f;
+
+			scene.push_transform(&pos, &vmd_identity_matrix);
+			scene.set_light_filter(&pos, 10.0f);
+
+			if (tmap_flags & TMAP_FLAG_BATCH_TRANSFORMS) {
+				scene.start_model_batch(N_SUBMODELS);
+
+				for (int m = 0; m < N_SUBMODELS; ++m) {
+					scene.add_submodel_to_batch(m);
+				}
+			}
+
+			scene.add_buffer_draw(&mat, &vert_src, &buffer, 0, tmap_flags);
+
+			scene.pop_transform();
+		}
+	}
+
+	static const int N_SUBMODELS = 3;
+
+	indexed_vertex_source vert_src;
+	vertex_buffer buffer;
+};
+
+TEST_F(ModelInstancingTest, identical_draws_are_merged)
+{
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	queue_objects(scene, mat, 8, TMAP_FLAG_BATCH_TRANSFORMS);
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_queued_draws());
+	ASSERT_EQ(1u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, different_materials_are_not_merged)
+{
+	model_draw_list scene;
+	scene.init();
+
+	model_material red;
+	red.set_color(255, 0, 0, 255);
+	model_material blue;
+	blue.set_color(0, 0, 255, 255);
+
+	// interleaved so that the merging has to look past draws which don't match
+	for (int i = 0; i < 4; ++i) {
+		queue_objects(scene, red, 1, TMAP_FLAG_BATCH_TRANSFORMS);
+		queue_objects(scene, blue, 1, TMAP_FLAG_BATCH_TRANSFORMS);
+	}
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_queued_draws());
+	ASSERT_EQ(2u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, unbatched_draws_are_not_merged)
+{
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	queue_objects(scene, mat, 8, 0);
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, unsorted_draws_are_not_merged)
+{
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	queue_objects(scene, mat, 8, TMAP_FLAG_BATCH_TRANSFORMS);
+
+	scene.init_render(false);
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, draws_with_the_same_lights_are_merged)
+{
+	// a light reaching every object, each of them filters its own copy of the same set
+	vec3d light_pos = vmd_zero_vector;
+	light_pos.xyz.x = 350.0f;
+	light_add_point(&light_pos, 500.0f, 1000.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	mat.set_lighting(true);
+	queue_objects(scene, mat, 8, TMAP_FLAG_BATCH_TRANSFORMS);
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_queued_draws());
+	ASSERT_EQ(1u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, draws_with_different_lights_are_not_merged)
+{
+	// a light reaching only the first three objects
+	vec3d light_pos = vmd_zero_vector;
+	light_add_point(&light_pos, 100.0f, 200.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	mat.set_lighting(true);
+	queue_objects(scene, mat, 8, TMAP_FLAG_BATCH_TRANSFORMS);
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_queued_draws());
+	ASSERT_EQ(2u, scene.get_num_draw_calls());
+}
+
+TEST_F(ModelInstancingTest, unlit_draws_with_different_lights_are_merged)
+{
+	// a light reaching only the first three objects, which unlit draws don't use
+	vec3d light_pos = vmd_zero_vector;
+	light_add_point(&light_pos, 100.0f, 200.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+	model_draw_list scene;
+	scene.init();
+
+	model_material mat;
+	mat.set_lighting(false);
+	queue_objects(scene, mat, 8, TMAP_FLAG_BATCH_TRANSFORMS);
+
+	scene.init_render();
+	scene.render_all();
+
+	ASSERT_EQ(8u, scene.get_num_queued_draws());
+	ASSERT_EQ(1u, scene.get_num_draw_calls());
+}
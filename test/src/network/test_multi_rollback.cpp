@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <io/timer.h>
+#include <network/multi_obj.h>
+
+namespace {
+
+rollback_bounds ship_at(float z, float radius)
+{
+	rollback_bounds bounds;
+	bounds.min = vm_vec_new(-radius, -radius, z - radius);
+	bounds.max = vm_vec_new(radius, radius, z + radius);
+	return bounds;
+}
+
+} // namespace
+
+// Shots need a positive travel time, otherwise rollback can never cull any ship
+TEST(MultiRollbackTest, shot_travel_time)
+{
+	TIMESTAMP timestamps[MAX_FRAMES_RECORDED];
+
+	// the buffer has not wrapped around yet, so only the first frames are recorded
+	timestamps[0] = TIMESTAMP(10000);
+	timestamps[1] = TIMESTAMP(10016);
+	timestamps[2] = TIMESTAMP(10033);
+	timestamps[3] = TIMESTAMP(10050);
+
+	// from frame 1 up to frame 3, plus the last frame interval as slack
+	ASSERT_NEAR((34 + 17) / 1000.0f, multi_rollback_shot_travel_time(timestamps, 1, 3, 0.5f), 0.0001f);
+	ASSERT_NEAR((50 + 17) / 1000.0f, multi_rollback_shot_travel_time(timestamps, 0, 3, 0.5f), 0.0001f);
+
+	// unrecorded frames can not be bounded
+	ASSERT_LT(multi_rollback_shot_travel_time(timestamps, 10, 3, 0.5f), 0.0f);
+
+	// when the frame before the current one was not recorded, the frametime is the slack
+	TIMESTAMP wrapped[MAX_FRAMES_RECORDED];
+	wrapped[MAX_FRAMES_RECORDED - 2] = TIMESTAMP(20000);
+	wrapped[0] = TIMESTAMP(20040);
+	ASSERT_NEAR((40 + 20) / 1000.0f, multi_rollback_shot_travel_time(wrapped, MAX_FRAMES_RECORDED - 2, 0, 0.02f), 0.0001f);
+}
+
+TEST(MultiRollbackTest, distant_ships_are_culled)
+{
+	TIMESTAMP timestamps[MAX_FRAMES_RECORDED];
+	timestamps[4] = TIMESTAMP(10000);
+	timestamps[5] = TIMESTAMP(10020);
+	timestamps[6] = TIMESTAMP(10040);
+
+	float travel_time = multi_rollback_shot_travel_time(timestamps, 4, 6, 0.02f);
+	ASSERT_GT(travel_time, 0.0f);
+
+	// a shot fired from the origin along +z at 800 m/s
+	vec3d pos = vmd_zero_vector;
+	vec3d fvec = vm_vec_new(0.0f, 0.0f, 1.0f);
+	rollback_bounds shot;
+	multi_rollback_shot_bounds(&pos, &fvec, 800.0f, 10.0f, travel_time, shot);
+
+	// the shot is really bounded, by the distance it travels plus the slack for its angle and the shooter
+	float reach = 800.0f * travel_time;
+	ASSERT_NEAR(reach + 10.0f + reach * 0.5f, shot.max.xyz.z, 0.01f);
+	ASSERT_NEAR(-(10.0f + reach * 0.5f), shot.min.xyz.z, 0.01f);
+
+	// ships along the path are kept, ships far ahead, behind or to the side are culled
+	ASSERT_TRUE(multi_rollback_bounds_overlap(shot, ship_at(reach * 0.5f, 20.0f)));
+	ASSERT_TRUE(multi_rollback_bounds_overlap(shot, ship_at(reach + 30.0f, 20.0f)));
+	ASSERT_FALSE(multi_rollback_bounds_overlap(shot, ship_at(5000.0f, 20.0f)));
+	ASSERT_FALSE(multi_rollback_bounds_overlap(shot, ship_at(-500.0f, 20.0f)));
+
+	rollback_bounds side = ship_at(reach * 0.5f, 20.0f);
+	side.min.xyz.x += 1000.0f;
+	side.max.xyz.x += 1000.0f;
+	ASSERT_FALSE(multi_rollback_bounds_overlap(shot, side));
+}
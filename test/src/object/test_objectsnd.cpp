@@ -0,0 +1,274 @@
+#include "io/timer.h"
+#include "object/object.h"
+#include "object/objectsnd.h"
+#include "render/3d.h"
+#include "sound/audiostr.h"
+#include "sound/channel.h"
+#include "sound/ds.h"
+#include "sound/sound.h"
+
+#include <gtest/gtest.h>
+
+#include "util/FSTestFixture.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef AL_DEFERRED_UPDATES_SOFT
+#define AL_DEFERRED_UPDATES_SOFT 0xC002
+#endif
+
+extern SCP_vector<game_snd> Snds;
+
+namespace {
+
+SCP_vector<int> indices(const SCP_vector<obj_snd_voice>& voices)
+{
+	SCP_vector<int> out;
+	for (auto& voice : voices) {
+		out.push_back(voice.snd_index);
+	}
+	std::sort(out.begin(), out.end());
+	return out;
+}
+
+} // namespace
+
+TEST(ObjectSoundTest, select_voices_fills_free_voices)
+{
+	SCP_vector<obj_snd_voice> playing = {{0, 0.5f}};
+	SCP_vector<obj_snd_voice> candidates = {{1, 0.2f}, {2, 0.9f}, {3, 0.4f}};
+	SCP_vector<obj_snd_voice> stopped, started;
+
+	obj_snd_select_voices(playing, candidates, 3, stopped, started);
+
+	// the loudest candidates get the two free voices
+	ASSERT_TRUE(stopped.empty());
+	ASSERT_EQ(SCP_vector<int>({2, 3}), indices(started));
+	ASSERT_EQ(SCP_vector<int>({0, 2, 3}), indices(playing));
+}
+
+TEST(ObjectSoundTest, select_voices_replaces_quieter_sounds)
+{
+	SCP_vector<obj_snd_voice> playing = {{0, 0.3f}, {1, 0.8f}, {2, 0.1f}};
+	SCP_vector<obj_snd_voice> candidates = {{3, 0.5f}, {4, 0.2f}, {5, 0.05f}};
+	SCP_vector<obj_snd_voice> stopped, started;
+
+	obj_snd_select_voices(playing, candidates, 3, stopped, started);
+
+	// 0.5 replaces 0.1, 0.2 is quieter than everything left playing
+	ASSERT_EQ(SCP_vector<int>({2}), indices(stopped));
+	ASSERT_EQ(SCP_vector<int>({3}), indices(started));
+	ASSERT_EQ(SCP_vector<int>({0, 1, 3}), indices(playing));
+}
+
+TEST(ObjectSoundTest, select_voices_equal_volume_keeps_playing)
+{
+	SCP_vector<obj_snd_voice> playing = {{0, 0.5f}};
+	SCP_vector<obj_snd_voice> candidates = {{1, 0.5f}};
+	SCP_vector<obj_snd_voice> stopped, started;
+
+	obj_snd_select_voices(playing, candidates, 1, stopped, started);
+
+	ASSERT_TRUE(stopped.empty());
+	ASSERT_TRUE(started.empty());
+	ASSERT_EQ(SCP_vector<int>({0}), indices(playing));
+}
+
+TEST(ObjectSoundTest, select_voices_keeps_loudest)
+{
+	const size_t max_voices = 8;
+
+	SCP_vector<obj_snd_voice> playing, stopped, started;
+	for (int i = 0; i < 8; ++i) {
+		playing.push_back({i, (i * 37 % 101) / 100.0f});
+	}
+
+	SCP_vector<obj_snd_voice> candidates;
+	for (int i = 8; i < 40; ++i) {
+		candidates.push_back({i, (i * 37 % 101) / 100.0f});
+	}
+
+	// what should be left playing are the loudest of all of them
+	SCP_vector<obj_snd_voice> all = playing;
+	all.insert(all.end(), candidates.begin(), candidates.end());
+	std::sort(all.begin(), all.end(), [](const obj_snd_voice& a, const obj_snd_voice& b) { return a.vol > b.vol; });
+	all.resize(max_voices);
+
+	auto old_playing = playing;
+	obj_snd_select_voices(playing, candidates, max_voices, stopped, started);
+
+	ASSERT_EQ(max_voices, playing.size());
+	ASSERT_EQ(indices(all), indices(playing));
+	ASSERT_EQ(old_playing.size() + started.size() - stopped.size(), playing.size());
+}
+
+// Runs obj_snd_do_frame() against a real OpenAL mixer, which renders into memory instead of a device.
+// Time only moves when the test says so, so the results do not depend on how fast the machine is.
+class ObjectSoundLoopbackTest : public test::FSTestFixture {
+  public:
+	ObjectSoundLoopbackTest() : test::FSTestFixture(INIT_CFILE)
+	{
+		addCommandlineArg("-loopback_sound");
+		pushModDir("object");
+	}
+
+  protected:
+	gamesnd_id _snd;
+
+	static int _time;
+
+	static UI_TIMESTAMP test_clock() { return UI_TIMESTAMP(_time); }
+
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+
+		_time = 10000;
+		obj_snd_set_clock(test_clock);
+
+		if (!snd_init()) {
+			GTEST_SKIP() << "OpenAL has no loopback device";
+		}
+
+		obj_init();
+		Obj_snd_enabled = TRUE;
+		obj_snd_level_init();
+
+		// audible up to 1000 m, so it is updated less often beyond 500 m
+		game_snd gs;
+		gs.name = "objsnd_test";
+		gs.sound_entries.resize(1);
+		strcpy_s(gs.sound_entries[0].filename, "objsnd_test.wav");
+		gs.min = 10;
+		gs.max = 1000;
+		gs.flags = GAME_SND_USE_DS3D;
+		gs.volume_range = util::UniformFloatRange(1.0f);
+		gs.pitch_range = util::UniformFloatRange(1.0f);
+
+		Snds.push_back(gs);
+		_snd = gamesnd_id(static_cast<int>(Snds.size()) - 1);
+
+		View_position = vmd_zero_vector;
+	}
+	void TearDown() override
+	{
+		obj_snd_level_close();
+		obj_snd_set_clock(nullptr);
+		audiostream_close();
+		snd_close();
+		gamesnd_close();
+
+		// the game never starts sound a second time, so snd_close() leaves these alone
+		ds_initialized = FALSE;
+		Sound_enabled = FALSE;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static object* create_object(float distance)
+	{
+		vec3d pos = vmd_zero_vector;
+		pos.xyz.z = distance;
+
+		int objnum = obj_create(OBJ_ASTEROID, -1, -1, &vmd_identity_matrix, &pos, 1.0f, flagset<Object::Object_Flags>());
+		return (objnum >= 0) ? &Objects[objnum] : nullptr;
+	}
+
+	// obj_snd_do_frame() does nothing if it ran less than 20 ms ago
+	static void do_frame(int elapsed_ms = 25)
+	{
+		_time += elapsed_ms;
+		obj_snd_do_frame();
+	}
+
+	static ALuint get_source(const object* objp, int index)
+	{
+		int channel = ds_get_channel(obj_snd_get_instance(objp, index));
+		return (channel >= 0) ? Channels[channel].source_id : 0;
+	}
+
+	static float get_source_distance(ALuint source)
+	{
+		ALfloat x, y, z;
+		alGetSource3f(source, AL_POSITION, &x, &y, &z);
+
+		// OpenAL has z pointing the other way
+		return -z;
+	}
+
+	static float render_rms()
+	{
+		SCP_vector<float> samples(2 * 4096);
+
+		// the mixer fades gain changes in, so skip the start
+		ds_loopback_render(samples.data(), 1024);
+		ds_loopback_render(samples.data(), 4096);
+
+		double sum = 0.0;
+		for (auto sample : samples) {
+			sum += sample * sample;
+		}
+		return static_cast<float>(std::sqrt(sum / samples.size()));
+	}
+};
+
+int ObjectSoundLoopbackTest::_time = 0;
+
+TEST_F(ObjectSoundLoopbackTest, do_frame_processes_deferred_updates)
+{
+	if (alIsExtensionPresent("AL_SOFT_deferred_updates") != AL_TRUE) {
+		GTEST_SKIP() << "OpenAL does not support deferred updates";
+	}
+
+	auto objp = create_object(400.0f);
+	ASSERT_NE(nullptr, objp);
+
+	int index = obj_snd_assign(OBJ_INDEX(objp), _snd, &vmd_zero_vector);
+	ASSERT_GE(index, 0);
+
+	do_frame();
+
+	ALuint source = get_source(objp, index);
+	ASSERT_NE(0u, source);
+	ASSERT_EQ(AL_FALSE, alGetBoolean(AL_DEFERRED_UPDATES_SOFT));
+
+	float far_rms = render_rms();
+	ASSERT_GT(far_rms, 0.0f);
+
+	// near sounds are updated on every pass, inside of the deferred batch
+	objp->pos.xyz.z = 50.0f;
+	do_frame();
+
+	ASSERT_EQ(source, get_source(objp, index));
+	ASSERT_FLOAT_EQ(50.0f, get_source_distance(source));
+
+	// the mixer only hears about the new position if the batch was processed
+	ASSERT_EQ(AL_FALSE, alGetBoolean(AL_DEFERRED_UPDATES_SOFT));
+	ASSERT_GT(render_rms(), far_rms);
+}
+
+TEST_F(ObjectSoundLoopbackTest, do_frame_throttles_far_sounds)
+{
+	auto objp = create_object(700.0f);
+	ASSERT_NE(nullptr, objp);
+
+	int index = obj_snd_assign(OBJ_INDEX(objp), _snd, &vmd_zero_vector);
+	ASSERT_GE(index, 0);
+
+	do_frame();
+
+	ALuint source = get_source(objp, index);
+	ASSERT_NE(0u, source);
+	ASSERT_FLOAT_EQ(700.0f, get_source_distance(source));
+
+	// far sounds wait 100 ms between updates
+	objp->pos.xyz.z = 800.0f;
+	do_frame(25);
+	do_frame(50);
+	ASSERT_FLOAT_EQ(700.0f, get_source_distance(source));
+
+	do_frame(25);
+	ASSERT_EQ(source, get_source(objp, index));
+	ASSERT_FLOAT_EQ(800.0f, get_source_distance(source));
+}
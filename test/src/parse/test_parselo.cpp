@@ -174,3 +174,42 @@ TEST(ParseloUtilTest, drop_whitespace) {
 	ASSERT_EQ(test_str, "");
 }
 
+
+TEST(ParseloUtilTest, line_num_index) {
+	// comments are stripped, but quoted comment characters and multi-line strings are left for get_line_num() to deal with
+	const char text[] = "#Start\n"
+		"; a comment\n"
+		"$Name: \"semi;colon\"\n"
+		"\n"
+		"$Text: \"one /* two\n"
+		"three */ four\"\n"
+		"/* multi\n"
+		"line */ $Value: 3 ; trailing\n"
+		"#End\n";
+
+	default_file file;
+	file.filename = "line_num_index.tbl";
+	file.data = text;
+	file.size = sizeof(text) - 1;
+
+	read_file_text_from_default(file);
+
+	SCP_vector<int> indexed;
+	for (Mp = Parse_text; Mp <= Parse_text + strlen(Parse_text); ++Mp) {
+		indexed.push_back(get_line_num());
+	}
+
+	// without the index every call scans the text again
+	invalidate_line_num_index();
+
+	size_t i = 0;
+	for (Mp = Parse_text; Mp <= Parse_text + strlen(Parse_text); ++Mp, ++i) {
+		ASSERT_EQ(get_line_num(), indexed[i]) << "Offset " << i;
+	}
+
+	ASSERT_EQ(1, indexed.front());
+	ASSERT_TRUE(std::is_sorted(indexed.begin(), indexed.end()));
+	ASSERT_GT(indexed.back(), 5);
+
+	stop_parse();
+}
@@ -0,0 +1,206 @@
+#include "scripting/lua_pool.h"
+#include "scripting/lua/LuaHeaders.h"
+#include "scripting/ScriptingTestFixture.h"
+
+#include <utils/Random.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using Random = util::Random;
+
+namespace {
+
+struct counted_alloc {
+	::scripting::lua_pool_allocator* pool = nullptr;
+	std::uint64_t allocations = 0;
+};
+
+void* counted_lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+	auto state = static_cast<counted_alloc*>(ud);
+	if (nsize > 0) {
+		++state->allocations;
+	}
+
+	if (state->pool != nullptr) {
+		return state->pool->reallocate(ptr, osize, nsize);
+	}
+
+	if (nsize == 0) {
+		vm_free(ptr);
+		return nullptr;
+	}
+	return vm_realloc(ptr, nsize);
+}
+
+// What per frame scripts tend to do: make small userdata like the vectors and handles of the API, put them in tables,
+// build strings and closures, and then drop all of it.
+const char* const BENCHMARK_SCRIPT = R"(
+local proto = newproxy(true)
+getmetatable(proto).__index = function(self, key) return 1 end
+
+local sum = 0
+for i = 1, 20000 do
+	local handle = newproxy(proto)
+	local pos = { x = i, y = i * 2, z = i * 3 }
+	local name = "Ship " .. (i % 64)
+	local scale = function(f) return pos.x * f end
+	sum = sum + handle.value + scale(2) + #name
+end
+benchmark_result = sum
+)";
+
+} // namespace
+
+// Blocks have to keep their contents when they are resized within, into and out of the pool
+TEST(LuaPoolTest, reallocate_keeps_contents)
+{
+	::scripting::lua_pool_allocator pool;
+
+	struct block {
+		ubyte* ptr;
+		size_t size;
+		ubyte fill;
+	};
+	SCP_vector<block> blocks;
+
+	Random::seed(3);
+
+	auto check = [](const block& b) {
+		for (size_t i = 0; i < b.size; ++i) {
+			if (b.ptr[i] != b.fill) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	for (int step = 0; step < 20000; ++step) {
+		auto action = Random::next(3);
+		// mostly small, sometimes larger than a pooled block
+		size_t size = (Random::next(10) == 0) ? 200 + Random::next(400) : 1 + Random::next(128);
+
+		if (action == 0 || blocks.empty()) {
+			block b;
+			b.size = size;
+			b.fill = static_cast<ubyte>(step);
+			b.ptr = static_cast<ubyte*>(pool.reallocate(nullptr, 0, size));
+			memset(b.ptr, b.fill, size);
+			blocks.push_back(b);
+		} else {
+			auto idx = static_cast<size_t>(Random::next(static_cast<int>(blocks.size())));
+			auto& b = blocks[idx];
+			ASSERT_TRUE(check(b)) << "Step " << step;
+
+			if (action == 1) {
+				b.ptr = static_cast<ubyte*>(pool.reallocate(b.ptr, b.size, size));
+				// the part that was kept has to be unchanged
+				b.size = MIN(b.size, size);
+				ASSERT_TRUE(check(b)) << "Step " << step;
+
+				b.size = size;
+				memset(b.ptr, b.fill, size);
+			} else {
+				ASSERT_EQ(nullptr, pool.reallocate(b.ptr, b.size, 0));
+				blocks.erase(blocks.begin() + idx);
+			}
+		}
+	}
+
+	for (auto& b : blocks) {
+		ASSERT_TRUE(check(b));
+		pool.reallocate(b.ptr, b.size, 0);
+	}
+
+	ASSERT_GT(pool.num_chunks(), 0u);
+	pool.clear();
+	ASSERT_EQ(0u, pool.pooled_bytes());
+}
+
+// Runs the same script on a state using the pool and one using the heap.  Only prints the timings, the result depends
+// too much on the machine to assert anything.
+TEST(LuaPoolTest, allocationBenchmark)
+{
+	const int iterations = 10;
+
+	using clock = std::chrono::high_resolution_clock;
+
+	auto run = [&](::scripting::lua_pool_allocator* pool, std::uint64_t& allocations, double& result) {
+		counted_alloc alloc;
+		alloc.pool = pool;
+
+		auto L = lua_newstate(counted_lua_alloc, &alloc);
+		luaL_openlibs(L);
+
+		auto start = clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			EXPECT_EQ(0, luaL_dostring(L, BENCHMARK_SCRIPT)) << lua_tostring(L, -1);
+		}
+		auto time = clock::now() - start;
+
+		lua_getglobal(L, "benchmark_result");
+		result = lua_tonumber(L, -1);
+		lua_pop(L, 1);
+
+		lua_close(L);
+
+		allocations = alloc.allocations;
+		return std::chrono::duration<double, std::milli>(time).count() / iterations;
+	};
+
+	::scripting::lua_pool_allocator pool;
+
+	std::uint64_t heap_allocations, pool_allocations;
+	double heap_result, pool_result;
+
+	auto heap_ms = run(nullptr, heap_allocations, heap_result);
+	auto pool_ms = run(&pool, pool_allocations, pool_result);
+
+	ASSERT_EQ(heap_result, pool_result);
+	ASSERT_GT(pool_result, 0.0);
+
+	std::cout << "Lua allocation benchmark: " << pool_allocations / iterations << " allocations per run, heap "
+	          << heap_ms << " ms, pool " << pool_ms << " ms, pool size " << pool.pooled_bytes() / 1024 << " KB"
+	          << std::endl;
+}
+
+class ScriptingLuaPoolTest : public test::scripting::ScriptingTestFixture {
+  public:
+	ScriptingLuaPoolTest() : test::scripting::ScriptingTestFixture(INIT_CFILE) {}
+};
+
+// The allocation rate of scripts doing vector math with the API, as the engine's state sees it
+TEST_F(ScriptingLuaPoolTest, apiAllocationRate)
+{
+	const int iterations = 10000;
+
+	const auto& stats = _state->GetAllocStats();
+	auto start_allocations = stats.allocations + stats.reallocations;
+
+	using clock = std::chrono::high_resolution_clock;
+	auto start = clock::now();
+
+	ASSERT_TRUE(_state->EvalString(R"(
+		local sum = 0
+		for i = 1, 10000 do
+			local pos = ba.createVector(i, i * 2, i * 3)
+			local dir = ba.createVector(0, 0, 1)
+			local target = pos + dir * 100
+			local orient = ba.createOrientation(0, i * 0.001, 0)
+			sum = sum + target:getDistance(pos) + orient.h
+		end
+		pool_result = sum
+	)"));
+
+	auto time = clock::now() - start;
+	auto allocations = stats.allocations + stats.reallocations - start_allocations;
+
+	ASSERT_GT(allocations, static_cast<std::uint64_t>(iterations));
+	ASSERT_GT(stats.pooled_bytes, 0u);
+
+	std::cout << "API script: " << static_cast<double>(allocations) / iterations << " allocations per iteration, "
+	          << allocations / std::chrono::duration<double>(time).count() / 1e6 << " million allocations per second, "
+	          << stats.peak_bytes / 1024 << " KB peak" << std::endl;
+}
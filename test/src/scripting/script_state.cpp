@@ -2,6 +2,8 @@
 #include "scripting/scripting.h"
 #include "scripting/scripting_doc.h"
 
+#include "scripting/ScriptingTestFixture.h"
+
 #include <gtest/gtest.h>
 
 TEST(ScriptingState, TestValidDocumentation)
@@ -12,3 +14,202 @@ TEST(ScriptingState, TestValidDocumentation)
 		FAIL() << "Failed to parse scripting documentation:\n" << error;
 	});
 }
+
+namespace {
+
+struct TestConditions {
+	int key;
+};
+
+class TestParseableCondition : public ::scripting::ParseableCondition {
+  public:
+	int getContextKeys(const ::scripting::HookConditionContext& conditionContext, int* keys) const override
+	{
+		keys[0] = conditionContext.get<TestConditions>()->key;
+		return 1;
+	}
+};
+
+class TestKeyCondition : public ::scripting::EvaluatableCondition {
+	const TestParseableCondition& _parseable;
+	int _key;
+
+  public:
+	TestKeyCondition(const TestParseableCondition& parseable, int key) : _parseable(parseable), _key(key) {}
+
+	bool evaluate(const ::scripting::HookConditionContext& conditionContext) const override
+	{
+		return conditionContext.get<TestConditions>()->key == _key;
+	}
+
+	const ::scripting::ParseableCondition* getDispatchKey(int& key) const override
+	{
+		key = _key;
+		return &_parseable;
+	}
+};
+
+class ScriptStateDispatchTest : public test::scripting::ScriptingTestFixture {
+  public:
+	ScriptStateDispatchTest() : test::scripting::ScriptingTestFixture(INIT_CFILE) {}
+
+  protected:
+	static const int TEST_HOOK_ID = 100000;
+
+	TestParseableCondition _parseable;
+
+	// adds an action that records its number when it runs, restricted to the key unless that is negative
+	void addAction(int number, int key)
+	{
+		script_action action;
+		action.hook.hook_function.language = SC_LUA;
+		action.hook.hook_function.function =
+			luacpp::LuaFunction::createFromCode(_state->GetLuaSession(), "ran[#ran + 1] = " + std::to_string(number));
+		if (key >= 0) {
+			action.local_conditions.emplace_back(new TestKeyCondition(_parseable, key));
+		}
+
+		_state->AddConditionedHook(TEST_HOOK_ID, std::move(action));
+	}
+
+	SCP_string runWithKey(int key)
+	{
+		_state->EvalString("ran = {}");
+
+		TestConditions conditions{key};
+		_state->RunCondition(TEST_HOOK_ID, ::scripting::HookConditionContext(conditions));
+
+		// keep the string in a global so that it stays alive until it is copied
+		const char* ran = nullptr;
+		_state->EvalStringWithReturn("[ran_list = table.concat(ran, ',') return ran_list]", "|s", &ran);
+		return ran != nullptr ? ran : "<failed>";
+	}
+};
+
+} // namespace
+
+// Looking the actions up by key has to run the same ones in the same order as checking all of them
+TEST_F(ScriptStateDispatchTest, keyed_actions_run_in_order)
+{
+	addAction(1, 5);
+	addAction(2, -1);
+	addAction(3, 7);
+	addAction(4, 5);
+	addAction(5, -1);
+	_state->ProcessAddedHooks();
+
+	ASSERT_EQ("1,2,4,5", runWithKey(5));
+	ASSERT_EQ("2,3,5", runWithKey(7));
+	ASSERT_EQ("2,5", runWithKey(9));
+
+	TestConditions conditions{9};
+	ASSERT_TRUE(_state->AnyConditionValid(TEST_HOOK_ID, ::scripting::HookConditionContext(conditions)));
+}
+
+TEST_F(ScriptStateDispatchTest, no_match_without_unkeyed_actions)
+{
+	addAction(1, 5);
+	addAction(2, 7);
+	_state->ProcessAddedHooks();
+
+	TestConditions conditions{9};
+	ASSERT_FALSE(_state->AnyConditionValid(TEST_HOOK_ID, ::scripting::HookConditionContext(conditions)));
+	ASSERT_EQ("", runWithKey(9));
+	ASSERT_EQ("2", runWithKey(7));
+}
+
+// Popped and nil hook variables must not leave holes in the registry that luaL_ref() would hand out again
+TEST_F(ScriptStateDispatchTest, hook_variable_references_stay_valid)
+{
+	auto L = _state->GetLuaSession();
+	const int id = script_state::GetHookVarId("HookVariableReferenceTest");
+
+	auto top = [&]() {
+		lua_Number value = -1;
+		if (_state->PushHookVar(L, id)) {
+			value = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
+			lua_pop(L, 1);
+		}
+		return value;
+	};
+
+	// the first value being nil must still get a real reference
+	_state->SetHookVar(id, 'a', luacpp::LuaValue::createNil(L));
+	_state->SetHookVar(id, 'f', 1.0f);
+	_state->SetHookVar(id, 'f', 2.0f);
+	ASSERT_EQ(2, top());
+
+	_state->RemHookVar(id);
+	_state->RemHookVar(id);
+	ASSERT_EQ(0, top());
+
+	// references taken now must not share the slots kept for the popped values
+	SCP_vector<luacpp::LuaReference> others;
+	for (int i = 0; i < 8; ++i) {
+		lua_pushnumber(L, 100 + i);
+		others.push_back(luacpp::UniqueLuaReference::create(L));
+		lua_pop(L, 1);
+	}
+
+	_state->SetHookVar(id, 'f', 3.0f);
+	_state->SetHookVar(id, 'f', 4.0f);
+	ASSERT_EQ(4, top());
+
+	for (int i = 0; i < 8; ++i) {
+		others[i]->pushValue(L);
+		ASSERT_EQ(100 + i, lua_tonumber(L, -1));
+		lua_pop(L, 1);
+	}
+
+	_state->RemHookVar(id);
+	ASSERT_EQ(3, top());
+	_state->RemHookVar(id);
+	ASSERT_EQ(0, top());
+	_state->RemHookVar(id);
+	ASSERT_FALSE(_state->IsHookVarSet(id));
+}
+
+TEST(ScriptingState, hook_variable_ids)
+{
+	const int id = script_state::GetHookVarId("HookVariableIdTest");
+
+	ASSERT_EQ(id, script_state::GetHookVarId("HookVariableIdTest"));
+	ASSERT_EQ(id, script_state::FindHookVarId("HookVariableIdTest"));
+	ASSERT_EQ("HookVariableIdTest", script_state::GetHookVarName(id));
+	ASSERT_EQ(-1, script_state::FindHookVarId("HookVariableIdTestUnused"));
+}
+
+TEST(ScriptingState, lua_alloc_stats)
+{
+	::scripting::lua_alloc_stats stats;
+	int a, b;
+
+	stats.record(nullptr, 0, 100, &a);
+	stats.record(&a, 100, 250, &b);
+	stats.record(&b, 250, 50, &b);
+	// a failed reallocation keeps the old block
+	stats.record(&b, 50, 1000, nullptr);
+
+	ASSERT_EQ(50u, stats.bytes_in_use);
+	ASSERT_EQ(250u, stats.peak_bytes);
+	ASSERT_EQ(250u, stats.bytes_allocated);
+
+	stats.record(&b, 50, 0, nullptr);
+	// freeing nothing is not counted
+	stats.record(nullptr, 0, 0, nullptr);
+
+	ASSERT_EQ(0u, stats.bytes_in_use);
+	ASSERT_EQ(1u, stats.allocations);
+	ASSERT_EQ(2u, stats.reallocations);
+	ASSERT_EQ(1u, stats.frees);
+}
+
+TEST_F(ScriptStateDispatchTest, alloc_stats_follow_the_state)
+{
+	const auto& stats = _state->GetAllocStats();
+	ASSERT_GT(stats.bytes_in_use, 0u);
+
+	auto allocations = stats.allocations;
+	_state->EvalString("alloc_test = {} for i = 1, 100 do alloc_test[i] = { i } end");
+	ASSERT_GT(stats.allocations, allocations + 100);
+}
@@ -0,0 +1,311 @@
+#include <globalincs/linklist.h>
+#include <gtest/gtest.h>
+#include <model/model.h>
+#include <object/object.h>
+#include <ship/ship.h>
+#include <ship/shiphit.h>
+#include <ship/subsysbounds.h>
+#include <utils/Random.h>
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+using Random = util::Random;
+
+// registered by hand below, since there is no model file to load
+extern polymodel *Polygon_models[MAX_POLYGON_MODELS];
+extern SCP_vector<polymodel_instance*> Polygon_model_instances;
+
+namespace {
+
+void random_object(object* objp)
+{
+	angles a;
+	a.p = frand_range(-PI, PI);
+	a.b = frand_range(-PI, PI);
+	a.h = frand_range(-PI, PI);
+
+	vm_angles_2_matrix(&objp->orient, &a);
+	objp->pos = random_vec(50000.0f);
+}
+
+// what get_subsystem_pos() computes for a subsystem at the given model space position
+void reference_world_pos(vec3d* out, const vec3d* local_pos, const object* objp)
+{
+	vm_vec_unrotate(out, local_pos, &objp->orient);
+	vm_vec_add2(out, &objp->pos);
+}
+
+} // namespace
+
+class SubsysBoundsTest : public test::FSTestFixture {
+  public:
+	SubsysBoundsTest() : test::FSTestFixture(INIT_NONE) {}
+
+  protected:
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+		Random::seed(1);
+	}
+	void TearDown() override { test::FSTestFixture::TearDown(); }
+};
+
+TEST_F(SubsysBoundsTest, world_pos_matches_reference)
+{
+	object obj;
+
+	for (int i = 0; i < 1000; ++i) {
+		random_object(&obj);
+
+		subsys_bounds_entry entry;
+		entry.subsys = nullptr;
+		entry.local_pos = random_vec(2000.0f);
+		entry.submodel_num = -1;
+		entry.is_static = true;
+
+		vec3d expected, actual;
+		reference_world_pos(&expected, &entry.local_pos, &obj);
+		subsys_bounds_get_world_pos(&actual, entry, &obj);
+
+		// damage must not change at all, so the positions have to be identical and not just close
+		ASSERT_EQ(0, memcmp(&expected, &actual, sizeof(vec3d)));
+	}
+}
+
+TEST_F(SubsysBoundsTest, never_culls_subsystems_in_range)
+{
+	object obj;
+	int in_range = 0;
+	int culled = 0;
+
+	for (int i = 0; i < 200; ++i) {
+		random_object(&obj);
+
+		for (int j = 0; j < 200; ++j) {
+			subsys_bounds_entry entry;
+			entry.subsys = nullptr;
+			entry.local_pos = random_vec(1000.0f);
+			entry.submodel_num = -1;
+			entry.is_static = true;
+
+			vec3d subsys_world;
+			reference_world_pos(&subsys_world, &entry.local_pos, &obj);
+
+			// hits near the subsystem, some of them right at the edge of the range
+			float range = frand_range(1.0f, 300.0f);
+			vec3d dir = random_vec(1.0f);
+			vm_vec_normalize_safe(&dir);
+
+			vec3d hitpos;
+			vm_vec_scale_add(&hitpos, &subsys_world, &dir, range * frand_range(0.9f, 1.1f));
+
+			subsys_bounds_hit hit;
+			subsys_bounds_make_hit(&hit, &hitpos, &obj);
+
+			bool may_be_in_range = subsys_bounds_may_be_in_range(entry, hit, range);
+
+			if (vm_vec_dist_quick(&hitpos, &subsys_world) < range) {
+				ASSERT_TRUE(may_be_in_range);
+				++in_range;
+			} else if (!may_be_in_range) {
+				++culled;
+			}
+		}
+	}
+
+	// make sure both cases were actually tested
+	ASSERT_GT(in_range, 0);
+	ASSERT_GT(culled, 0);
+}
+
+TEST_F(SubsysBoundsTest, culls_distant_subsystems)
+{
+	object obj;
+	random_object(&obj);
+
+	subsys_bounds_entry entry;
+	entry.subsys = nullptr;
+	entry.local_pos = vmd_zero_vector;
+	entry.local_pos.xyz.x = 500.0f;
+	entry.submodel_num = -1;
+	entry.is_static = true;
+
+	vec3d subsys_world;
+	reference_world_pos(&subsys_world, &entry.local_pos, &obj);
+
+	vec3d hitpos = subsys_world;
+	hitpos.xyz.y += 100.0f;
+
+	subsys_bounds_hit hit;
+	subsys_bounds_make_hit(&hit, &hitpos, &obj);
+
+	ASSERT_TRUE(subsys_bounds_may_be_in_range(entry, hit, 101.0f));
+	ASSERT_FALSE(subsys_bounds_may_be_in_range(entry, hit, 50.0f));
+}
+
+TEST_F(SubsysBoundsTest, scripted_submodel_movement)
+{
+	// root, a turret base and its barrel
+	polymodel pm;
+	pm.id = 0;
+	pm.n_models = 3;
+	pm.submodel.reset(new bsp_info[3]);
+	pm.submodel[1].parent = 0;
+	pm.submodel[1].offset = random_vec(100.0f);
+	pm.submodel[2].parent = 1;
+	pm.submodel[2].offset = random_vec(10.0f);
+
+	submodel_instance submodel_instances[3];
+	polymodel_instance pmi;
+	pmi.model_num = 0;
+	pmi.submodel = submodel_instances;
+
+	vec3d expected, actual;
+	model_instance_local_to_global_point(&expected, &vmd_zero_vector, &pm, &pmi, 2, nullptr, nullptr);
+	subsys_bounds_get_submodel_pos(&actual, &pm, 2);
+	ASSERT_EQ(0, memcmp(&expected, &actual, sizeof(vec3d)));
+	ASSERT_TRUE(subsys_bounds_submodel_is_untransformed(&pm, &pmi, 2));
+
+	// the barrel turning does not move its origin
+	angles a = { 0.3f, 0.2f, 0.1f };
+	vm_angles_2_matrix(&submodel_instances[2].canonical_orient, &a);
+	ASSERT_TRUE(subsys_bounds_submodel_is_untransformed(&pm, &pmi, 2));
+
+	// but translating it through subsystem.Translation does
+	submodel_instances[2].canonical_offset.xyz.z = 5.0f;
+	ASSERT_FALSE(subsys_bounds_submodel_is_untransformed(&pm, &pmi, 2));
+	submodel_instances[2].canonical_offset = vmd_zero_vector;
+
+	// and so do any parent movements
+	submodel_instances[1].canonical_offset.xyz.x = -1.0f;
+	ASSERT_FALSE(subsys_bounds_submodel_is_untransformed(&pm, &pmi, 2));
+	submodel_instances[1].canonical_offset = vmd_zero_vector;
+
+	vm_angles_2_matrix(&submodel_instances[1].canonical_orient, &a);
+	ASSERT_FALSE(subsys_bounds_submodel_is_untransformed(&pm, &pmi, 2));
+}
+
+TEST_F(SubsysBoundsTest, damage_matches_without_culling)
+{
+	// root, two fixed submodels, a rotating turret and a submodel a script has moved through subsystem.Translation
+	const int n_submodels = 5;
+
+	polymodel pm;
+	pm.id = 0;
+	pm.n_models = n_submodels;
+	pm.submodel.reset(new bsp_info[n_submodels]);
+	for (int i = 1; i < n_submodels; ++i) {
+		pm.submodel[i].parent = 0;
+		pm.submodel[i].offset = random_vec(80.0f);
+	}
+
+	submodel_instance submodel_instances[n_submodels];
+	polymodel_instance pmi;
+	pmi.model_num = 0;
+	pmi.submodel = submodel_instances;
+
+	angles a = { 0.3f, 0.2f, 0.1f };
+	vm_angles_2_matrix(&submodel_instances[3].canonical_orient, &a);
+	submodel_instances[4].canonical_offset.xyz.z = 25.0f;
+
+	auto old_model = Polygon_models[0];
+	Polygon_models[0] = &pm;
+	Polygon_model_instances.push_back(&pmi);
+
+	Ship_info.emplace_back();
+	Ship_info.back().flags.set(Ship::Info_Flags::Disable_all_generic_impact_debris);
+
+	// a point subsystem and one on every submodel
+	const int n_subsystems = n_submodels;
+	const int types[n_subsystems] = { SUBSYSTEM_SENSORS, SUBSYSTEM_ENGINE, SUBSYSTEM_WEAPONS, SUBSYSTEM_TURRET, SUBSYSTEM_RADAR };
+
+	model_subsystem model_subsystems[n_subsystems];
+	ship_subsys subsystems[n_subsystems];
+
+	auto shipp = &Ships[0];
+	shipp->ship_info_index = static_cast<int>(Ship_info.size()) - 1;
+	shipp->model_instance_num = static_cast<int>(Polygon_model_instances.size()) - 1;
+	shipp->armor_type_idx = -1;
+	list_init(&shipp->subsys_list);
+
+	for (int i = 0; i < n_subsystems; ++i) {
+		model_subsystems[i].type = types[i];
+		model_subsystems[i].radius = frand_range(10.0f, 40.0f);
+		model_subsystems[i].subobj_num = (i == 0) ? -1 : i;
+		model_subsystems[i].pnt = random_vec(80.0f);
+
+		subsystems[i].system_info = &model_subsystems[i];
+		subsystems[i].armor_type_idx = -1;
+		subsystems[i].subsys_guardian_threshold = 0;
+		list_append(&shipp->subsys_list, &subsystems[i]);
+	}
+
+	object obj;
+	obj.type = OBJ_SHIP;
+	obj.instance = 0;
+	obj.signature = 1;
+	obj.radius = 200.0f;
+
+	subsys_bounds_level_init();
+
+	auto hit = [&](const vec3d* hitpos, float damage, float* hits) {
+		for (int i = 0; i < n_subsystems; ++i) {
+			subsystems[i].current_hits = subsystems[i].max_hits = 1000.0f;
+			shipp->subsys_info[types[i]].aggregate_current_hits = 1000.0f;
+		}
+
+		bool apply_armor;
+		auto result = do_subobj_hit_stuff(&obj, nullptr, hitpos, -1, damage, &apply_armor);
+
+		for (int i = 0; i < n_subsystems; ++i) {
+			hits[i] = subsystems[i].current_hits;
+		}
+		return result.second;
+	};
+
+	int damaged[n_subsystems] = {};
+
+	for (int i = 0; i < 200; ++i) {
+		random_object(&obj);
+
+		vec3d local_hit = random_vec(120.0f);
+		vec3d hitpos;
+		vm_vec_unrotate(&hitpos, &local_hit, &obj.orient);
+		vm_vec_add2(&hitpos, &obj.pos);
+
+		float damage = frand_range(10.0f, 200.0f);
+		float culled_hits[n_subsystems], full_hits[n_subsystems];
+
+		Subsys_bounds_culling = 1;
+		float culled_left = hit(&hitpos, damage, culled_hits);
+
+		Subsys_bounds_culling = 0;
+		float full_left = hit(&hitpos, damage, full_hits);
+
+		// not just close, the damage has to be the same to the last bit
+		ASSERT_EQ(0, memcmp(&culled_left, &full_left, sizeof(float)));
+		ASSERT_EQ(0, memcmp(culled_hits, full_hits, sizeof(culled_hits)));
+
+		for (int j = 0; j < n_subsystems; ++j) {
+			if (full_hits[j] < 1000.0f) {
+				++damaged[j];
+			}
+		}
+	}
+
+	Subsys_bounds_culling = 1;
+
+	// every subsystem has to have been in range of some of the hits, including the scripted one
+	for (int j = 0; j < n_subsystems; ++j) {
+		ASSERT_GT(damaged[j], 0) << "subsystem " << j;
+	}
+
+	list_init(&shipp->subsys_list);
+	shipp->ship_info_index = -1;
+	shipp->model_instance_num = -1;
+	Ship_info.pop_back();
+	Polygon_model_instances.pop_back();
+	Polygon_models[0] = old_model;
+	subsys_bounds_level_init();
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <globalincs/linklist.h>
+#include <ship/ship.h>
+#include <ship/subsyspool.h>
+#include <utils/Random.h>
+
+#include <chrono>
+
+using Random = util::Random;
+
+namespace {
+
+// roughly what ai_process_subobjects() looks at for every subsystem before it decides whether there is work to do
+int process_subsystem(ship_subsys* pss)
+{
+	if (pss->max_hits > 0 && pss->current_hits <= 0.0f) {
+		return 0;
+	}
+
+	switch (pss->system_info->type) {
+	case SUBSYSTEM_TURRET:
+		if (pss->turret_animation_position == MA_POS_READY) {
+			return 2;
+		}
+		return (pss->turret_enemy_objnum >= 0) ? 3 : 1;
+
+	default:
+		return pss->flags[Ship::Subsystem_Flags::Rotates] ? 4 : 0;
+	}
+}
+
+void init_subsystem(ship_subsys* pss, model_subsystem* system_info)
+{
+	pss->system_info = system_info;
+	pss->max_hits = 100.0f;
+	pss->current_hits = (Random::next(10) == 0) ? 0.0f : 100.0f;
+	pss->turret_enemy_objnum = Random::next(2) ? 1 : -1;
+	pss->turret_animation_position = MA_POS_NOT_SET;
+	pss->flags.reset();
+}
+
+} // namespace
+
+TEST(SubsysPoolTests, blocks_are_contiguous_and_disjoint)
+{
+	ship_subsys_pool pool(100);
+
+	auto a = pool.allocate(30);
+	auto b = pool.allocate(50);
+	auto c = pool.allocate(40);
+
+	ASSERT_EQ(a + 30, b);
+	// c does not fit in what is left of the first chunk
+	ASSERT_EQ(2u, pool.num_chunks());
+	ASSERT_EQ(200, pool.num_allocated());
+	ASSERT_EQ(120, pool.num_in_use());
+
+	ASSERT_EQ(nullptr, pool.allocate(0));
+	ASSERT_NE(nullptr, c);
+}
+
+TEST(SubsysPoolTests, released_ranges_are_merged_and_reused)
+{
+	ship_subsys_pool pool(100);
+
+	auto a = pool.allocate(30);
+	auto b = pool.allocate(30);
+	auto c = pool.allocate(30);
+
+	// freeing the outer blocks first and then the middle one has to merge all three back into one range
+	pool.release(a, 30);
+	pool.release(c, 30);
+	pool.release(b, 30);
+	ASSERT_EQ(0, pool.num_in_use());
+
+	auto d = pool.allocate(100);
+	ASSERT_EQ(a, d);
+	ASSERT_EQ(1u, pool.num_chunks());
+
+	// giving back only the tail of a block keeps the head in place
+	pool.release(d + 60, 40);
+	ASSERT_EQ(d + 60, pool.allocate(40));
+}
+
+TEST(SubsysPoolTests, large_blocks_and_reserve)
+{
+	ship_subsys_pool pool(100);
+
+	auto a = pool.allocate(250);
+	ASSERT_NE(nullptr, a);
+	ASSERT_EQ(250, pool.num_allocated());
+
+	ASSERT_TRUE(pool.reserve(50));
+	ASSERT_FALSE(pool.reserve(100));
+
+	// the reserved space is used without making another chunk
+	pool.allocate(100);
+	ASSERT_EQ(2u, pool.num_chunks());
+
+	pool.clear();
+	ASSERT_EQ(0u, pool.num_chunks());
+	ASSERT_EQ(0, pool.num_allocated());
+}
+
+// Compares walking the subsystems of many ships the old way, through lists threaded across a shuffled free list,
+// with walking their pooled blocks by index the way ai_process_subobjects() does now.  Only prints the timings, the
+// result depends too much on the machine to assert anything.
+TEST(SubsysPoolTests, processSubobjectsBenchmark)
+{
+	const int num_ships = 100;
+	const int subsystems_per_ship = 40;
+	const int iterations = 200;
+
+	Random::seed(1);
+
+	SCP_vector<model_subsystem> system_info(subsystems_per_ship);
+	for (int i = 0; i < subsystems_per_ship; ++i) {
+		system_info[i].type = (i % 3 == 0) ? SUBSYSTEM_TURRET : SUBSYSTEM_UNKNOWN;
+	}
+
+	// the old allocator: batches on a free list which ends up in no particular order once ships come and go
+	std::unique_ptr<ship_subsys[]> batches(new ship_subsys[num_ships * subsystems_per_ship]);
+	SCP_vector<ship_subsys*> free_list;
+	for (int i = 0; i < num_ships * subsystems_per_ship; ++i) {
+		free_list.push_back(&batches[i]);
+	}
+	for (size_t i = free_list.size() - 1; i > 0; --i) {
+		std::swap(free_list[i], free_list[Random::next(static_cast<int>(i + 1))]);
+	}
+
+	SCP_vector<ship_subsys> list_heads(num_ships);
+	for (int s = 0; s < num_ships; ++s) {
+		list_init(&list_heads[s]);
+		for (int i = 0; i < subsystems_per_ship; ++i) {
+			auto pss = free_list.back();
+			free_list.pop_back();
+			list_append(&list_heads[s], pss);
+			init_subsystem(pss, &system_info[i]);
+		}
+	}
+
+	ship_subsys_pool pool(200);
+	SCP_vector<ship_subsys*> blocks(num_ships);
+	for (int s = 0; s < num_ships; ++s) {
+		blocks[s] = pool.allocate(subsystems_per_ship);
+		for (int i = 0; i < subsystems_per_ship; ++i) {
+			init_subsystem(&blocks[s][i], &system_info[i]);
+		}
+	}
+
+	using clock = std::chrono::high_resolution_clock;
+
+	clock::duration list_time{};
+	clock::duration block_time{};
+	int list_result = 0;
+	int block_result = 0;
+
+	for (int iter = 0; iter < iterations; ++iter) {
+		auto start = clock::now();
+		for (int s = 0; s < num_ships; ++s) {
+			for (auto pss : list_range(&list_heads[s])) {
+				list_result += process_subsystem(pss);
+			}
+		}
+		list_time += clock::now() - start;
+
+		start = clock::now();
+		for (int s = 0; s < num_ships; ++s) {
+			for (auto pss : ship_subsys_block_range(blocks[s], subsystems_per_ship)) {
+				block_result += process_subsystem(pss);
+			}
+		}
+		block_time += clock::now() - start;
+	}
+
+	ASSERT_GT(list_result, 0);
+	ASSERT_GT(block_result, 0);
+
+	auto to_us = [iterations](clock::duration d) {
+		return std::chrono::duration<double, std::micro>(d).count() / iterations;
+	};
+
+	std::cout << "Processing " << num_ships << " ships with " << subsystems_per_ship << " subsystems: linked list "
+	          << to_us(list_time) << " us, pooled blocks " << to_us(block_time) << " us" << std::endl;
+}
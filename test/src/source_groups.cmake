@@ -40,9 +40,18 @@ add_file_folder("mod"
 )
 
 add_file_folder("model"
+    model/test_model_instancing.cpp
     model/test_modelread.cpp
 )
 
+add_file_folder("Network"
+    network/test_multi_rollback.cpp
+)
+
+add_file_folder("Object"
+    object/test_objectsnd.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
     parse/test_replace.cpp
@@ -55,6 +64,7 @@ add_file_folder("Pilotfile"
 add_file_folder("Scripting"
     scripting/ade_args.cpp
     scripting/doc_parser.cpp
+    scripting/lua_pool.cpp
     scripting/require.cpp
     scripting/script_state.cpp
     scripting/ScriptingTestFixture.h
@@ -81,6 +91,11 @@ add_file_folder("Scripting\\\\Lua"
     scripting/lua/Value.cpp
 )
 
+add_file_folder("Ship"
+    ship/test_subsysbounds.cpp
+    ship/test_subsyspool.cpp
+)
+
 add_file_folder("Test Util"
     util/FSTestFixture.cpp
     util/FSTestFixture.h
@@ -89,8 +104,12 @@ add_file_folder("Test Util"
 
 add_file_folder("Utils"
     utils/HeapAllocatorTest.cpp
+    utils/test_radix_sort.cpp
+    utils/test_threading.cpp
 )
 
 add_file_folder("Weapon"
+    weapon/test_homing.cpp
+    weapon/test_shockwave.cpp
     weapon/weapons.cpp
 )
@@ -6,6 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include "math/floating.h"
+#include "math/vecmat.h"
+
 // This macro skips the following test if we are not in debug mode
 // useful for things like parsing tests where there are no warnings in release mode
 #ifdef NDEBUG
@@ -15,4 +18,14 @@
 #define DEBUG_TEST() do {  } while (false)
 #endif
 
+// Returns a vector with every component picked uniformly from [-extent, extent], seed with util::Random::seed()
+inline vec3d random_vec(float extent)
+{
+	vec3d v;
+	v.xyz.x = frand_range(-extent, extent);
+	v.xyz.y = frand_range(-extent, extent);
+	v.xyz.z = frand_range(-extent, extent);
+	return v;
+}
+
 #endif //FS2_OPEN_TEST_UTIL_H
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include "utils/radix_sort.h"
+
+using namespace util;
+
+namespace {
+// Mirrors the render state model_draw_list used to compare field by field before switching to packed keys
+struct test_draw {
+	int sdr_flags;
+	int vbuffer;
+	int ibuffer;
+	int textures[8];
+	size_t lights;
+};
+
+bool test_draw_less(const test_draw& a, const test_draw& b)
+{
+	if (a.sdr_flags != b.sdr_flags) {
+		return a.sdr_flags < b.sdr_flags;
+	}
+	if (a.vbuffer != b.vbuffer) {
+		return a.vbuffer < b.vbuffer;
+	}
+	if (a.ibuffer != b.ibuffer) {
+		return a.ibuffer < b.ibuffer;
+	}
+	for (int i = 0; i < 8; ++i) {
+		if (a.textures[i] != b.textures[i]) {
+			return a.textures[i] < b.textures[i];
+		}
+	}
+	return a.lights < b.lights;
+}
+
+uint64_t test_draw_key(const test_draw& draw)
+{
+	uint64_t key = static_cast<uint64_t>(draw.sdr_flags) & 0xFFFFF;
+	key = (key << 10) | (static_cast<uint64_t>(draw.vbuffer) & 0x3FF);
+	key = (key << 10) | (static_cast<uint64_t>(draw.ibuffer) & 0x3FF);
+	key = (key << 16) | (static_cast<uint64_t>(draw.textures[0]) & 0xFFFF);
+	key = (key << 8) | (static_cast<uint64_t>(draw.lights) & 0xFF);
+	return key;
+}
+
+SCP_vector<test_draw> make_draws(size_t count)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> flagDist(0, 15);
+	std::uniform_int_distribution<int> bufferDist(0, 200);
+	std::uniform_int_distribution<int> textureDist(0, 4000);
+	std::uniform_int_distribution<int> lightDist(0, 50);
+
+	SCP_vector<test_draw> draws(count);
+	for (auto& draw : draws) {
+		// only a handful of shader variants are in use in a typical scene
+		draw.sdr_flags = (1 << 0) | (1 << 3) | (flagDist(gen) << 4);
+		draw.vbuffer = bufferDist(gen);
+		draw.ibuffer = draw.vbuffer;
+		for (auto& texture : draw.textures) {
+			texture = textureDist(gen);
+		}
+		draw.lights = static_cast<size_t>(lightDist(gen));
+	}
+
+	return draws;
+}
+}
+
+TEST(RadixSortTests, empty) {
+	SCP_vector<radix_sort_item> items;
+	SCP_vector<radix_sort_item> scratch;
+
+	radix_sort(items, scratch);
+
+	ASSERT_TRUE(items.empty());
+}
+
+TEST(RadixSortTests, sortsByKey) {
+	std::mt19937_64 gen(42);
+
+	SCP_vector<radix_sort_item> items;
+	for (int i = 0; i < 5000; ++i) {
+		items.push_back({gen(), i});
+	}
+
+	auto expected = items;
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const radix_sort_item& a, const radix_sort_item& b) { return a.key < b.key; });
+
+	SCP_vector<radix_sort_item> scratch;
+	radix_sort(items, scratch);
+
+	ASSERT_EQ(expected.size(), items.size());
+	for (size_t i = 0; i < items.size(); ++i) {
+		ASSERT_EQ(expected[i].key, items[i].key);
+		ASSERT_EQ(expected[i].value, items[i].value);
+	}
+}
+
+TEST(RadixSortTests, isStable) {
+	SCP_vector<radix_sort_item> items;
+	for (int i = 0; i < 1000; ++i) {
+		// only a few distinct keys, spread over several bytes
+		items.push_back({(static_cast<uint64_t>(i % 3) << 40) | static_cast<uint64_t>(i % 2), i});
+	}
+
+	SCP_vector<radix_sort_item> scratch;
+	radix_sort(items, scratch);
+
+	for (size_t i = 1; i < items.size(); ++i) {
+		ASSERT_LE(items[i - 1].key, items[i].key);
+
+		if (items[i - 1].key == items[i].key) {
+			ASSERT_LT(items[i - 1].value, items[i].value);
+		}
+	}
+}
+
+// Compares the old field by field comparison sort of draw indices with the packed key radix sort now used by
+// model_draw_list.  Only prints the timings, the result depends too much on the machine to assert anything.
+TEST(RadixSortTests, drawListBenchmark) {
+	const size_t num_draws = 20000;
+	const int iterations = 20;
+
+	auto draws = make_draws(num_draws);
+
+	using clock = std::chrono::high_resolution_clock;
+
+	clock::duration comparison_time{};
+	clock::duration radix_time{};
+
+	SCP_vector<int> indices(num_draws);
+	SCP_vector<radix_sort_item> items;
+	SCP_vector<radix_sort_item> scratch;
+
+	for (int iter = 0; iter < iterations; ++iter) {
+		for (size_t i = 0; i < num_draws; ++i) {
+			indices[i] = static_cast<int>(i);
+		}
+
+		auto start = clock::now();
+		std::sort(indices.begin(), indices.end(),
+			[&draws](const int a, const int b) { return test_draw_less(draws[a], draws[b]); });
+		comparison_time += clock::now() - start;
+
+		start = clock::now();
+		items.clear();
+		for (size_t i = 0; i < num_draws; ++i) {
+			items.push_back({test_draw_key(draws[i]), static_cast<int>(i)});
+		}
+		radix_sort(items, scratch);
+		radix_time += clock::now() - start;
+	}
+
+	for (size_t i = 1; i < items.size(); ++i) {
+		ASSERT_LE(items[i - 1].key, items[i].key);
+	}
+
+	auto to_ms = [iterations](clock::duration d) {
+		return std::chrono::duration<double, std::milli>(d).count() / iterations;
+	};
+
+	std::cout << "Sorting " << num_draws << " draws: comparison sort " << to_ms(comparison_time) << " ms, packed key radix sort "
+	          << to_ms(radix_time) << " ms" << std::endl;
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "cmdline/cmdline.h"
+#include "utils/threading.h"
+
+TEST(ThreadingTest, pool_restarts)
+{
+	auto old_multithreading = Cmdline_multithreading;
+	Cmdline_multithreading = 4;
+
+	// the sharded standalone stops the pool before forking and starts it again in every worker
+	for (int run = 0; run < 3; ++run) {
+		threading::init_task_pool();
+		ASSERT_EQ(threading::get_num_workers(), 3u);
+
+		for (int round = 0; round < 20; ++round) {
+			std::atomic_size_t sum {0};
+
+			threading::parallel_for(1000, 1, [&sum](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					sum += i;
+				}
+			});
+
+			ASSERT_EQ(sum.load(), static_cast<size_t>(1000 * 999 / 2));
+		}
+
+		threading::shut_down_task_pool();
+		ASSERT_EQ(threading::get_num_workers(), 0u);
+	}
+
+	// leave the pool without any workers like the other tests expect
+	Cmdline_multithreading = 1;
+	threading::init_task_pool();
+	Cmdline_multithreading = old_multithreading;
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <iff_defs/iff_defs.h>
+#include <object/object.h>
+#include <ship/ship.h>
+#include <utils/Random.h>
+#include <weapon/weapon.h>
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+using Random = util::Random;
+
+namespace {
+
+const int NUM_SHIPS = 40;
+const int NUM_CMEASURES = 8;
+// the seeker cone is 60 degrees wide
+const float HALF_CONE_ANGLE = PI / 6.0f;
+
+// a random direction at the given angle from fvec
+void direction_at_angle(vec3d* out, const vec3d* fvec, float angle)
+{
+	vec3d perp, random;
+	do {
+		random = random_vec(1.0f);
+		vm_vec_cross(&perp, fvec, &random);
+	} while (vm_vec_mag(&perp) < 0.1f);
+	vm_vec_normalize(&perp);
+
+	vm_vec_copy_scale(out, fvec, cosf(angle));
+	vm_vec_scale_add2(out, &perp, sinf(angle));
+}
+
+} // namespace
+
+class HomingTest : public test::FSTestFixture {
+  public:
+	HomingTest() : test::FSTestFixture(INIT_NONE) {}
+
+  protected:
+	SCP_vector<iff_info> _old_iff_info;
+	int _homing_wip = -1;
+	int _cmeasure_wip = -1;
+	int _sip = -1;
+
+	object* _weapon_objp = nullptr;
+	SCP_vector<object*> _targets;
+
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+		Random::seed(1);
+
+		obj_init();
+		weapon_invalidate_homing_candidates();
+
+		// two teams at war with each other
+		_old_iff_info.swap(Iff_info);
+		Iff_info.resize(2);
+		for (int team = 0; team < 2; ++team) {
+			Iff_info[team].attackee_bitmask = iff_get_mask(1 - team);
+			Iff_info[team].attackee_bitmask_all_teams_at_war = iff_get_mask(1 - team);
+		}
+
+		Ship_info.emplace_back();
+		_sip = static_cast<int>(Ship_info.size()) - 1;
+
+		Weapon_info.emplace_back();
+		_homing_wip = static_cast<int>(Weapon_info.size()) - 1;
+		Weapon_info[_homing_wip].fov = cosf(HALF_CONE_ANGLE);
+
+		Weapon_info.emplace_back();
+		_cmeasure_wip = static_cast<int>(Weapon_info.size()) - 1;
+		Weapon_info[_cmeasure_wip].wi_flags.set(Weapon::Info_Flags::Cmeasure);
+
+		// the homing weapon is on team 0
+		Weapons[0].weapon_info_index = _homing_wip;
+		Weapons[0].team = 0;
+		_weapon_objp = create_object(OBJ_WEAPON, 0);
+
+		// mostly enemies, with a few friendlies that must never be picked
+		for (int i = 0; i < NUM_SHIPS; ++i) {
+			Ships[i].ship_info_index = _sip;
+			Ships[i].team = (i % 5 == 0) ? 0 : 1;
+			Ships[i].objnum = OBJ_INDEX(create_object(OBJ_SHIP, i));
+			_targets.push_back(&Objects[Ships[i].objnum]);
+		}
+
+		for (int i = 1; i <= NUM_CMEASURES; ++i) {
+			Weapons[i].weapon_info_index = _cmeasure_wip;
+			Weapons[i].team = 1;
+			Weapons[i].lssm_stage = -1;
+			_targets.push_back(create_object(OBJ_WEAPON, i));
+		}
+
+		obj_merge_created_list();
+	}
+	void TearDown() override
+	{
+		obj_init();
+		weapon_invalidate_homing_candidates();
+		Homing_candidate_culling = 1;
+
+		for (int i = 0; i < NUM_SHIPS; ++i) {
+			Ships[i].ship_info_index = -1;
+			Ships[i].objnum = -1;
+		}
+		for (int i = 0; i <= NUM_CMEASURES; ++i) {
+			Weapons[i].weapon_info_index = -1;
+		}
+
+		Weapon_info.pop_back();
+		Weapon_info.pop_back();
+		Ship_info.pop_back();
+		_old_iff_info.swap(Iff_info);
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static object* create_object(int type, int instance)
+	{
+		int objnum = obj_create(static_cast<ubyte>(type), -1, instance, &vmd_identity_matrix, &vmd_zero_vector, 10.0f, flagset<Object::Object_Flags>());
+		return &Objects[objnum];
+	}
+
+	// Puts the targets right around the edge of the seeker cone, at any distance from a few cells away up to
+	// the same cell as the weapon.  If only_outside is set, none of them can be seen.
+	void place_targets(bool only_outside)
+	{
+		angles a;
+		a.p = frand_range(-PI, PI);
+		a.b = frand_range(-PI, PI);
+		a.h = frand_range(-PI, PI);
+		vm_angles_2_matrix(&_weapon_objp->orient, &a);
+		_weapon_objp->pos = random_vec(20000.0f);
+
+		for (auto objp : _targets) {
+			float angle = HALF_CONE_ANGLE + (only_outside ? frand_range(0.001f, 0.1f) : frand_range(-0.1f, 0.1f));
+
+			vec3d dir;
+			direction_at_angle(&dir, &_weapon_objp->orient.vec.fvec, angle);
+			vm_vec_scale_add(&objp->pos, &_weapon_objp->pos, &dir, frand_range(50.0f, 5000.0f));
+		}
+
+		// the candidates of the last search are out of date
+		weapon_invalidate_homing_candidates();
+	}
+
+	object* find_target(int culling, int seed)
+	{
+		Homing_candidate_culling = culling;
+		weapon_invalidate_homing_candidates();
+
+		// random acquisition has to draw the same number for both searches
+		Random::seed(seed);
+
+		Weapons[0].homing_object = nullptr;
+		find_homing_object(_weapon_objp, 0);
+
+		return Weapons[0].homing_object;
+	}
+
+	// what the closest acquisition is supposed to pick
+	object* closest_target()
+	{
+		object* best = &obj_used_list;
+		float best_dist = 99999.9f;
+
+		for (auto objp : _targets) {
+			if (!iff_x_attacks_y(Weapons[0].team, obj_team(objp))) {
+				continue;
+			}
+
+			vec3d vec_to_object;
+			float dist = vm_vec_normalized_dir(&vec_to_object, &objp->pos, &_weapon_objp->pos);
+			if (objp->type == OBJ_WEAPON) {
+				dist *= 0.5f;
+			}
+
+			if (vm_vec_dot(&vec_to_object, &_weapon_objp->orient.vec.fvec) > Weapon_info[_homing_wip].fov && dist < best_dist) {
+				best_dist = dist;
+				best = objp;
+			}
+		}
+
+		return best;
+	}
+};
+
+TEST_F(HomingTest, culled_candidates_give_the_same_target)
+{
+	for (auto method : { HomingAcquisitionType::CLOSEST, HomingAcquisitionType::RANDOM }) {
+		Weapon_info[_homing_wip].auto_target_method = method;
+
+		int num_locked = 0;
+		int num_missed = 0;
+
+		for (int trial = 0; trial < 500; ++trial) {
+			place_targets(trial % 4 == 0);
+
+			auto full = find_target(0, trial + 1);
+			auto culled = find_target(1, trial + 1);
+
+			ASSERT_EQ(full, culled) << "trial " << trial;
+
+			if (method == HomingAcquisitionType::CLOSEST) {
+				ASSERT_EQ(closest_target(), full) << "trial " << trial;
+			}
+
+			if (full == &obj_used_list) {
+				++num_missed;
+			} else {
+				++num_locked;
+				ASSERT_TRUE(iff_x_attacks_y(Weapons[0].team, obj_team(full)));
+			}
+		}
+
+		// both kinds of outcome have to have come up
+		ASSERT_GT(num_locked, 0);
+		ASSERT_GT(num_missed, 0);
+	}
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <math/fvi.h>
+#include <object/object.h>
+#include <object/objectgrid.h>
+#include <utils/Random.h>
+#include <weapon/weapon.h>
+
+#include "util/test_util.h"
+
+using Random = util::Random;
+
+namespace {
+
+struct test_shockwave {
+	vec3d pos;
+	float inner_radius;
+	float outer_radius;
+	float radius;
+};
+
+test_shockwave random_shockwave(float extent)
+{
+	test_shockwave sw;
+	sw.pos = random_vec(extent);
+	sw.outer_radius = frand_range(50.0f, 1500.0f);
+	sw.inner_radius = frand_range(0.0f, sw.outer_radius * 0.5f);
+	// anywhere from just started to past the outer radius
+	sw.radius = frand_range(0.0f, sw.outer_radius * 1.2f);
+	return sw;
+}
+
+bool blasts(const object* objp, const test_shockwave& sw)
+{
+	float blast, damage;
+	return weapon_area_calc_damage(objp, &sw.pos, sw.inner_radius, sw.outer_radius, 100.0f, 100.0f, &blast, &damage, sw.radius) != -1;
+}
+
+// the distance weapon_area_calc_damage() uses for ships, with the box in place of the model
+float box_distance(const vec3d* pos, const matrix* orient, const vec3d* mins, const vec3d* maxs, const vec3d* center)
+{
+	vec3d temp, local, box_pt;
+	vm_vec_sub(&temp, center, pos);
+	vm_vec_rotate(&local, &temp, orient);
+
+	if (project_point_onto_bbox(mins, maxs, &local, &temp)) {
+		return 0.0001f;
+	}
+
+	vm_vec_unrotate(&box_pt, &temp, orient);
+	vm_vec_add2(&box_pt, pos);
+	return vm_vec_dist(center, &box_pt);
+}
+
+} // namespace
+
+// Every object a shockwave blasts when walking all of them has to be found by the grid query, in the same order.
+TEST(ShockwaveTests, grid_finds_the_same_objects)
+{
+	const int num_objects = 2000;
+	const int num_shockwaves = 500;
+	const float extent = 4000.0f;
+
+	Random::seed(1);
+
+	SCP_vector<object> objects(num_objects);
+	object_grid grid(500.0f);
+
+	for (int i = 0; i < num_objects; ++i) {
+		auto objp = &objects[i];
+		objp->type = OBJ_ASTEROID;
+		objp->pos = random_vec(extent);
+		// mostly small, with a few larger than a cell
+		objp->radius = (i % 50 == 0) ? frand_range(500.0f, 3000.0f) : frand_range(1.0f, 100.0f);
+
+		grid.add(i, &objp->pos, objp->radius);
+	}
+
+	int num_blasted = 0;
+	SCP_vector<int> found;
+
+	for (int s = 0; s < num_shockwaves; ++s) {
+		auto sw = random_shockwave(extent);
+
+		SCP_vector<int> expected;
+		for (int i = 0; i < num_objects; ++i) {
+			if (blasts(&objects[i], sw)) {
+				expected.push_back(i);
+			}
+		}
+
+		found.clear();
+		grid.query_sphere(&sw.pos, MIN(sw.radius, sw.outer_radius), found);
+
+		SCP_vector<int> actual;
+		for (int i : found) {
+			if (blasts(&objects[i], sw)) {
+				actual.push_back(i);
+			}
+		}
+
+		ASSERT_EQ(expected, actual) << "Shockwave " << s;
+		num_blasted += static_cast<int>(expected.size());
+	}
+
+	// make sure the test actually blasted something
+	ASSERT_GT(num_blasted, num_shockwaves);
+}
+
+// Ships are measured against their bounding box, so the grid has to use the farthest corner as their bound.
+TEST(ShockwaveTests, grid_finds_the_same_boxes)
+{
+	const int num_boxes = 1000;
+	const int num_shockwaves = 500;
+	const float extent = 5000.0f;
+
+	Random::seed(2);
+
+	struct test_box {
+		vec3d pos;
+		matrix orient;
+		vec3d mins;
+		vec3d maxs;
+	};
+
+	SCP_vector<test_box> boxes(num_boxes);
+	object_grid grid(500.0f);
+
+	for (int i = 0; i < num_boxes; ++i) {
+		auto& box = boxes[i];
+		angles a;
+		a.p = frand_range(-PI, PI);
+		a.b = frand_range(-PI, PI);
+		a.h = frand_range(-PI, PI);
+		vm_angles_2_matrix(&box.orient, &a);
+		box.pos = random_vec(extent);
+
+		// long and thin, and not centered on the object
+		float size = (i % 20 == 0) ? 2000.0f : 100.0f;
+		box.mins = random_vec(size);
+		box.maxs = box.mins;
+		box.maxs.xyz.z += frand_range(0.0f, size * 4.0f);
+		box.maxs.xyz.x += frand_range(0.0f, size);
+		box.maxs.xyz.y += frand_range(0.0f, size);
+
+		vec3d bound;
+		bound.xyz.x = MAX(fabsf(box.mins.xyz.x), fabsf(box.maxs.xyz.x));
+		bound.xyz.y = MAX(fabsf(box.mins.xyz.y), fabsf(box.maxs.xyz.y));
+		bound.xyz.z = MAX(fabsf(box.mins.xyz.z), fabsf(box.maxs.xyz.z));
+		grid.add(i, &box.pos, vm_vec_mag(&bound));
+	}
+
+	auto box_blasted = [&boxes](int i, const test_shockwave& sw) {
+		float dist = box_distance(&boxes[i].pos, &boxes[i].orient, &boxes[i].mins, &boxes[i].maxs, &sw.pos);
+		return !((dist > sw.outer_radius) || (dist > sw.radius));
+	};
+
+	int num_blasted = 0;
+	SCP_vector<int> found;
+
+	for (int s = 0; s < num_shockwaves; ++s) {
+		auto sw = random_shockwave(extent);
+
+		SCP_vector<int> expected;
+		for (int i = 0; i < num_boxes; ++i) {
+			if (box_blasted(i, sw)) {
+				expected.push_back(i);
+			}
+		}
+
+		found.clear();
+		grid.query_sphere(&sw.pos, MIN(sw.radius, sw.outer_radius), found);
+
+		SCP_vector<int> actual;
+		for (int i : found) {
+			if (box_blasted(i, sw)) {
+				actual.push_back(i);
+			}
+		}
+
+		ASSERT_EQ(expected, actual) << "Shockwave " << s;
+		num_blasted += static_cast<int>(expected.size());
+	}
+
+	ASSERT_GT(num_blasted, num_shockwaves);
+}
+
+TEST(ShockwaveTests, grid_query_skips_far_objects)
+{
+	object_grid grid(100.0f);
+
+	vec3d pos = vmd_zero_vector;
+	for (int i = 0; i < 100; ++i) {
+		pos.xyz.x = i * 100.0f;
+		grid.add(i, &pos, 10.0f);
+	}
+
+	SCP_vector<int> found;
+	vec3d center = vmd_zero_vector;
+	center.xyz.x = 5000.0f;
+	grid.query_sphere(&center, 150.0f, found);
+
+	ASSERT_EQ((SCP_vector<int>{ 49, 50, 51 }), found);
+	ASSERT_EQ(100u, grid.size());
+}